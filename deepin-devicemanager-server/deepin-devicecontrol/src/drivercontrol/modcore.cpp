@@ -14,6 +14,8 @@
 #include <QProcess>
 #include <QLoggingCategory>
 
+#include <sys/stat.h>
+
 using namespace DDLog;
 
 const QString  BLACKLISTT_PROBE_DIR_ETC = "/etc/modprobe.d";   //黑名单配置路径
@@ -21,6 +23,83 @@ const QString  BLACKLISTT_PROBE_DIR_USR_LIB = "/usr/lib/modprobe.d";  //黑名
 const QString  LOADONBOOT_PROBE_DIR = "/etc/modules-load.d";  //开机加载配置路径
 const QString  BLACKLIST_FILENAME_TEMPLETE = "blacklist-%1-drivermanager.conf"; //驱动黑名单文件命名模板
 const QString  LOADONBOOT_FILENAME_TEMPLETE = "%1-drivermanager.conf";  //驱动设置开机启动配置文件
+const QStringList MODULE_INDEX_FILES = {"modules.dep.bin", "modules.alias.bin", "modules.symbols.bin",
+                                         "modules.builtin.bin", "modules.builtin.alias.bin", "modules.softdep"
+                                        };  //kmod上下文使用的索引文件
+const QStringList MODPROBE_CONF_DIRS = {"/etc/modprobe.d", "/run/modprobe.d", "/usr/lib/modprobe.d", "/lib/modprobe.d"};  //modprobe配置路径
+
+QMutex ModCore::s_ctxMutex;
+struct kmod_ctx *ModCore::s_ctx = nullptr;
+QList<qint64> ModCore::s_ctxMtimes;
+
+/**
+ * @brief fileMtime 获取文件修改时间
+ * @param filepath 文件路径
+ * @return 修改时间(纳秒)，文件不存在时返回-1
+ */
+static qint64 fileMtime(const QString &filepath)
+{
+    struct stat st;
+    if (0 != stat(filepath.toLocal8Bit().constData(), &st))
+        return -1;
+    return static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+/**
+ * @brief ModCore::ctxFilesMtime 获取kmod上下文依赖的索引文件与配置路径的修改时间
+ * @param ctx kmod 上下文对象
+ * @return 修改时间列表
+ */
+QList<qint64> ModCore::ctxFilesMtime(struct kmod_ctx *ctx)
+{
+    QList<qint64> mtimes;
+    QString dirname(kmod_get_dirname(ctx));
+    foreach (const QString &file, MODULE_INDEX_FILES)
+        mtimes.append(fileMtime(QString("%1/%2").arg(dirname).arg(file)));
+    foreach (const QString &dir, MODPROBE_CONF_DIRS)
+        mtimes.append(fileMtime(dir));
+    return mtimes;
+}
+
+/**
+ * @brief The ModCore::ContextLocker class 加锁使用进程内共享的kmod上下文
+ * 上下文创建时预先加载索引，索引文件或modprobe配置变化后重新创建
+ */
+class ModCore::ContextLocker
+{
+public:
+    ContextLocker()
+    {
+        s_ctxMutex.lock();
+        if (s_ctx && ctxFilesMtime(s_ctx) != s_ctxMtimes) {
+            qCInfo(appLog) << "Module index or modprobe config changed, reload kmod context";
+            kmod_unref(s_ctx);
+            s_ctx = nullptr;
+        }
+
+        if (!s_ctx) {
+            s_ctx = kmod_new(nullptr, nullptr);
+            if (!s_ctx) {
+                qCInfo(appLog) << "kmod_new() failed!";
+            } else {
+                s_ctxMtimes = ctxFilesMtime(s_ctx);
+                int err = kmod_load_resources(s_ctx);
+                if (err < 0)
+                    qCInfo(appLog) << "kmod_load_resources() failed errcode=" << err;
+            }
+        }
+    }
+
+    ~ContextLocker()
+    {
+        s_ctxMutex.unlock();
+    }
+
+    struct kmod_ctx *ctx() const
+    {
+        return s_ctx;
+    }
+};
 
 ModCore::ModCore(QObject *parent)
     : QObject(parent)
@@ -28,6 +107,21 @@ ModCore::ModCore(QObject *parent)
     qCDebug(appLog) << "ModCore initialized";
 }
 
+/**
+ * @brief ModCore::resetContext 丢弃共享的kmod上下文，下次使用时重新创建并加载索引
+ * 更新模块依赖或修改黑名单后调用，原地修改的配置文件无法通过目录修改时间发现
+ */
+void ModCore::resetContext()
+{
+    qCDebug(appLog) << "Reset kmod context";
+    s_ctxMutex.lock();
+    if (s_ctx) {
+        kmod_unref(s_ctx);
+        s_ctx = nullptr;
+    }
+    s_ctxMutex.unlock();
+}
+
 /**
  * @brief ModCore::checkModuleInUsed 获取依赖当前模块在使用的模块
  * @param modName 模块名 sample: hid or hid.ko /xx/xx/hid.ko
@@ -36,12 +130,10 @@ ModCore::ModCore(QObject *parent)
 QStringList ModCore::checkModuleInUsed(const QString &modName)
 {
     QStringList modList;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (!ctx) {
-        qCInfo(appLog) << "kmod_new() failed!";
+        qCInfo(appLog) << "kmod context unavailable!";
     } else {
         int err = 0;
         struct kmod_module *mod = nullptr;
@@ -74,7 +166,6 @@ QStringList ModCore::checkModuleInUsed(const QString &modName)
             }
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
 
     return  modList;
@@ -89,13 +180,11 @@ bool ModCore::rmModForce(const QString &modName, QString &errMsg)
 {
     qCDebug(appLog) << "Force removing module:" << modName;
     bool bsuccess = true;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (!ctx) {
         bsuccess = false;
-        qCInfo(appLog) << __func__ << "kmod_new() failed!";
+        qCInfo(appLog) << __func__ << "kmod context unavailable!";
     } else {
         int err = 0;
         struct kmod_module *mod = nullptr;
@@ -114,7 +203,6 @@ bool ModCore::rmModForce(const QString &modName, QString &errMsg)
             }
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  bsuccess;
 }
@@ -129,13 +217,11 @@ bool ModCore::modInstall(const QString &modName, QString &errMsg, unsigned int f
 {
     qCDebug(appLog) << "Installing module:" << modName << "with flags:" << flags;
     bool success = true;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (!ctx) {
         success = false;
-        qCInfo(appLog) << __func__ << "kmod_new() failed!";
+        qCInfo(appLog) << __func__ << "kmod context unavailable!";
     } else {
         int err = 0;
         struct kmod_list *modlist = nullptr;
@@ -159,7 +245,6 @@ bool ModCore::modInstall(const QString &modName, QString &errMsg, unsigned int f
             success = false;
         }
 
-        kmod_unref(ctx);
     }
     return  success;
 }
@@ -172,12 +257,10 @@ bool ModCore::modInstall(const QString &modName, QString &errMsg, unsigned int f
 QString ModCore::modGetPath(const QString &modName)
 {
     QString path;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (!ctx) {
-        qCInfo(appLog) << __func__ << "kmod_new() failed!";
+        qCInfo(appLog) << __func__ << "kmod context unavailable!";
     } else {
         int err = 0;
         struct kmod_module *mod = nullptr;
@@ -189,7 +272,6 @@ QString ModCore::modGetPath(const QString &modName)
             path.append(kmod_module_get_path(mod));
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  path;
 }
@@ -202,12 +284,10 @@ QString ModCore::modGetPath(const QString &modName)
 QString ModCore::modGetName(const QString &modPath)
 {
     QString modname;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (!ctx) {
-        qCInfo(appLog) << __func__ << "kmod_new() failed!";
+        qCInfo(appLog) << __func__ << "kmod context unavailable!";
     } else {
         int err = 0;
         struct kmod_module *mod = nullptr;
@@ -219,7 +299,6 @@ QString ModCore::modGetName(const QString &modPath)
             modname.append(kmod_module_get_name(mod));
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  modname;
 }
@@ -233,12 +312,10 @@ QString ModCore::modGetName(const QString &modPath)
 QString ModCore::modGetInfo(const QString &modName, ModCore::ModInfoType infotype)
 {
     QString modinfo;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (!ctx) {
-        qCInfo(appLog) << __func__ << "kmod_new() failed!";
+        qCInfo(appLog) << __func__ << "kmod context unavailable!";
         return QString();
     } else {
         int err = 0;
@@ -254,6 +331,7 @@ QString ModCore::modGetInfo(const QString &modName, ModCore::ModInfoType infotyp
             if (err < 0) {
                 qCInfo(appLog) << __func__ << QString("could not get mod info from %1, errno=%2")
                         .arg(kmod_module_get_name(mod)).arg(err);
+                kmod_module_unref(mod);
                 return QString();
             }
             kmod_list *ltmp = nullptr;
@@ -271,7 +349,6 @@ QString ModCore::modGetInfo(const QString &modName, ModCore::ModInfoType infotyp
             kmod_module_info_free_list(modlist);
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  modinfo;
 }
@@ -387,10 +464,8 @@ QString ModCore::infoType2String(ModCore::ModInfoType infotype)
 int ModCore::modGetInitState(const QString &modName)
 {
     int state = -1;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (ctx) {
         struct kmod_module *mod = nullptr;
         int err = modNew(ctx, modName, mod);
@@ -399,7 +474,6 @@ int ModCore::modGetInitState(const QString &modName)
             state = kmod_module_get_initstate(mod);
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
 
     return  state;
@@ -427,6 +501,7 @@ void ModCore::rmModFromBlackListFile(const QString &filepath, const QString &mod
     if (!(strcontent.contains("blacklist") && strcontent.contains(modName)))
         return;
     deleteLineOfFileWithItem(strpath, modName);
+    resetContext();
 }
 
 /**
@@ -525,9 +600,8 @@ void ModCore::rmModLoadedOnBoot(const QString &modName)
 QStringList ModCore::modGetConfsWithType(ModConfType conftype)
 {
     QStringList conflist;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
 
     if (nullptr != ctx) {
         QString confkey;
@@ -555,7 +629,6 @@ QStringList ModCore::modGetConfsWithType(ModConfType conftype)
             }
             kmod_config_iter_free_iter(iter);
         }
-        kmod_unref(ctx);
     }
     return conflist;
 }
@@ -570,9 +643,8 @@ bool ModCore::isModFile(const QString &filePath)
     if (!bFromPath(filePath))
         return  false;
     bool bmodfile = false;
-    struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-    ctx = kmod_new(nullptr, null_config);
+    ContextLocker locker;
+    struct kmod_ctx *ctx = locker.ctx();
     if (ctx) {
         struct kmod_module *mod = nullptr;
         int err = modNew(ctx, filePath, mod);
@@ -585,7 +657,6 @@ bool ModCore::isModFile(const QString &filePath)
             }
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     qCInfo(appLog) << "" << bmodfile;
     return bmodfile;
@@ -624,6 +695,10 @@ bool ModCore::addModBlackList(const QString &modName)
     instream << QString("install %1 /bin/false").arg(modName) << endl;
 #endif
 
+    instream.flush();
+    blackfile.close();
+    resetContext();
+
     //添加黑名单后需要更新现有的initramfs
     updateInitramfs();
     return  true;
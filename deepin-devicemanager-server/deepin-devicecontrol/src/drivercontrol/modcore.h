@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QStringList>
+#include <QMutex>
 
 #include <libkmod.h>
 
@@ -69,6 +70,8 @@ public:
     bool setModLoadedOnBoot(const QString &modName);
     //移除mod loaded on boot
     void rmModLoadedOnBoot(const QString &modName);
+    //丢弃共享的kmod上下文，模块依赖或黑名单变化后调用
+    static void resetContext();
 
 
 private:
@@ -91,6 +94,14 @@ private:
      */
     void updateInitramfs();
 
+    //加锁使用进程内共享的kmod上下文
+    class ContextLocker;
+    //获取kmod上下文依赖的索引文件与配置路径的修改时间
+    static QList<qint64> ctxFilesMtime(struct kmod_ctx *ctx);
+
+    static QMutex           s_ctxMutex;     //kmod上下文不是线程安全的，使用期间加锁
+    static struct kmod_ctx *s_ctx;          //进程内共享的kmod上下文
+    static QList<qint64>    s_ctxMtimes;    //创建上下文时索引文件与配置路径的修改时间
 };
 
 #endif // MODCORE_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "utils.h"
+#include "modcore.h"
 #include "DDLog.h"
 
 #include <QProcess>
@@ -196,6 +197,10 @@ bool Utils::updateModDeps(bool bquick)
     if (!process.waitForFinished())
         return  false;
 
+#ifndef DISABLE_DRIVER
+    //依赖更新后重新加载模块索引
+    ModCore::resetContext();
+#endif
     return  true;
 }
 
@@ -5,6 +5,7 @@
 #include "enableutils.h"
 #include "enablesqlmanager.h"
 #include "DDLog.h"
+#include "HwinfoTokenizer.h"
 
 #include <QStringList>
 #include <QMap>
@@ -189,17 +190,17 @@ bool EnableUtils::ioctlOperateNetworkLogicalName(const QString &logicalName, boo
 bool EnableUtils::getMapInfo(const QString &item, QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Parsing device info map";
-    QStringList lines = item.split("\n");
     // 行数太少则为无用信息
-    if (lines.size() <= LEAST_NUM) {
+    if (item.count('\n') + 1 <= LEAST_NUM) {
         return false;
     }
 
-    foreach (const QString &line, lines) {
-        QStringList words = line.split(": ");
-        if (words.size() != 2)
+    HwinfoTokenizer tokenizer(item);
+    HwinfoToken token;
+    while (tokenizer.next(token)) {
+        if (!token.valid)
             continue;
-        mapInfo.insert(words[0].trimmed(), words[1].replace("\"", "").trimmed());
+        mapInfo.insert(token.key.toString(), token.value.toString().remove('"').trimmed());
     }
 
     // hub为usb接口，可以直接过滤
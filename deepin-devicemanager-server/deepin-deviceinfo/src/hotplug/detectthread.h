@@ -6,8 +6,8 @@
 #define DETECTTHREAD_H
 
 #include <QThread>
-#include <QMap>
-#include <QDateTime>
+#include <QStringList>
+#include <QVariantMap>
 
 class MonitorUsb;
 
@@ -30,48 +30,30 @@ public:
      */
     void setWorkingFlag(bool flag);
 
-signals:
-    /**
-     * @brief usbChanged
-     */
-    void usbChanged();
-
-private slots:
     /**
-     * @brief slotUsbChanged usb发生变化时的曹函数处理
-     */
-    void slotUsbChanged();
-
-private:
-    /**
-     * @brief isUsbDevicesChanged 判断hwinfo --usb信息是否发生变化
+     * @brief statistics 热插拔事件统计
      * @return
      */
-    bool isUsbDevicesChanged();
-
-    /**
-     * @brief updateMemUsbInfo 更新
-     * @param usbInfo
-     */
-    void updateMemUsbInfo(const QMap<QString, QMap<QString, QString>> &usbInfo);
+    QVariantMap statistics() const;
 
+signals:
     /**
-     * @brief curHwinfoUsbInfo 获取当前的usb信息
-     * @param usbInfo
+     * @brief usbChanged
+     * @param eventClasses : 本次变化包含的事件类别
+     * @param disks : 本次插入的硬盘
      */
-    void curHwinfoUsbInfo(QMap<QString, QMap<QString, QString>> &usbInfo);
+    void usbChanged(const QStringList &eventClasses, const QStringList &disks);
 
+private slots:
     /**
-     * @brief getMapInfo 解析usb信息
-     * @param item
-     * @param mapInfo
-     * @return
+     * @brief slotUsbChanged usb发生变化时的曹函数处理
+     * @param eventClasses : 本次变化包含的事件类别
+     * @param disks : 本次插入的硬盘
      */
-    bool getMapInfo(const QString &item, QMap<QString, QString> &mapInfo);
+    void slotUsbChanged(const QStringList &eventClasses, const QStringList &disks);
 
 private:
     MonitorUsb *mp_MonitorUsb; //<! udev检测任务
-    QMap<QString, QMap<QString, QString>> m_MapUsbInfo; //<! usb信息
 };
 
 #endif // DETECTTHREAD_H
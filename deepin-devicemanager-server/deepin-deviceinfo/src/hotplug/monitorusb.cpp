@@ -8,7 +8,6 @@
 #include "DDLog.h"
 
 #include <QLoggingCategory>
-#include <QProcess>
 #include <QFile>
 #include <QDateTime>
 
@@ -17,8 +16,16 @@ using namespace DDLog;
 MonitorUsb::MonitorUsb()
     : m_Udev(nullptr)
     , mp_Timer(new QTimer(this))
-    , m_UsbChangeTime()
-    , m_UsbChanged(false)
+    , m_RemovePending(false)
+    , m_LastRemoveTime(0)
+    , m_Overflow(false)
+    , m_Received(0)
+    , m_Dropped(0)
+    , m_Coalesced(0)
+    , m_Refreshes(0)
+    , m_WindowEvents(0)
+    , m_WindowStart(0)
+    , m_LastEventTime(0)
     , m_workingFlag(true)
 {
     qCDebug(appLog) << "Initializing USB monitor";
@@ -31,6 +38,8 @@ MonitorUsb::MonitorUsb()
     // 增加一个udev事件过滤器
     udev_monitor_filter_add_match_subsystem_devtype(mon, "usb", nullptr);
     udev_monitor_filter_add_match_subsystem_devtype(mon, "bluetooth", nullptr);
+    // 硬盘的块设备在usb事件之后生成，单独监听以便只读取变化的硬盘
+    udev_monitor_filter_add_match_subsystem_devtype(mon, "block", "disk");
     // 启动监控
     udev_monitor_enable_receiving(mon);
     // 获取该监控的文件描述符，fd就代表了这个监控
@@ -38,7 +47,7 @@ MonitorUsb::MonitorUsb()
 
     // 定时器发送消息
     connect(mp_Timer, &QTimer::timeout, this, &MonitorUsb::slotTimeout);
-    mp_Timer->start(1000);
+    mp_Timer->start(100);
     qCDebug(appLog) << "Started USB monitor timer";
 }
 
@@ -59,9 +68,12 @@ void MonitorUsb::monitor()
         tv.tv_usec = 10000;
         int ret = select(fd + 1, &fds, nullptr, nullptr, &tv);
 
-        // 判断是否有事件产生
-        if (!ret)
+        // 判断是否有事件产生，一批拔出事件结束后只更新一次唤醒信息
+        if (!ret) {
+            if (m_RemovePending && QDateTime::currentMSecsSinceEpoch() - m_LastRemoveTime >= CONTROL_WINDOW)
+                updateWakeupInfo();
             continue;
+        }
         if (! FD_ISSET(fd, &fds))
             continue;
 
@@ -72,10 +84,30 @@ void MonitorUsb::monitor()
             continue;
         }
 
+        const char *subsystem = udev_device_get_subsystem(dev);
+        const char *devtype = udev_device_get_devtype(dev);
+        const char *interfaces = udev_device_get_property_value(dev, "ID_USB_INTERFACES");
+        QStringList eventCls = eventClasses(subsystem, devtype, interfaces);
+
         // 监测蓝牙设备
-        if (0 == strcmp(udev_device_get_devtype(dev), "link") && m_workingFlag) {
+        if (devtype && 0 == strcmp(devtype, "link") && m_workingFlag) {
             qCDebug(appLog) << "Bluetooth device change detected";
-            emit usbChanged();
+            pushEvent(eventCls);
+            udev_device_unref(dev);
+            continue;
+        }
+
+        // 块设备只刷新变化的硬盘，拔出时只需要更新硬盘列表
+        if (subsystem && 0 == strcmp(subsystem, "block")) {
+            const char *action = udev_device_get_action(dev);
+            QString name = udev_device_get_sysname(dev);
+            if (action && isPhysicalDisk(name) && m_workingFlag) {
+                if (0 == strcmp("add", action))
+                    pushEvent(eventCls, name);
+                else if (0 == strcmp("remove", action))
+                    pushEvent(eventCls);
+            }
+            udev_device_unref(dev);
             continue;
         }
 
@@ -90,19 +122,18 @@ void MonitorUsb::monitor()
         // 只有add和remove事件才会更新缓存信息
         strcpy(buf, udev_device_get_action(dev));
         if ((0 == strcmp("add", buf) || 0 == strcmp("remove", buf)) && m_workingFlag) {
-            qCDebug(appLog) << "USB device " << buf << " detected";
-            QProcess process;
-            process.start("hwinfo --usb");
-            process.waitForFinished(-1);
-            QString info = process.readAllStandardOutput();
-            if (0 == strcmp("add", buf)) {
-                qCDebug(appLog) << "Processing USB add event";
-                ControlInterface::getInstance()->disableOutDevice(info);
+            QMap<QString, QString> mapInfo;
+            if (UsbEnumerator::record(dev, mapInfo)) {
+                qCInfo(appLog) << "USB device" << buf << mapInfo["Unique ID"] << mapInfo["Vendor"] << mapInfo["Device"];
+                // 插入的设备只处理该设备，拔出后剩余设备的唤醒信息需要重新设置
+                if (0 == strcmp("add", buf)) {
+                    updateControlInfo(mapInfo);
+                } else {
+                    m_RemovePending = true;
+                    m_LastRemoveTime = QDateTime::currentMSecsSinceEpoch();
+                }
             }
-            ControlInterface::getInstance()->updateWakeup(info);
-            m_UsbChanged = true;
-            m_UsbChangeTime = QDateTime::currentMSecsSinceEpoch();
-            qCDebug(appLog) << "Updated USB device info";
+            pushEvent(eventCls);
         }
 
         udev_device_unref(dev);
@@ -110,6 +141,28 @@ void MonitorUsb::monitor()
     qCDebug(appLog) << "Exited USB monitor loop";
 }
 
+void MonitorUsb::updateControlInfo(const QMap<QString, QString> &mapInfo)
+{
+    qCDebug(appLog) << "Updating control info for USB device:" << mapInfo["Unique ID"];
+    QString info = UsbEnumerator::toHwinfoText(mapInfo);
+    ControlInterface::getInstance()->disableOutDevice(info);
+    ControlInterface::getInstance()->updateWakeup(info);
+}
+
+void MonitorUsb::updateWakeupInfo()
+{
+    qCDebug(appLog) << "Processing USB remove events";
+    m_RemovePending = false;
+    QMap<QString, QMap<QString, QString>> usbInfo;
+    if (!m_Enumerator.enumerate(usbInfo))
+        return;
+
+    QStringList items;
+    foreach (const QString &key, usbInfo.keys())
+        items.append(UsbEnumerator::toHwinfoText(usbInfo[key]));
+    ControlInterface::getInstance()->updateWakeup(items.join("\n"));
+}
+
 void MonitorUsb::setWorkingFlag(bool flag)
 {
     qCDebug(appLog) << "Setting working flag to:" << flag;
@@ -118,11 +171,114 @@ void MonitorUsb::setWorkingFlag(bool flag)
 
 void MonitorUsb::slotTimeout()
 {
-    if (!m_UsbChanged || !m_workingFlag)
+    // 将队列中的事件合并到当前窗口
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    HotplugEvent event;
+    while (m_Queue.pop(event)) {
+        if (0 == m_WindowEvents)
+            m_WindowStart = event.time;
+        else
+            ++m_Coalesced;
+        ++m_WindowEvents;
+        m_LastEventTime = event.time;
+        foreach (const QString &eventClass, event.eventClasses) {
+            if (!m_WindowClasses.contains(eventClass))
+                m_WindowClasses.append(eventClass);
+        }
+        if (!event.disk.isEmpty() && !m_WindowDisks.contains(event.disk))
+            m_WindowDisks.append(event.disk);
+    }
+    if (m_Overflow.exchange(false)) {
+        if (0 == m_WindowEvents) {
+            m_WindowStart = now;
+            m_LastEventTime = now;
+            ++m_WindowEvents;
+        }
+        if (!m_WindowClasses.contains(EVENT_CLASS_ALL))
+            m_WindowClasses.append(EVENT_CLASS_ALL);
+    }
+
+    if (0 == m_WindowEvents || !m_workingFlag)
         return;
-    if (QDateTime::currentMSecsSinceEpoch() - m_UsbChangeTime < 1000)
+    // 持续有事件时最长等待COALESCE_MAX
+    if (now - m_LastEventTime < COALESCE_WINDOW && now - m_WindowStart < COALESCE_MAX)
         return;
-    qCDebug(appLog) << "Emitting USB changed signal after debounce";
-    m_UsbChanged = false;
-    emit usbChanged();
+
+    ++m_Refreshes;
+    qCInfo(appLog) << "Emitting USB changed signal, events:" << m_WindowEvents << "classes:" << m_WindowClasses
+                   << "disks:" << m_WindowDisks << "statistics:" << statistics();
+    QStringList eventClasses = m_WindowClasses;
+    QStringList disks = m_WindowDisks;
+    m_WindowClasses.clear();
+    m_WindowDisks.clear();
+    m_WindowEvents = 0;
+    emit usbChanged(eventClasses, disks);
+}
+
+void MonitorUsb::pushEvent(const QStringList &eventClasses, const QString &disk)
+{
+    ++m_Received;
+    HotplugEvent event;
+    event.eventClasses = eventClasses;
+    event.disk = disk;
+    event.time = QDateTime::currentMSecsSinceEpoch();
+    if (!m_Queue.push(event)) {
+        // 队列满时不阻塞udev线程，主线程按全部更新处理
+        ++m_Dropped;
+        m_Overflow = true;
+    }
+}
+
+QVariantMap MonitorUsb::statistics() const
+{
+    QVariantMap map;
+    map.insert("received", static_cast<qulonglong>(m_Received.load()));
+    map.insert("dropped", static_cast<qulonglong>(m_Dropped.load()));
+    map.insert("coalesced", static_cast<qulonglong>(m_Coalesced.load()));
+    map.insert("refreshes", static_cast<qulonglong>(m_Refreshes.load()));
+    return map;
+}
+
+QStringList MonitorUsb::eventClasses(const QString &subsystem, const QString &devtype, const QString &interfaces)
+{
+    if ("bluetooth" == subsystem || "link" == devtype)
+        return QStringList() << EVENT_CLASS_BLUETOOTH;
+    if ("block" == subsystem)
+        return QStringList() << EVENT_CLASS_STORAGE;
+
+    // ID_USB_INTERFACES 格式为 :ccssppp:ccsspp:，cc为接口类
+    static const struct {
+        const char *usbClass;
+        const char *eventClass;
+    } table[] = {
+        { "08", EVENT_CLASS_STORAGE },
+        { "e0", EVENT_CLASS_BLUETOOTH },
+        { "07", EVENT_CLASS_PRINTER },
+        { "02", EVENT_CLASS_NETWORK },
+        { "0a", EVENT_CLASS_NETWORK },
+        { "01", EVENT_CLASS_MULTIMEDIA },
+        { "0e", EVENT_CLASS_MULTIMEDIA },
+        { "03", EVENT_CLASS_INPUT },
+    };
+    QStringList classes;
+    foreach (const QString &item, interfaces.split(":")) {
+        if (item.size() >= 2)
+            classes.append(item.left(2).toLower());
+    }
+    // 复合设备取所有接口的类别，如带蓝牙的存储设备同时更新存储与蓝牙信息
+    QStringList eventClasses;
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); ++i) {
+        if (classes.contains(table[i].usbClass) && !eventClasses.contains(table[i].eventClass))
+            eventClasses.append(table[i].eventClass);
+    }
+    if (eventClasses.isEmpty())
+        eventClasses.append(EVENT_CLASS_OTHER);
+    return eventClasses;
+}
+
+bool MonitorUsb::isPhysicalDisk(const QString &name)
+{
+    if (name.isEmpty())
+        return false;
+    return !name.startsWith("loop") && !name.startsWith("ram") && !name.startsWith("zram");
 }
@@ -9,8 +9,38 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#include "spscqueue.h"
+#include "usbenumerator.h"
+
 #include <QObject>
 #include <QTimer>
+#include <QStringList>
+#include <QVariantMap>
+#include <atomic>
+
+// 热插拔事件类别，用于确定需要重新采集的信息
+#define EVENT_CLASS_STORAGE     "storage"
+#define EVENT_CLASS_INPUT       "input"
+#define EVENT_CLASS_PRINTER     "printer"
+#define EVENT_CLASS_BLUETOOTH   "bluetooth"
+#define EVENT_CLASS_NETWORK     "network"
+#define EVENT_CLASS_MULTIMEDIA  "multimedia"
+#define EVENT_CLASS_OTHER       "other"
+#define EVENT_CLASS_ALL         "all"       // 事件队列溢出，需要全部更新
+
+#define EVENT_QUEUE_SIZE        256         // 事件队列长度
+#define COALESCE_WINDOW         1000        // 最后一个事件之后静默多久发送变化(ms)
+#define COALESCE_MAX            5000        // 一个合并窗口的最长时间(ms)
+#define CONTROL_WINDOW          200         // 最后一个拔出事件之后静默多久更新唤醒信息(ms)
+
+/**
+ * @brief The HotplugEvent struct : udev线程传给主线程的事件
+ */
+struct HotplugEvent {
+    QStringList eventClasses; //<! 事件类别
+    QString     disk;         //<! 插入的硬盘名称，如 sdb，仅块设备事件
+    qint64      time;         //<! 事件时间
+};
 
 class MonitorUsb : public QObject
 {
@@ -27,11 +57,35 @@ public:
      */
     void setWorkingFlag(bool flag);
 
+    /**
+     * @brief eventClasses 根据udev事件的子系统及usb接口类确定事件类别
+     * @param subsystem : 子系统
+     * @param devtype : 设备类型
+     * @param interfaces : ID_USB_INTERFACES，如 :080650:
+     * @return EVENT_CLASS_*，复合设备返回所有接口的类别
+     */
+    static QStringList eventClasses(const QString &subsystem, const QString &devtype, const QString &interfaces);
+
+    /**
+     * @brief isPhysicalDisk 是否需要读取硬盘信息，loop/ram/zram等虚拟块设备不需要
+     * @param name : 块设备名称
+     * @return
+     */
+    static bool isPhysicalDisk(const QString &name);
+
+    /**
+     * @brief statistics 事件统计
+     * @return received: 收到的事件数 dropped: 队列满丢弃的事件数 coalesced: 合并到已有窗口的事件数 refreshes: 发出的刷新次数
+     */
+    QVariantMap statistics() const;
+
 signals:
     /**
      * @brief usbChanged
+     * @param eventClasses : 本次变化包含的事件类别
+     * @param disks : 本次插入的硬盘，只需要读取这些硬盘的信息
      */
-    void usbChanged();
+    void usbChanged(const QStringList &eventClasses, const QStringList &disks);
 
 private slots:
     /**
@@ -39,14 +93,47 @@ private slots:
      */
     void slotTimeout();
 
+private:
+    /**
+     * @brief updateControlInfo 插入设备后根据该设备的信息更新禁用及唤醒信息
+     * @param mapInfo : UsbEnumerator::record 生成的设备信息
+     */
+    void updateControlInfo(const QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief updateWakeupInfo 拔出设备后根据当前的usb设备更新唤醒信息
+     */
+    void updateWakeupInfo();
+
+    /**
+     * @brief pushEvent 在udev线程中将事件放入队列
+     * @param eventClasses : 事件类别
+     * @param disk : 插入的硬盘名称
+     */
+    void pushEvent(const QStringList &eventClasses, const QString &disk = QString());
+
 private:
     bool                              m_workingFlag;        //<! 工作状态
     struct udev                       *m_Udev;              //<! udev Environment
     struct udev_monitor               *mon;                 //<! object of mon
     int                               fd;                   //<! fd
     QTimer                            *mp_Timer;            //<! 定时器
-    qint64                            m_UsbChangeTime;      //<! 记录当前时间
-    bool                              m_UsbChanged;         //<! 记录是否有usb插拔
+    UsbEnumerator                     m_Enumerator;         //<! usb设备枚举，仅udev线程使用
+    bool                              m_RemovePending;      //<! 是否有尚未处理的拔出事件，仅udev线程使用
+    qint64                            m_LastRemoveTime;     //<! 最后一个拔出事件的时间，仅udev线程使用
+
+    SpscQueue<HotplugEvent, EVENT_QUEUE_SIZE> m_Queue;      //<! udev线程 -> 主线程
+    std::atomic<bool>                 m_Overflow;           //<! 队列是否溢出过
+    std::atomic<quint64>              m_Received;           //<! 收到的事件数
+    std::atomic<quint64>              m_Dropped;            //<! 丢弃的事件数
+    std::atomic<quint64>              m_Coalesced;          //<! 合并的事件数
+    std::atomic<quint64>              m_Refreshes;          //<! 发出的刷新次数
+
+    QStringList                       m_WindowClasses;      //<! 当前窗口的事件类别，仅主线程使用
+    QStringList                       m_WindowDisks;        //<! 当前窗口插入的硬盘，仅主线程使用
+    int                               m_WindowEvents;       //<! 当前窗口的事件数
+    qint64                            m_WindowStart;        //<! 当前窗口开始时间
+    qint64                            m_LastEventTime;      //<! 当前窗口最后一个事件的时间
 };
 
 #endif // MONITORUSB_H
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief The SpscQueue class
+ * 单生产者单消费者的无锁有界队列，生产者为udev监听线程，消费者为主线程
+ * Size 必须为2的幂
+ */
+template<typename T, size_t Size>
+class SpscQueue
+{
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+public:
+    SpscQueue()
+        : m_Head(0)
+        , m_Tail(0)
+    {}
+
+    /**
+     * @brief push 仅由生产者调用
+     * @param value
+     * @return 队列已满时返回false
+     */
+    bool push(const T &value)
+    {
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_Head.load(std::memory_order_acquire) >= Size)
+            return false;
+        m_Items[tail & (Size - 1)] = value;
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief pop 仅由消费者调用
+     * @param value
+     * @return 队列为空时返回false
+     */
+    bool pop(T &value)
+    {
+        size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_Tail.load(std::memory_order_acquire))
+            return false;
+        value = m_Items[head & (Size - 1)];
+        // 释放槽位中的数据，避免隐式共享的数据在生产者线程中析构
+        m_Items[head & (Size - 1)] = T();
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T                   m_Items[Size];
+    std::atomic<size_t> m_Head;     //<! 消费者位置
+    std::atomic<size_t> m_Tail;     //<! 生产者位置
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "usbenumerator.h"
+#include "DDLog.h"
+
+#include <QLoggingCategory>
+#include <QCryptographicHash>
+
+#include <libudev.h>
+#include <string.h>
+
+using namespace DDLog;
+
+// sysfs属性不存在时(如remove事件)使用udev事件属性，没有对应的事件属性时传nullptr
+static QString attrOrProperty(struct udev_device *dev, const char *attr, const char *property = nullptr)
+{
+    const char *value = udev_device_get_sysattr_value(dev, attr);
+    if (!value && property)
+        value = udev_device_get_property_value(dev, property);
+    return value ? QString(value).trimmed() : QString();
+}
+
+UsbEnumerator::UsbEnumerator()
+    : mp_Udev(udev_new())
+{
+    if (!mp_Udev)
+        qCWarning(appLog) << "Failed to create udev context";
+}
+
+UsbEnumerator::~UsbEnumerator()
+{
+    if (mp_Udev)
+        udev_unref(mp_Udev);
+}
+
+bool UsbEnumerator::enumerate(QMap<QString, QMap<QString, QString>> &usbInfo)
+{
+    if (!mp_Udev)
+        return false;
+
+    struct udev_enumerate *enumerate = udev_enumerate_new(mp_Udev);
+    if (!enumerate)
+        return false;
+    udev_enumerate_add_match_subsystem(enumerate, "usb");
+    udev_enumerate_add_match_property(enumerate, "DEVTYPE", "usb_device");
+    udev_enumerate_scan_devices(enumerate);
+
+    struct udev_list_entry *entry = nullptr;
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+        struct udev_device *dev = udev_device_new_from_syspath(mp_Udev, udev_list_entry_get_name(entry));
+        if (!dev)
+            continue;
+        QMap<QString, QString> mapInfo;
+        if (record(dev, mapInfo))
+            usbInfo.insert(mapInfo["Unique ID"], mapInfo);
+        udev_device_unref(dev);
+    }
+    udev_enumerate_unref(enumerate);
+    qCDebug(appLog) << "Enumerated" << usbInfo.size() << "USB devices";
+    return true;
+}
+
+bool UsbEnumerator::record(struct udev_device *dev, QMap<QString, QString> &mapInfo)
+{
+    const char *devtype = udev_device_get_devtype(dev);
+    if (!devtype || 0 != strcmp(devtype, "usb_device"))
+        return false;
+
+    QString vendorId = attrOrProperty(dev, "idVendor", "ID_VENDOR_ID");
+    QString productId = attrOrProperty(dev, "idProduct", "ID_MODEL_ID");
+    // PRODUCT=46d/c077/7200
+    QStringList product = QString(udev_device_get_property_value(dev, "PRODUCT")).split("/");
+    if (vendorId.isEmpty() && product.size() >= 2)
+        vendorId = product[0].rightJustified(4, '0');
+    if (productId.isEmpty() && product.size() >= 2)
+        productId = product[1].rightJustified(4, '0');
+    if (vendorId.isEmpty() || productId.isEmpty())
+        return false;
+
+    // hub为usb接口，可以直接过滤；TYPE=9/0/1
+    QString deviceClass = attrOrProperty(dev, "bDeviceClass");
+    if (deviceClass.isEmpty())
+        deviceClass = QString(udev_device_get_property_value(dev, "TYPE")).section("/", 0, 0).rightJustified(2, '0');
+    if ("09" == deviceClass)
+        return false;
+
+    // hwinfo 的 SysFS ID 为第一个接口的路径
+    QString config = attrOrProperty(dev, "bConfigurationValue");
+    if (config.isEmpty())
+        config = "1";
+    mapInfo.insert("SysFS ID", QString("%1/%2:%3.0").arg(udev_device_get_devpath(dev)).arg(udev_device_get_sysname(dev)).arg(config));
+    mapInfo.insert("SysFS BusID", QString("%1:%2.0").arg(udev_device_get_sysname(dev)).arg(config));
+    mapInfo.insert("Hotplug", "USB");
+
+    QString manufacturer = attrOrProperty(dev, "manufacturer", "ID_VENDOR");
+    QString model = attrOrProperty(dev, "product", "ID_MODEL");
+    mapInfo.insert("Vendor", QString("usb 0x%1").arg(vendorId) + (manufacturer.isEmpty() ? "" : QString(" \"%1\"").arg(manufacturer)));
+    mapInfo.insert("Device", QString("usb 0x%1").arg(productId) + (model.isEmpty() ? "" : QString(" \"%1\"").arg(model)));
+    mapInfo.insert("Model", QString("\"%1\"").arg(QString("%1 %2").arg(manufacturer).arg(model).trimmed()));
+    QString revision = attrOrProperty(dev, "bcdDevice", "ID_REVISION");
+    mapInfo.insert("Revision", revision.isEmpty() ? QString() : QString("\"%1.%2\"").arg(revision.left(2)).arg(revision.mid(2)));
+    QString speed = attrOrProperty(dev, "speed");
+    mapInfo.insert("Speed", speed.isEmpty() ? QString() : QString("%1 Mbps").arg(speed));
+    QString modalias = udev_device_get_property_value(dev, "MODALIAS");
+    if (!modalias.isEmpty())
+        mapInfo.insert("Module Alias", QString("\"%1\"").arg(modalias));
+
+    QString serial = attrOrProperty(dev, "serial", "ID_SERIAL_SHORT");
+    if (!serial.isEmpty())
+        mapInfo.insert("Serial ID", serial);
+
+    // 存储设备在块设备生成后才有容量信息
+    QString interfaces = udev_device_get_property_value(dev, "ID_USB_INTERFACES");
+    if (interfaces.contains(":08")) {
+        mapInfo.insert("Hardware Class", "disk");
+        struct udev_enumerate *enumerate = udev_enumerate_new(udev_device_get_udev(dev));
+        if (enumerate) {
+            udev_enumerate_add_match_subsystem(enumerate, "block");
+            udev_enumerate_add_match_property(enumerate, "DEVTYPE", "disk");
+            udev_enumerate_add_match_parent(enumerate, dev);
+            udev_enumerate_scan_devices(enumerate);
+            struct udev_list_entry *entry = nullptr;
+            udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+                struct udev_device *block = udev_device_new_from_syspath(udev_device_get_udev(dev), udev_list_entry_get_name(entry));
+                if (!block)
+                    continue;
+                quint64 sectors = QString(udev_device_get_sysattr_value(block, "size")).toULongLong();
+                udev_device_unref(block);
+                if (sectors > 0) {
+                    mapInfo.insert("Capacity", QString("%1 bytes").arg(sectors * 512));
+                    break;
+                }
+            }
+            udev_enumerate_unref(enumerate);
+        }
+    } else if (interfaces.contains(":030101")) {
+        // HID 引导协议 1 为键盘，2 为鼠标，与 hwinfo 的分类一致
+        mapInfo.insert("Hardware Class", "keyboard");
+    } else if (interfaces.contains(":030102")) {
+        mapInfo.insert("Hardware Class", "mouse");
+    } else {
+        mapInfo.insert("Hardware Class", "usb");
+    }
+
+    mapInfo.insert("Unique ID", uniqueID(mapInfo));
+    return true;
+}
+
+QString UsbEnumerator::uniqueID(const QMap<QString, QString> &mapInfo)
+{
+    QStringList vendorlist = mapInfo.value("Vendor").split(" ");
+    QStringList devicelist = mapInfo.value("Device").split(" ");
+    QString sysfs = mapInfo.contains("SysFS Device Link") && !mapInfo["SysFS Device Link"].isEmpty()
+                    ? mapInfo["SysFS Device Link"] : mapInfo.value("SysFS ID");
+    if (vendorlist.size() < 2 || devicelist.size() < 2 || sysfs.isEmpty())
+        return mapInfo.value("Unique ID");
+
+    QString valueStr = vendorlist[1].trimmed() + devicelist[1].remove("0x", Qt::CaseSensitive).trimmed();
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(valueStr.toUtf8() + sysfs.trimmed().toUtf8());
+    return QString::fromLatin1(hash.result().toBase64());
+}
+
+QString UsbEnumerator::toHwinfoText(const QMap<QString, QString> &mapInfo)
+{
+    QString text = QString("USB %1: %2\n").arg(mapInfo.value("SysFS BusID")).arg(mapInfo.value("Hardware Class"));
+    for (QMap<QString, QString>::const_iterator it = mapInfo.constBegin(); it != mapInfo.constEnd(); ++it)
+        text += QString("  %1: %2\n").arg(it.key()).arg(it.value());
+    return text;
+}
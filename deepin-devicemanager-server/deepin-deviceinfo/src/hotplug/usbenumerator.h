@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef USBENUMERATOR_H
+#define USBENUMERATOR_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+struct udev;
+struct udev_device;
+
+/**
+ * @brief The UsbEnumerator class
+ * 通过libudev直接枚举usb设备，生成与 hwinfo --usb 相同的 Unique ID / SysFS ID / Vendor / Device 字段
+ */
+class UsbEnumerator
+{
+public:
+    UsbEnumerator();
+    ~UsbEnumerator();
+
+    /**
+     * @brief enumerate 枚举当前所有usb设备(不包含hub)
+     * @param usbInfo : Unique ID -> 设备信息
+     * @return 是否枚举成功
+     */
+    bool enumerate(QMap<QString, QMap<QString, QString>> &usbInfo);
+
+    /**
+     * @brief record 根据udev设备生成设备信息，remove事件中sysfs属性已不存在时使用事件属性
+     * @param dev : usb_device 类型的udev设备
+     * @param mapInfo : 设备信息
+     * @return 是否为有效的usb设备
+     */
+    static bool record(struct udev_device *dev, QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief uniqueID 与 hwinfo 解析结果相同的唯一标识：md5(Vendor + Device + SysFS ID)
+     * @param mapInfo : 设备信息
+     * @return
+     */
+    static QString uniqueID(const QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief toHwinfoText 生成与 hwinfo --usb 中单个设备相同格式的文本，用于更新禁用及唤醒信息
+     * @param mapInfo : record 生成的设备信息
+     * @return
+     */
+    static QString toHwinfoText(const QMap<QString, QString> &mapInfo);
+
+private:
+    struct udev *mp_Udev;
+};
+
+#endif // USBENUMERATOR_H
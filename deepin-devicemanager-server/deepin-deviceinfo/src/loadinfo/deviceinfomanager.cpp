@@ -8,43 +8,168 @@
 #include <QMutex>
 #include <QLoggingCategory>
 
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+
 using namespace DDLog;
 
-QMutex mutex;
 std::atomic<DeviceInfoManager *> DeviceInfoManager::s_Instance;
 std::mutex DeviceInfoManager::m_mutex;
 
 DeviceInfoManager::DeviceInfoManager(QObject *parent)
     : QObject(parent)
+    , m_Current(std::make_shared<Generation>())
+    , m_SnapshotGeneration(0)
+    , m_SnapshotFd(-1)
 {
     qCDebug(appLog) << "Initializing DeviceInfoManager";
 }
 
+DeviceInfoManager::GenerationPtr DeviceInfoManager::current() const
+{
+    return std::atomic_load(&m_Current);
+}
+
 void DeviceInfoManager::addInfo(const QString &key, const QString &value)
 {
-    qCDebug(appLog) << "Adding/updating info for key:" << key << "value length:" << value.length();
-    QMutexLocker locker(&mutex);
-    if (m_MapInfo.find(key) != m_MapInfo.end()) {
-        qCDebug(appLog) << "Updating existing key:" << key;
-        m_MapInfo[key] = value;
-    } else {
-        qCDebug(appLog) << "Inserting new key:" << key;
-        m_MapInfo.insert(key, value);
+    qCDebug(appLog) << "Staging info for key:" << key << "value length:" << value.length();
+    QMutexLocker locker(&m_WriteMutex);
+    m_Staging.insert(key, value);
+}
+
+bool DeviceInfoManager::publish()
+{
+    // 复制当前版本后合并本次采集的信息，整体发布；正在读取旧版本的读者不受影响
+    QMutexLocker locker(&m_WriteMutex);
+    if (m_Staging.isEmpty())
+        return false;
+
+    GenerationPtr old = current();
+    std::shared_ptr<Generation> next = std::make_shared<Generation>(*old);
+    next->generation = old->generation + 1;
+    for (QMap<QString, QString>::const_iterator it = m_Staging.constBegin(); it != m_Staging.constEnd(); ++it)
+        next->infos.insert(it.key(), it.value());
+    m_Staging.clear();
+    std::atomic_store(&m_Current, GenerationPtr(next));
+    qCDebug(appLog) << "Published info generation:" << next->generation;
+    return true;
+}
+
+QString DeviceInfoManager::getStagedInfo(const QString &key)
+{
+    {
+        QMutexLocker locker(&m_WriteMutex);
+        QMap<QString, QString>::const_iterator it = m_Staging.constFind(key);
+        if (it != m_Staging.constEnd())
+            return it.value();
     }
+    return current()->infos.value(key);
 }
 
-const QString &DeviceInfoManager::getInfo(const QString &key)
+QString DeviceInfoManager::getInfo(const QString &key)
 {
     qCDebug(appLog) << "Getting info for key:" << key;
-    QMutexLocker locker(&mutex);
-    return m_MapInfo[key];
+    return current()->infos.value(key);
+}
+
+QMap<QString, QString> DeviceInfoManager::getInfos(const QStringList &keys)
+{
+    qCDebug(appLog) << "Getting info for keys:" << keys;
+    GenerationPtr gen = current();
+    QMap<QString, QString> infos;
+    foreach (const QString &key, keys) {
+        QMap<QString, QString>::const_iterator it = gen->infos.constFind(key);
+        if (it != gen->infos.constEnd())
+            infos.insert(key, it.value());
+    }
+    return infos;
+}
+
+QMap<QString, QString> DeviceInfoManager::getAllInfo()
+{
+    qCDebug(appLog) << "Getting all info";
+    // QString隐式共享，此处只拷贝引用
+    return current()->infos;
+}
+
+quint64 DeviceInfoManager::generation()
+{
+    return current()->generation;
+}
+
+int DeviceInfoManager::snapshot()
+{
+    GenerationPtr gen = current();
+    QMutexLocker locker(&m_SnapshotMutex);
+    if (m_SnapshotFd >= 0 && m_SnapshotGeneration == gen->generation)
+        return m_SnapshotFd;
+
+    QList<QByteArray> items;
+    size_t size = SNAPSHOT_MAGIC_SIZE + sizeof(quint64) + sizeof(quint32);
+    for (QMap<QString, QString>::const_iterator it = gen->infos.constBegin(); it != gen->infos.constEnd(); ++it) {
+        items.append(it.key().toUtf8());
+        items.append(it.value().toUtf8());
+        size += 2 * sizeof(quint32) + static_cast<size_t>(items[items.size() - 2].size() + items.last().size());
+    }
+
+    int fd = memfd_create("deviceinfo-snapshot", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        qCWarning(appLog) << "Failed to create snapshot memfd:" << strerror(errno);
+        return -1;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        qCWarning(appLog) << "Failed to resize snapshot memfd:" << strerror(errno);
+        close(fd);
+        return -1;
+    }
+    char *data = static_cast<char *>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    if (MAP_FAILED == data) {
+        qCWarning(appLog) << "Failed to map snapshot memfd:" << strerror(errno);
+        close(fd);
+        return -1;
+    }
+
+    char *pos = data;
+    memcpy(pos, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    pos += SNAPSHOT_MAGIC_SIZE;
+    memcpy(pos, &gen->generation, sizeof(quint64));
+    pos += sizeof(quint64);
+    quint32 count = static_cast<quint32>(gen->infos.size());
+    memcpy(pos, &count, sizeof(quint32));
+    pos += sizeof(quint32);
+    foreach (const QByteArray &item, items) {
+        quint32 len = static_cast<quint32>(item.size());
+        memcpy(pos, &len, sizeof(quint32));
+        pos += sizeof(quint32);
+        memcpy(pos, item.constData(), len);
+        pos += len;
+    }
+    munmap(data, size);
+
+    // 密封后快照不可修改，客户端可以直接映射读取
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+        qCWarning(appLog) << "Failed to seal snapshot memfd:" << strerror(errno);
+
+    // 已发送给客户端的快照由客户端持有的描述符保持有效
+    if (m_SnapshotFd >= 0)
+        close(m_SnapshotFd);
+    m_SnapshotFd = fd;
+    m_SnapshotGeneration = gen->generation;
+    qCDebug(appLog) << "Published snapshot generation:" << m_SnapshotGeneration << "size:" << size;
+    return m_SnapshotFd;
 }
 
 bool DeviceInfoManager::isInfoExisted(const QString &key)
 {
     qCDebug(appLog) << "Checking if info exists for key:" << key;
-    QMutexLocker locker(&mutex);
-    bool exists = m_MapInfo.find(key) != m_MapInfo.end();
+    bool exists = current()->infos.contains(key);
+    if (!exists) {
+        QMutexLocker locker(&m_WriteMutex);
+        exists = m_Staging.contains(key);
+    }
     qCDebug(appLog) << "Info exists:" << exists;
     return exists;
 }
@@ -52,11 +177,10 @@ bool DeviceInfoManager::isInfoExisted(const QString &key)
 bool DeviceInfoManager::isPathExisted(const QString &path)
 {
     qCDebug(appLog) << "Checking if path exists:" << path;
-    QMutexLocker locker(&mutex);
-    const QString &hwinfo = m_MapInfo["hwinfo"];
+    GenerationPtr gen = current();
+    QString hwinfo = gen->infos.value("hwinfo");
     QString pathT = path;
     bool exists = hwinfo.contains(pathT.replace("/sys", ""));
     qCDebug(appLog) << "Path exists:" << exists;
     return exists;
 }
-
@@ -7,7 +7,13 @@
 
 #include <QObject>
 #include <QMap>
+#include <QStringList>
+#include <QMutex>
 #include <mutex>
+#include <memory>
+
+#define SNAPSHOT_MAGIC      "DISNAP01"
+#define SNAPSHOT_MAGIC_SIZE 8
 
 class DeviceInfoManager : public QObject
 {
@@ -34,21 +40,61 @@ public:
     }
 
     /**
-     * @brief addInfo
+     * @brief addInfo : 写入本次采集的信息，publish之前对客户端不可见
      * @param key
      * @param value
      */
     void addInfo(const QString &key, const QString &value);
 
+    /**
+     * @brief publish : 采集完成后将本次采集写入的信息一次发布为新版本
+     * @return 是否发布了新版本，没有写入时不发布
+     */
+    bool publish();
+
+    /**
+     * @brief getStagedInfo : 采集过程中读取，本次采集已写入的信息优先
+     * @param key
+     * @return
+     */
+    QString getStagedInfo(const QString &key);
+
     /**
      * @brief getInfo
      * @param key
+     * @return 返回拷贝(隐式共享)，不存在时返回空字符串
+     */
+    QString getInfo(const QString &key);
+
+    /**
+     * @brief getInfos : 一次获取多个关键字的信息，不存在的关键字不返回
+     * @param keys
+     * @return
+     */
+    QMap<QString, QString> getInfos(const QStringList &keys);
+
+    /**
+     * @brief getAllInfo : 获取所有缓存的信息
      * @return
      */
-    const QString &getInfo(const QString &key);
+    QMap<QString, QString> getAllInfo();
 
     /**
-     * @brief isInfoExisted
+     * @brief generation : 当前信息的版本号，每次publish递增，客户端可据此判断是否需要重新获取
+     * @return
+     */
+    quint64 generation();
+
+    /**
+     * @brief snapshot : 获取当前缓存的只读快照，信息有变化时重新生成
+     * 快照为密封的memfd，格式: SNAPSHOT_MAGIC | generation(quint64) | count(quint32) | [len(quint32) key len(quint32) value]...
+     * key/value 均为UTF-8编码
+     * @return 快照文件描述符，由DeviceInfoManager持有，调用者不能关闭；失败返回-1
+     */
+    int snapshot();
+
+    /**
+     * @brief isInfoExisted : 已发布或本次采集已写入
      * @param key
      * @return
      */
@@ -64,11 +110,35 @@ public:
 protected:
     explicit DeviceInfoManager(QObject *parent = nullptr);
 
+private:
+    /**
+     * @brief The Generation struct : 某一版本的全部信息，发布后不再修改
+     */
+    struct Generation {
+        Generation(): generation(1)
+        {}
+
+        quint64                generation;
+        QMap<QString, QString> infos;
+    };
+    typedef std::shared_ptr<const Generation> GenerationPtr;
+
+    /**
+     * @brief current : 读取当前版本，不加锁
+     * @return
+     */
+    GenerationPtr current() const;
+
 private:
     static std::atomic<DeviceInfoManager *> s_Instance;
     static std::mutex m_mutex;
 
-    QMap<QString, QString>     m_MapInfo;
+    GenerationPtr              m_Current;           //<! 当前版本，通过std::atomic_load/atomic_store读写
+    QMutex                     m_WriteMutex;        //<! 保护m_Staging及发布，读者不加锁
+    QMap<QString, QString>     m_Staging;           //<! 本次采集写入、尚未发布的信息
+    QMutex                     m_SnapshotMutex;
+    quint64                    m_SnapshotGeneration; //<! 当前快照对应的版本
+    int                        m_SnapshotFd;        //<! 当前快照
 };
 
 #endif // DEVICEINFOMANAGER_H
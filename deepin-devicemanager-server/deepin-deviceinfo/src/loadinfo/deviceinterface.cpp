@@ -9,6 +9,8 @@
 
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QTimer>
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 #include <polkit-qt5-1/PolkitQt1/Authority>
 #else
@@ -30,8 +32,10 @@ bool DeviceInterface::getUserAuthorPasswd()
 
 DeviceInterface::DeviceInterface(const char *name, QObject *parent)
     : QObject(parent)
+    , m_PendingId(0)
 {
     qCDebug(appLog) << "Initializing DeviceInterface for service:" << name;
+    qDBusRegisterMetaType<InfoMap>();
     QDBusConnection::RegisterOptions opts =
             QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals | QDBusConnection::ExportAllProperties;
 
@@ -54,9 +58,94 @@ QString DeviceInterface::getInfo(const QString &key)
     return "0";
 }
 
-void DeviceInterface::refreshInfo()
+InfoMap DeviceInterface::getInfos(const QStringList &keys)
 {
-    emit sigUpdate();
+    qCDebug(appLog) << "Getting info for keys:" << keys;
+    InfoMap infos = DeviceInfoManager::getInstance()->getInfos(keys);
+    if (keys.contains("is_server_running"))
+        infos.insert("is_server_running", MainJob::serverIsRunning() ? "1" : "0");
+    return infos;
+}
+
+InfoMap DeviceInterface::getAllInfo()
+{
+    qCDebug(appLog) << "Getting all info";
+    return DeviceInfoManager::getInstance()->getAllInfo();
+}
+
+qulonglong DeviceInterface::generation()
+{
+    return DeviceInfoManager::getInstance()->generation();
+}
+
+QDBusUnixFileDescriptor DeviceInterface::getSnapshot()
+{
+    qCDebug(appLog) << "Getting info snapshot";
+    int fd = DeviceInfoManager::getInstance()->snapshot();
+    if (fd < 0) {
+        sendErrorReply(QDBusError::Failed, "Failed to create snapshot");
+        return QDBusUnixFileDescriptor();
+    }
+    // 构造时会复制描述符
+    return QDBusUnixFileDescriptor(fd);
+}
+
+QVariantMap DeviceInterface::getHotplugStatistics()
+{
+    MainJob *parentMainJob = dynamic_cast<MainJob *>(parent());
+    if (parentMainJob == nullptr) {
+        qCWarning(appLog) << "Failed to get hotplug statistics - parent MainJob not found";
+        return QVariantMap();
+    }
+    return parentMainJob->hotplugStatistics();
+}
+
+qulonglong DeviceInterface::waitReady(qulonglong generation, int timeout)
+{
+    // 守护进程构造时已完成首次采集，之后才处理dbus调用
+    quint64 current = DeviceInfoManager::getInstance()->generation();
+    qCDebug(appLog) << "Waiting for collect generation:" << generation << "current:" << current;
+    if (!MainJob::serverIsRunning() && current >= generation)
+        return current;
+
+    // 采集完成或超时时再答复，不阻塞事件循环
+    setDelayedReply(true);
+    PendingReady pending { ++m_PendingId, generation, connection(), message() };
+    m_ListPending.append(pending);
+    int id = pending.id;
+    QTimer::singleShot(timeout, this, [this, id]() {
+        for (int i = 0; i < m_ListPending.size(); ++i) {
+            if (m_ListPending[i].id != id)
+                continue;
+            qCWarning(appLog) << "Waiting for collect generation" << m_ListPending[i].generation << "timed out";
+            m_ListPending[i].connection.send(m_ListPending[i].message.createErrorReply(QDBusError::Timeout, "Collection not ready"));
+            m_ListPending.removeAt(i);
+            break;
+        }
+    });
+    return 0;
+}
+
+void DeviceInterface::notifyReady(quint64 generation)
+{
+    emit ready(generation);
+    for (int i = m_ListPending.size() - 1; i >= 0; --i) {
+        if (m_ListPending[i].generation > generation)
+            continue;
+        m_ListPending[i].connection.send(m_ListPending[i].message.createReply(QVariant::fromValue(static_cast<qulonglong>(generation))));
+        m_ListPending.removeAt(i);
+    }
+}
+
+qulonglong DeviceInterface::refreshInfo()
+{
+    MainJob *parentMainJob = dynamic_cast<MainJob *>(parent());
+    if (parentMainJob == nullptr) {
+        qCWarning(appLog) << "Failed to refresh info - parent MainJob not found";
+        return 0;
+    }
+    // 由采集调度决定包含本次刷新的版本
+    return parentMainJob->requestRefresh();
 }
 
 void DeviceInterface::setMonitorDeviceFlag(bool flag)
@@ -7,6 +7,14 @@
 
 #include <QObject>
 #include <QDBusContext>
+#include <QDBusUnixFileDescriptor>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QMap>
+#include <QList>
+
+// a{ss}
+typedef QMap<QString, QString> InfoMap;
 
 class DeviceInterface : public QObject, protected QDBusContext
 {
@@ -16,8 +24,18 @@ class DeviceInterface : public QObject, protected QDBusContext
 public:
     explicit DeviceInterface(const char *name, QObject *parent = nullptr);
 
+    /**
+     * @brief notifyReady : 采集完成时调用，发出ready信号并答复等待中的waitReady
+     * @param generation : 完成的采集次数
+     */
+    void notifyReady(quint64 generation);
+
 signals:
-    void sigUpdate();
+    /**
+     * @brief ready : A collection has completed, the cached hardware information is consistent
+     * @param generation : information generation, see generation
+     */
+    Q_SCRIPTABLE void ready(qulonglong generation);
 
 public slots:
     /**
@@ -28,10 +46,49 @@ public slots:
     Q_SCRIPTABLE QString getInfo(const QString &key);
 
     /**
-     * @brief refreshInfo
-     * @return
+     * @brief getInfos : Obtain hardware information of several keys in one call
+     * @param keys
+     * @return : key -> hardware info, unknown keys are omitted
      */
-    Q_SCRIPTABLE void refreshInfo();
+    Q_SCRIPTABLE InfoMap getInfos(const QStringList &keys);
+
+    /**
+     * @brief getAllInfo : Obtain all cached hardware information in one call
+     * @return : key -> hardware info
+     */
+    Q_SCRIPTABLE InfoMap getAllInfo();
+
+    /**
+     * @brief generation : Obtain the generation of hardware information, it changes whenever the information is updated
+     * @return : generation
+     */
+    Q_SCRIPTABLE qulonglong generation();
+
+    /**
+     * @brief getSnapshot : Obtain a sealed, read-only memfd snapshot of all hardware information
+     * @return : file descriptor, the format is described in DeviceInfoManager::snapshot
+     */
+    Q_SCRIPTABLE QDBusUnixFileDescriptor getSnapshot();
+
+    /**
+     * @brief getHotplugStatistics : Obtain the hotplug event counters
+     * @return : received, dropped, coalesced and refreshes
+     */
+    Q_SCRIPTABLE QVariantMap getHotplugStatistics();
+
+    /**
+     * @brief waitReady : Block until the information of at least the given generation has been published
+     * @param generation : 0 waits for the running collection, if any
+     * @param timeout : milliseconds
+     * @return : the published generation, a Timeout error is returned if it is not published in time
+     */
+    Q_SCRIPTABLE qulonglong waitReady(qulonglong generation, int timeout);
+
+    /**
+     * @brief refreshInfo : Request a new collection, the call returns before the collection starts
+     * @return : the information generation that includes this refresh, pass it to waitReady
+     */
+    Q_SCRIPTABLE qulonglong refreshInfo();
 
     /**
      * @brief setMonitorDeviceFlag
@@ -41,6 +98,19 @@ public slots:
 
 private:
     bool getUserAuthorPasswd();
+
+    /**
+     * @brief The PendingReady struct 延迟答复的waitReady调用
+     */
+    struct PendingReady {
+        int             id;
+        quint64         generation;
+        QDBusConnection connection;
+        QDBusMessage    message;
+    };
+
+    QList<PendingReady> m_ListPending;     //<! 等待采集完成的调用
+    int                 m_PendingId;       //<! 用于超时时查找调用
 };
 
 #endif   // DEVICEINTERFACE_H
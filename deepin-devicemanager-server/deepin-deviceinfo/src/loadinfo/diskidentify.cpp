@@ -0,0 +1,264 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "diskidentify.h"
+#include "DDLog.h"
+
+#include <QFile>
+#include <QLoggingCategory>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <scsi/sg.h>
+#include <linux/nvme_ioctl.h>
+
+using namespace DDLog;
+
+#define ATA_CMD_IDENTIFY        0xEC
+#define NVME_ADMIN_IDENTIFY     0x06
+#define IO_TIMEOUT              5000    // 单个ioctl超时时间(ms)
+
+static quint16 word(const QByteArray &page, int index)
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(page.constData());
+    return static_cast<quint16>(data[index * 2] | (data[index * 2 + 1] << 8));
+}
+
+static quint64 littleEndian(const QByteArray &page, int offset, int size)
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(page.constData());
+    quint64 value = 0;
+    for (int i = size - 1; i >= 0; --i)
+        value = (value << 8) | data[offset + i];
+    return value;
+}
+
+bool DiskIdentify::readDevice(const QString &name, DiskIdentifyInfo &info)
+{
+    QString path = "/dev/" + name;
+    int fd = open(path.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK);
+    if (fd < 0) {
+        qCDebug(appLog) << "Failed to open" << path;
+        return false;
+    }
+
+    bool ok = false;
+    QByteArray buf;
+    if (name.startsWith("nvme")) {
+        // Identify Controller, CNS = 1
+        ok = readNvme(fd, NVME_ADMIN_IDENTIFY, 0, 1, buf) && parseNvmeIdentify(buf, info);
+    } else {
+        ok = readAta(fd, ATA_CMD_IDENTIFY, 0, buf) && parseAtaIdentify(buf, info);
+    }
+    close(fd);
+
+    // 容量读取失败时使用块设备大小
+    if (ok && 0 == info.capacity) {
+        QFile file(QString("/sys/block/%1/size").arg(name));
+        if (file.open(QIODevice::ReadOnly)) {
+            info.capacity = file.readAll().trimmed().toULongLong() * 512;
+            file.close();
+        }
+    }
+
+    qCDebug(appLog) << "Native identify" << path << "result:" << ok;
+    return ok;
+}
+
+bool DiskIdentify::parseAtaIdentify(const QByteArray &page, DiskIdentifyInfo &info)
+{
+    if (page.size() < ATA_IDENTIFY_SIZE)
+        return false;
+
+    // word 0 bit 15 为1表示不是ATA设备
+    if (word(page, 0) & 0x8000)
+        return false;
+
+    info.nvme = false;
+    info.serial = ataString(page, 10, 19);
+    info.firmware = ataString(page, 23, 26);
+    info.model = ataString(page, 27, 46);
+    if (info.model.isEmpty())
+        return false;
+
+    // 逻辑扇区大小
+    quint16 w106 = word(page, 106);
+    if ((w106 & 0xC000) == 0x4000 && (w106 & 0x1000)) {
+        quint32 words = word(page, 117) | (static_cast<quint32>(word(page, 118)) << 16);
+        if (words > 0)
+            info.sectorSize = static_cast<int>(words * 2);
+    }
+
+    // 容量：支持48位地址时使用 word 100-103，否则使用 word 60-61
+    quint64 sectors = 0;
+    if (word(page, 83) & 0x0400) {
+        for (int i = 103; i >= 100; --i)
+            sectors = (sectors << 16) | word(page, i);
+    }
+    if (0 == sectors)
+        sectors = word(page, 60) | (static_cast<quint64>(word(page, 61)) << 16);
+    info.capacity = sectors * static_cast<quint64>(info.sectorSize);
+
+    // 转速 word 217
+    quint16 rotation = word(page, 217);
+    if (0x0001 == rotation)
+        info.rotationRate = 1;
+    else if (rotation >= 0x0401 && rotation < 0xFFFF)
+        info.rotationRate = rotation;
+
+    // SATA版本 word 222，最大速度 word 76，当前速度 word 77
+    quint16 transport = word(page, 222);
+    static const char *versions[] = { "ATA8-AST", "SATA 1.0a", "SATA II Ext", "SATA 2.5", "SATA 2.6",
+                                      "SATA 3.0", "SATA 3.1", "SATA 3.2", "SATA 3.3", "SATA 3.4", "SATA 3.5" };
+    static const char *speeds[] = { "", "1.5 Gb/s", "3.0 Gb/s", "6.0 Gb/s" };
+    if ((transport & 0xF000) == 0x1000) {
+        QString version;
+        for (int i = 10; i >= 0; --i) {
+            if (transport & (1 << i)) {
+                version = versions[i];
+                break;
+            }
+        }
+        quint16 caps = word(page, 76);
+        int maxSpeed = 0;
+        for (int i = 3; i >= 1; --i) {
+            if (caps & (1 << i)) {
+                maxSpeed = i;
+                break;
+            }
+        }
+        int curSpeed = (word(page, 77) >> 1) & 0x7;
+        if (!version.isEmpty() && maxSpeed > 0) {
+            info.sataVersion = QString("%1, %2").arg(version).arg(speeds[maxSpeed]);
+            if (curSpeed > 0 && curSpeed <= 3)
+                info.sataVersion += QString(" (current: %1)").arg(speeds[curSpeed]);
+        }
+    }
+    return true;
+}
+
+bool DiskIdentify::parseNvmeIdentify(const QByteArray &page, DiskIdentifyInfo &info)
+{
+    if (page.size() < NVME_IDENTIFY_SIZE)
+        return false;
+
+    info.nvme = true;
+    info.serial = QString::fromLatin1(page.mid(4, 20)).trimmed();
+    info.model = QString::fromLatin1(page.mid(24, 40)).trimmed();
+    info.firmware = QString::fromLatin1(page.mid(64, 8)).trimmed();
+    // TNVMCAP bytes 280-295，只取低64位
+    info.capacity = littleEndian(page, 280, 8);
+    info.rotationRate = 1;
+    return !info.model.isEmpty();
+}
+
+QMap<QString, QString> DiskIdentify::toRecord(const DiskIdentifyInfo &info)
+{
+    // 型号、序列号、固件版本等标识字段都必须输出
+    QMap<QString, QString> record;
+    record.insert(DISK_KEY_INTERFACE, info.nvme ? "nvme" : "ata");
+    record.insert(DISK_KEY_MODEL, info.model);
+    record.insert(DISK_KEY_SERIAL, info.serial);
+    record.insert(DISK_KEY_FIRMWARE, info.firmware);
+    record.insert(DISK_KEY_CAPACITY, QString::number(info.capacity));
+    record.insert(DISK_KEY_CAPACITY_TEXT, info.capacity > 0 ? formatCapacity(info.capacity) : QString());
+    record.insert(DISK_KEY_SECTOR_SIZE, QString::number(info.sectorSize));
+    record.insert(DISK_KEY_ROTATION_RATE, QString::number(info.rotationRate));
+    record.insert(DISK_KEY_SATA_VERSION, info.sataVersion);
+    return record;
+}
+
+QString DiskIdentify::recordToText(const QMap<QString, QString> &record)
+{
+    QString text = QString("%1\n").arg(DISK_RECORD_MAGIC);
+    QMap<QString, QString>::const_iterator it = record.constBegin();
+    for (; it != record.constEnd(); ++it) {
+        // 值中的换行会破坏记录格式
+        QString value = it.value();
+        value.replace('\n', ' ');
+        text += QString("%1: %2\n").arg(it.key()).arg(value.trimmed());
+    }
+    return text;
+}
+
+QString DiskIdentify::formatCapacity(quint64 bytes)
+{
+    static const char *units[] = { "B", "kB", "MB", "GB", "TB", "PB", "EB" };
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1000.0 && unit < 6) {
+        value /= 1000.0;
+        ++unit;
+    }
+
+    // 保留三位有效数字
+    int precision = value < 10.0 ? 2 : (value < 100.0 ? 1 : 0);
+    if (0 == unit)
+        precision = 0;
+    return QString("%1 %2").arg(value, 0, 'f', precision).arg(units[unit]);
+}
+
+bool DiskIdentify::readAta(int fd, unsigned char command, unsigned char features, QByteArray &buf)
+{
+    // ATA PASS-THROUGH(16)，PIO Data-In，数据长度由sector count指定
+    unsigned char cdb[16];
+    memset(cdb, 0, sizeof(cdb));
+    cdb[0] = 0x85;
+    cdb[1] = 4 << 1;
+    cdb[2] = 0x0E;
+    cdb[4] = features;
+    cdb[6] = 1;
+    cdb[14] = command;
+
+    unsigned char sense[32];
+    memset(sense, 0, sizeof(sense));
+    buf.fill(0, ATA_IDENTIFY_SIZE);
+
+    sg_io_hdr_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.interface_id = 'S';
+    hdr.dxfer_direction = SG_DXFER_FROM_DEV;
+    hdr.cmd_len = sizeof(cdb);
+    hdr.cmdp = cdb;
+    hdr.mx_sb_len = sizeof(sense);
+    hdr.sbp = sense;
+    hdr.dxfer_len = ATA_IDENTIFY_SIZE;
+    hdr.dxferp = buf.data();
+    hdr.timeout = IO_TIMEOUT;
+
+    if (ioctl(fd, SG_IO, &hdr) < 0)
+        return false;
+    if (hdr.status != 0 || hdr.host_status != 0 || (hdr.driver_status & ~0x08) != 0)
+        return false;
+    return true;
+}
+
+bool DiskIdentify::readNvme(int fd, unsigned char opcode, unsigned int nsid, unsigned int cdw10, QByteArray &buf)
+{
+    buf.fill(0, NVME_IDENTIFY_SIZE);
+
+    struct nvme_admin_cmd cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.opcode = opcode;
+    cmd.nsid = nsid;
+    cmd.addr = reinterpret_cast<quint64>(buf.data());
+    cmd.data_len = NVME_IDENTIFY_SIZE;
+    cmd.cdw10 = cdw10;
+    cmd.timeout_ms = IO_TIMEOUT;
+
+    return 0 == ioctl(fd, NVME_IOCTL_ADMIN_CMD, &cmd);
+}
+
+QString DiskIdentify::ataString(const QByteArray &page, int firstWord, int lastWord)
+{
+    QByteArray str;
+    for (int i = firstWord; i <= lastWord; ++i) {
+        quint16 w = word(page, i);
+        str.append(static_cast<char>(w >> 8));
+        str.append(static_cast<char>(w & 0xFF));
+    }
+    return QString::fromLatin1(str).trimmed();
+}
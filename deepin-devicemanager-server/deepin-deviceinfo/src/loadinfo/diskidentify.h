@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DISKIDENTIFY_H
+#define DISKIDENTIFY_H
+
+#include <QString>
+#include <QByteArray>
+#include <QMap>
+
+#define ATA_IDENTIFY_SIZE   512     // ATA IDENTIFY DEVICE 数据大小
+#define NVME_IDENTIFY_SIZE  4096    // NVMe Identify Controller 数据大小
+
+// 硬盘标识记录：首行为 DISK_RECORD_MAGIC，之后每行一个 "key: value"，所有字段都会输出
+#define DISK_RECORD_MAGIC           "[disk-identify]"
+#define DISK_KEY_INTERFACE          "interface"         // ata 或 nvme
+#define DISK_KEY_MODEL              "model"             // 型号
+#define DISK_KEY_SERIAL             "serial"            // 序列号
+#define DISK_KEY_FIRMWARE           "firmware"          // 固件版本
+#define DISK_KEY_CAPACITY           "capacity"          // 容量(bytes)，0未知
+#define DISK_KEY_CAPACITY_TEXT      "capacity_text"     // 容量，如 1.00 TB
+#define DISK_KEY_SECTOR_SIZE        "sector_size"       // 逻辑扇区大小
+#define DISK_KEY_ROTATION_RATE      "rotation_rate"     // 转速：-1未知，1固态硬盘，其它为rpm
+#define DISK_KEY_SATA_VERSION       "sata_version"      // SATA版本及速度，NVMe为空
+
+/**
+ * @brief The DiskIdentifyInfo struct : 硬盘标识信息
+ */
+struct DiskIdentifyInfo {
+    DiskIdentifyInfo(): nvme(false), capacity(0), sectorSize(512), rotationRate(-1)
+    {}
+
+    bool    nvme;           //<! 是否为NVMe设备
+    QString model;          //<! 型号
+    QString serial;         //<! 序列号
+    QString firmware;       //<! 固件版本
+    QString sataVersion;    //<! SATA版本及速度，与smartctl格式一致
+    quint64 capacity;       //<! 容量(bytes)
+    int     sectorSize;     //<! 逻辑扇区大小
+    int     rotationRate;   //<! 转速：-1未知，1固态硬盘，其它为rpm
+};
+
+/**
+ * @brief The DiskIdentify class
+ * 通过SG_IO(ATA PASS-THROUGH)和NVMe admin ioctl直接读取硬盘标识信息，避免fork smartctl
+ */
+class DiskIdentify
+{
+public:
+    /**
+     * @brief readDevice : 读取 /dev/<name> 的标识信息
+     * @param name : 设备名称，如 sda nvme0n1
+     * @param info : 读取结果
+     * @return 是否读取成功，失败时需要使用smartctl
+     */
+    static bool readDevice(const QString &name, DiskIdentifyInfo &info);
+
+    /**
+     * @brief parseAtaIdentify : 解析 ATA IDENTIFY DEVICE 数据
+     * @param page : 512字节数据
+     * @param info : 解析结果
+     * @return 数据是否有效
+     */
+    static bool parseAtaIdentify(const QByteArray &page, DiskIdentifyInfo &info);
+
+    /**
+     * @brief parseNvmeIdentify : 解析 NVMe Identify Controller 数据
+     * @param page : 4096字节数据
+     * @param info : 解析结果
+     * @return 数据是否有效
+     */
+    static bool parseNvmeIdentify(const QByteArray &page, DiskIdentifyInfo &info);
+
+    /**
+     * @brief toRecord : 生成固定字段的硬盘标识记录，字段见 DISK_KEY_*
+     * @param info : 硬盘标识信息
+     * @return 字段 -> 值，所有字段都存在
+     */
+    static QMap<QString, QString> toRecord(const DiskIdentifyInfo &info);
+
+    /**
+     * @brief recordToText : 将记录序列化为缓存中的文本，前台按 DISK_RECORD_MAGIC 识别
+     * @param record : toRecord 生成的记录
+     * @return
+     */
+    static QString recordToText(const QMap<QString, QString> &record);
+
+    /**
+     * @brief formatCapacity : 与smartctl一致的容量格式，如 1.00 TB
+     * @param bytes : 容量
+     * @return
+     */
+    static QString formatCapacity(quint64 bytes);
+
+private:
+    /**
+     * @brief readAta : 通过SG_IO发送ATA命令
+     * @param fd : 设备文件描述符
+     * @param command : ATA命令
+     * @param features : features寄存器
+     * @param buf : 512字节数据
+     * @return
+     */
+    static bool readAta(int fd, unsigned char command, unsigned char features, QByteArray &buf);
+
+    /**
+     * @brief readNvme : 通过NVMe admin ioctl读取数据
+     * @param fd : 设备文件描述符
+     * @param opcode : admin命令
+     * @param nsid : namespace id
+     * @param cdw10 : command dword 10
+     * @param buf : 数据
+     * @return
+     */
+    static bool readNvme(int fd, unsigned char opcode, unsigned int nsid, unsigned int cdw10, QByteArray &buf);
+
+    /**
+     * @brief ataString : ATA字符串在每个word内字节交换
+     */
+    static QString ataString(const QByteArray &page, int firstWord, int lastWord);
+};
+
+#endif // DISKIDENTIFY_H
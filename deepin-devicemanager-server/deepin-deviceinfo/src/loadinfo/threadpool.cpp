@@ -13,10 +13,16 @@
 #include <QDateTime>
 #include <QLoggingCategory>
 
+#include <algorithm>
+
 using namespace DDLog;
 
 ThreadPool::ThreadPool(QObject *parent)
     : QThreadPool(parent)
+    , m_Pending(0)
+    , m_Batch(0)
+    , m_Deadline(COLLECT_DEADLINE)
+    , m_CmdTimeout(CMD_TIMEOUT)
 {
     qCDebug(appLog) << "Initializing ThreadPool";
     initCmd();
@@ -28,45 +34,217 @@ ThreadPool::ThreadPool(QObject *parent)
 void ThreadPool::loadDeviceInfo()
 {
     qCDebug(appLog) << "Loading device info, command count:" << m_ListCmd.size();
-    
+
     // 根据m_ListCmd生成所有设备信息
-    QList<Cmd>::iterator it = m_ListCmd.begin();
-    for (; it != m_ListCmd.end(); ++it) {
-        qCDebug(appLog) << "Starting task for cmd:" << (*it).cmd;
-        ThreadPoolTask *task = new ThreadPoolTask((*it).cmd, (*it).file, (*it).canNotReplace, (*it).waitingTime);
-        task->setAutoDelete(true);
-        start(task);
+    runCmdList(m_ListCmd);
+}
+
+void ThreadPool::updateDeviceInfo()
+{
+    qCDebug(appLog) << "Updating device info, command count:" << m_ListUpdate.size();
+
+    // 根据m_ListUpdate更新设备信息
+    runCmdList(m_ListUpdate);
+}
+
+void ThreadPool::updateDeviceInfo(const QStringList &keys, const QStringList &disks)
+{
+    QList<Cmd> lstCmd;
+    foreach (const Cmd &cmd, m_ListUpdate) {
+        if (keys.contains(cmd.name()))
+            lstCmd.append(cmd);
     }
 
-    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
-    // 这里是为了确保其它设备在最后一个生成
-    qint64 beginMSecond = QDateTime::currentMSecsSinceEpoch();
-    while (true) {
-        qint64 curMSecond = QDateTime::currentMSecsSinceEpoch();
-        if (activeThreadCount() == 0 || curMSecond - beginMSecond > 10000) {
+    // 只读取变化的硬盘，不重新读取所有硬盘
+    if (!disks.isEmpty()) {
+        Cmd cmdDisks;
+        cmdDisks.cmd = QString("%1 %2").arg(CMD_SMARTCTL_DISKS).arg(disks.join(" "));
+        cmdDisks.file = "smartctl_disks.txt";
+        cmdDisks.cost = 1500;
+        lstCmd.append(cmdDisks);
+    }
+    qCDebug(appLog) << "Updating device info, keys:" << keys << "disks:" << disks << "command count:" << lstCmd.size();
+
+    // 依赖不在列表中的节点直接使用缓存中的信息
+    runCmdList(lstCmd);
+}
+
+void ThreadPool::setDeadline(int msec)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Deadline = msec;
+}
+
+void ThreadPool::setCmdTimeout(int msec)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_CmdTimeout = msec;
+}
+
+QMap<QString, int> ThreadPool::collectStatus()
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_MapStatus;
+}
+
+void ThreadPool::runCmdList(const QList<Cmd> &lstCmd)
+{
+    QMutexLocker locker(&m_Mutex);
+    int batch = ++m_Batch;
+    m_Pending = lstCmd.size();
+    m_MapStatus.clear();
+    m_MapNode.clear();
+    m_MapChildren.clear();
+    m_MapRemainDeps.clear();
+    m_MapRank.clear();
+    m_MapWallTime.clear();
+    m_MapFinishTime.clear();
+
+    // 1. 建立依赖图，不在本次列表中的依赖忽略
+    foreach (const Cmd &cmd, lstCmd)
+        m_MapNode.insert(cmd.name(), cmd);
+    foreach (const Cmd &cmd, lstCmd) {
+        int remain = 0;
+        foreach (const QString &dep, cmd.deps) {
+            if (!m_MapNode.contains(dep))
+                continue;
+            m_MapChildren[dep].append(cmd.name());
+            ++remain;
+        }
+        m_MapRemainDeps.insert(cmd.name(), remain);
+        m_MapStatus.insert(cmd.name(), ThreadPoolTask::TS_Running);
+    }
+
+    // 2. 先启动没有依赖的节点，关键路径越长越先执行
+    QStringList roots;
+    foreach (const Cmd &cmd, lstCmd) {
+        if (0 == m_MapRemainDeps[cmd.name()]) {
+            nodeRank(cmd.name());
+            roots.append(cmd.name());
+        }
+    }
+    std::stable_sort(roots.begin(), roots.end(), [this](const QString &left, const QString &right) {
+        return m_MapRank[left] > m_MapRank[right];
+    });
+    m_Timer.start();
+    foreach (const QString &root, roots)
+        startNode(batch, root);
+
+    // 3. 等待所有任务结束，等待期间不占用CPU；超过全局超时时间则不再等待
+    while (m_Pending > 0) {
+        qint64 remain = m_Deadline - m_Timer.elapsed();
+        if (remain <= 0 || !m_Condition.wait(&m_Mutex, static_cast<unsigned long>(remain)))
+            break;
+    }
+
+    QStringList finishedList, timedOutList, failedList, runningList;
+    QMap<QString, int>::const_iterator itStatus = m_MapStatus.constBegin();
+    for (; itStatus != m_MapStatus.constEnd(); ++itStatus) {
+        switch (itStatus.value()) {
+        case ThreadPoolTask::TS_Finished:
+        case ThreadPoolTask::TS_Skipped:
+            finishedList.append(itStatus.key());
+            break;
+        case ThreadPoolTask::TS_TimedOut:
+            timedOutList.append(itStatus.key());
+            break;
+        case ThreadPoolTask::TS_Failed:
+            failedList.append(itStatus.key());
+            break;
+        default:
+            runningList.append(itStatus.key());
             break;
         }
     }
+    qCInfo(appLog) << "Collect finished in" << m_Timer.elapsed() << "ms, finished:" << finishedList.size()
+                   << "timed out:" << timedOutList << "failed:" << failedList << "unfinished:" << runningList;
+
+    QStringList pathInfo;
+    foreach (const QString &name, criticalPath())
+        pathInfo.append(QString("%1(%2ms)").arg(name).arg(m_MapWallTime.value(name)));
+    qCInfo(appLog) << "Collect critical path:" << pathInfo.join(" -> ");
 }
 
-void ThreadPool::updateDeviceInfo()
+void ThreadPool::startNode(int batch, const QString &name)
 {
-    // 根据m_ListCmd生成所有设备信息
-    QList<Cmd>::iterator it = m_ListUpdate.begin();
-    for (; it != m_ListUpdate.end(); ++it) {
-        ThreadPoolTask *task = new ThreadPoolTask((*it).cmd, (*it).file, (*it).canNotReplace, (*it).waitingTime);
-        task->setAutoDelete(true);
-        start(task);
+    const Cmd &cmd = m_MapNode[name];
+    qCDebug(appLog) << "Starting task for cmd:" << cmd.cmd << "rank:" << m_MapRank.value(name);
+    int waiting = cmd.waitingTime > 0 ? cmd.waitingTime : m_CmdTimeout;
+    ThreadPoolTask *task = new ThreadPoolTask(cmd.cmd, cmd.file, cmd.canNotReplace, waiting);
+    // 依赖节点启动较晚，命令的超时时间不能超过本批次剩余的时间
+    task->setDeadline(QDateTime::currentMSecsSinceEpoch() + qMax<qint64>(0, m_Deadline - m_Timer.elapsed()));
+    // 任务在工作线程中直接回调，不依赖本线程的事件循环
+    connect(task, &ThreadPoolTask::finished, this, [this, batch, name](const QString &, int status, qint64 elapsed) {
+        onTaskFinished(batch, name, status, elapsed);
+    }, Qt::DirectConnection);
+    task->setAutoDelete(true);
+    start(task, nodeRank(name));
+}
+
+int ThreadPool::nodeRank(const QString &name)
+{
+    if (m_MapRank.contains(name))
+        return m_MapRank[name];
+
+    // 先记录自身代价，防止依赖配置成环时无限递归
+    int cost = m_MapNode[name].cost;
+    m_MapRank.insert(name, cost);
+
+    int maxChild = 0;
+    foreach (const QString &child, m_MapChildren.value(name))
+        maxChild = qMax(maxChild, nodeRank(child));
+    m_MapRank.insert(name, cost + maxChild);
+    return cost + maxChild;
+}
+
+QStringList ThreadPool::criticalPath()
+{
+    // 从最后结束的节点开始，沿最晚结束的依赖回溯
+    QString cur;
+    qint64 last = -1;
+    QMap<QString, qint64>::const_iterator it = m_MapFinishTime.constBegin();
+    for (; it != m_MapFinishTime.constEnd(); ++it) {
+        if (it.value() > last) {
+            last = it.value();
+            cur = it.key();
+        }
     }
-    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
-    // 这里是为了确保其它设备在最后一个生成
-    qint64 beginMSecond = QDateTime::currentMSecsSinceEpoch();
-    while (true) {
-        qint64 curMSecond = QDateTime::currentMSecsSinceEpoch();
-        if (activeThreadCount() == 0 || curMSecond - beginMSecond > 10000) {
-            break;
+
+    QStringList path;
+    while (!cur.isEmpty() && !path.contains(cur)) {
+        path.prepend(cur);
+        QString prev;
+        last = -1;
+        foreach (const QString &dep, m_MapNode[cur].deps) {
+            if (m_MapFinishTime.contains(dep) && m_MapFinishTime[dep] > last) {
+                last = m_MapFinishTime[dep];
+                prev = dep;
+            }
         }
+        cur = prev;
+    }
+    return path;
+}
+
+void ThreadPool::onTaskFinished(int batch, const QString &name, int status, qint64 elapsed)
+{
+    QMutexLocker locker(&m_Mutex);
+    // 上一批次超时后才结束的任务不计入当前批次
+    if (batch != m_Batch)
+        return;
+
+    m_MapStatus.insert(name, status);
+    m_MapWallTime.insert(name, elapsed);
+    m_MapFinishTime.insert(name, m_Timer.elapsed());
+
+    // 依赖全部完成的节点立即启动
+    foreach (const QString &child, m_MapChildren.value(name)) {
+        if (--m_MapRemainDeps[child] == 0)
+            startNode(batch, child);
     }
+
+    if (--m_Pending <= 0)
+        m_Condition.wakeAll();
 }
 
 void ThreadPool::runCmdToCache(const Cmd &cmd)
@@ -104,6 +282,7 @@ void ThreadPool::initCmd()
     cmdLshw.cmd = QString("%1 %2%3").arg("lshw > ").arg(PATH).arg("lshw.txt");
     cmdLshw.file = "lshw.txt";
     cmdLshw.canNotReplace = false;
+    cmdLshw.cost = 3000;
     m_ListCmd.append(cmdLshw);
     m_ListUpdate.append(cmdLshw);
 
@@ -112,6 +291,7 @@ void ThreadPool::initCmd()
     cmdDmiSPN.cmd = QString("%1 %2%3").arg("dmidecode -s system-product-name > ").arg(PATH).arg("dmidecode_spn.txt");
     cmdDmiSPN.file = "dmidecode_spn.txt";
     cmdDmiSPN.canNotReplace = true;
+    cmdDmiSPN.cost = 50;
     m_ListCmd.append(cmdDmiSPN);
 
     // 添加dmidecode -t 0命令
@@ -119,6 +299,7 @@ void ThreadPool::initCmd()
     cmdDmi0.cmd = QString("%1 %2%3").arg("dmidecode -t 0 > ").arg(PATH).arg("dmidecode_0.txt");
     cmdDmi0.file = "dmidecode_0.txt";
     cmdDmi0.canNotReplace = true;
+    cmdDmi0.cost = 50;
     m_ListCmd.append(cmdDmi0);
 
     // 添加dmidecode -t 1命令
@@ -126,6 +307,7 @@ void ThreadPool::initCmd()
     cmdDmi1.cmd = QString("%1 %2%3").arg("dmidecode -t 1 > ").arg(PATH).arg("dmidecode_1.txt");
     cmdDmi1.file = "dmidecode_1.txt";
     cmdDmi1.canNotReplace = true;
+    cmdDmi1.cost = 50;
     m_ListCmd.append(cmdDmi1);
 
     // 添加dmidecode -t 2命令
@@ -133,6 +315,7 @@ void ThreadPool::initCmd()
     cmdDmi2.cmd = QString("%1 %2%3").arg("dmidecode -t 2 > ").arg(PATH).arg("dmidecode_2.txt");
     cmdDmi2.file = "dmidecode_2.txt";
     cmdDmi2.canNotReplace = true;
+    cmdDmi2.cost = 50;
     m_ListCmd.append(cmdDmi2);
 
     // 添加dmidecode -t 3命令
@@ -140,6 +323,7 @@ void ThreadPool::initCmd()
     cmdDmi3.cmd = QString("%1 %2%3").arg("dmidecode -t 3 > ").arg(PATH).arg("dmidecode_3.txt");
     cmdDmi3.file = "dmidecode_3.txt";
     cmdDmi3.canNotReplace = true;
+    cmdDmi3.cost = 50;
     m_ListCmd.append(cmdDmi3);
 
     // 添加dmidecode -t 4命令
@@ -147,6 +331,7 @@ void ThreadPool::initCmd()
     cmdDmi4.cmd = QString("%1 %2%3").arg("dmidecode -t 4 > ").arg(PATH).arg("dmidecode_4.txt");
     cmdDmi4.file = "dmidecode_4.txt";
     cmdDmi4.canNotReplace = true;
+    cmdDmi4.cost = 50;
     m_ListCmd.append(cmdDmi4);
 
     // 添加dmidecode -t 13命令
@@ -154,6 +339,7 @@ void ThreadPool::initCmd()
     cmdDmi13.cmd = QString("%1 %2%3").arg("dmidecode -t 13 > ").arg(PATH).arg("dmidecode_13.txt");
     cmdDmi13.file = "dmidecode_13.txt";
     cmdDmi13.canNotReplace = true;
+    cmdDmi13.cost = 50;
     m_ListCmd.append(cmdDmi13);
 
     // 添加dmidecode -t 16命令
@@ -161,6 +347,7 @@ void ThreadPool::initCmd()
     cmdDmi16.cmd = QString("%1 %2%3").arg("dmidecode -t 16 > ").arg(PATH).arg("dmidecode_16.txt");
     cmdDmi16.file = "dmidecode_16.txt";
     cmdDmi16.canNotReplace = true;
+    cmdDmi16.cost = 50;
     m_ListCmd.append(cmdDmi16);
 
     // 添加dmidecode -t 17命令
@@ -168,6 +355,7 @@ void ThreadPool::initCmd()
     cmdDmi17.cmd = QString("%1 %2%3").arg("dmidecode -t 17 > ").arg(PATH).arg("dmidecode_17.txt");
     cmdDmi17.file = "dmidecode_17.txt";
     cmdDmi17.canNotReplace = true;
+    cmdDmi17.cost = 50;
     m_ListCmd.append(cmdDmi17);
 
     // 添加hwinfo --power命令
@@ -175,6 +363,7 @@ void ThreadPool::initCmd()
     cmdUpower.cmd = QString("%1 %2%3").arg("upower --dump > ").arg(PATH).arg("upower_dump.txt");
     cmdUpower.file = "upower_dump.txt";
     cmdUpower.canNotReplace = true;
+    cmdUpower.cost = 300;
     m_ListCmd.append(cmdUpower);
     m_ListUpdate.append(cmdUpower);
 
@@ -183,6 +372,7 @@ void ThreadPool::initCmd()
     cmdLscpu.cmd = "lscpu";//QString("%1 %2%3").arg("lscpu > ").arg(PATH).arg("lscpu.txt");
     cmdLscpu.file = "lscpu.txt";
     cmdLscpu.canNotReplace = true;
+    cmdLscpu.cost = 50;
     m_ListCmd.append(cmdLscpu);
     m_ListUpdate.append(cmdLscpu);
 
@@ -191,6 +381,7 @@ void ThreadPool::initCmd()
     cmdLsblk.cmd = QString("%1 %2%3").arg("lsblk -d -o name,rota > ").arg(PATH).arg("lsblk_d.txt");
     cmdLsblk.file = "lsblk_d.txt";
     cmdLsblk.canNotReplace = false;
+    cmdLsblk.cost = 20;
     m_ListCmd.append(cmdLsblk);
     m_ListUpdate.append(cmdLsblk);
 
@@ -199,6 +390,7 @@ void ThreadPool::initCmd()
     cmdLssg.cmd = QString("%1 %2%3").arg("ls /dev/sg* > ").arg(PATH).arg("ls_sg.txt");
     cmdLssg.file = "ls_sg.txt";
     cmdLssg.canNotReplace = false;
+    cmdLssg.cost = 10;
     m_ListCmd.append(cmdLssg);
     m_ListUpdate.append(cmdLssg);
 
@@ -207,6 +399,7 @@ void ThreadPool::initCmd()
     cmdLspci.cmd = QString("%1 %2%3").arg("lspci > ").arg(PATH).arg("lspci.txt");
     cmdLspci.file = "lspci.txt";
     cmdLspci.canNotReplace = false;
+    cmdLspci.cost = 50;
     m_ListCmd.append(cmdLspci);
     m_ListUpdate.append(cmdLspci);
 
@@ -215,6 +408,7 @@ void ThreadPool::initCmd()
     cmdLpstate.cmd = QString("%1 %2%3").arg("lpstat -a > ").arg(PATH).arg("lpstat.txt");
     cmdLpstate.file = "lpstat.txt";
     cmdLpstate.canNotReplace = false;
+    cmdLpstate.cost = 100;
     m_ListCmd.append(cmdLpstate);
     m_ListUpdate.append(cmdLpstate);
 
@@ -223,6 +417,7 @@ void ThreadPool::initCmd()
     cmdDmesg.cmd = QString("%1 %2%3").arg("dmesg > ").arg(PATH).arg("dmesg.txt");
     cmdDmesg.file = "dmesg.txt";
     cmdDmesg.canNotReplace = true;
+    cmdDmesg.cost = 100;
     m_ListCmd.append(cmdDmesg);
     m_ListUpdate.append(cmdDmesg);
 
@@ -231,6 +426,7 @@ void ThreadPool::initCmd()
     cmdHciconfig.cmd = QString("%1 %2%3").arg("hciconfig -a > ").arg(PATH).arg("hciconfig.txt");
     cmdHciconfig.file = "hciconfig.txt";
     cmdHciconfig.canNotReplace = false;
+    cmdHciconfig.cost = 50;
     m_ListCmd.append(cmdHciconfig);
     m_ListUpdate.append(cmdHciconfig);
 
@@ -239,6 +435,7 @@ void ThreadPool::initCmd()
     cmdBluetooth.cmd = QString("%1 %2%3").arg("bluetoothctl paired-devices > ").arg(PATH).arg("bt_device.txt");
     cmdBluetooth.file = "bt_device.txt";
     cmdBluetooth.canNotReplace = false;
+    cmdBluetooth.cost = 500;
     cmdBluetooth.waitingTime = 500;
     m_ListCmd.append(cmdBluetooth);
     m_ListUpdate.append(cmdBluetooth);
@@ -248,12 +445,14 @@ void ThreadPool::initCmd()
     cmdLsMod.cmd = QString("%1 %2%3").arg("cat /boot/config* | grep '=y' > ").arg(PATH).arg("dr_config.txt");
     cmdLsMod.file = "dr_config.txt";
     cmdLsMod.canNotReplace = true;
+    cmdLsMod.cost = 100;
     m_ListCmd.append(cmdLsMod);
 
     Cmd cmdHwinfo;     //同步"hwinfo --network"改为 "hwinfo --netcard"获取网卡信息
     cmdHwinfo.cmd = QString("%1 %2%3").arg("hwinfo --sound --netcard --keyboard --cdrom --disk --display --mouse --usb --fingerprint > ").arg(PATH).arg("hwinfo.txt");
     cmdHwinfo.file = "hwinfo.txt";
     cmdHwinfo.canNotReplace = false;
+    cmdHwinfo.cost = 2500;
     m_ListCmd.append(cmdHwinfo);
     m_ListUpdate.append(cmdHwinfo);
 
@@ -261,6 +460,38 @@ void ThreadPool::initCmd()
     cmdHwinfoMonitor.cmd = QString("%1 %2%3").arg("hwinfo --framebuffer --monitor > ").arg(PATH).arg("hwinfo_monitor.txt");
     cmdHwinfoMonitor.file = "hwinfo_monitor.txt";
     cmdHwinfoMonitor.canNotReplace = false;
+    cmdHwinfoMonitor.cost = 800;
     m_ListCmd.append(cmdHwinfoMonitor);
     m_ListUpdate.append(cmdHwinfoMonitor);
+
+    // 以下节点依赖其它命令的输出，由线程池在依赖完成后调度
+    // smartctl --all /dev/*** 依赖 lsblk -d -o name,rota
+    Cmd cmdSmartctl;
+    cmdSmartctl.cmd = CMD_SMARTCTL_LSBLK;
+    cmdSmartctl.file = "smartctl_lsblk.txt";
+    cmdSmartctl.canNotReplace = false;
+    cmdSmartctl.cost = 1500;
+    cmdSmartctl.deps << cmdLsblk.name();
+    m_ListCmd.append(cmdSmartctl);
+    m_ListUpdate.append(cmdSmartctl);
+
+    // smartctl --all /dev/sg* 依赖 ls /dev/sg*
+    Cmd cmdSgSmartctl;
+    cmdSgSmartctl.cmd = CMD_SMARTCTL_SG;
+    cmdSgSmartctl.file = "smartctl_sg.txt";
+    cmdSgSmartctl.canNotReplace = false;
+    cmdSgSmartctl.cost = 1000;
+    cmdSgSmartctl.deps << cmdLssg.name();
+    m_ListCmd.append(cmdSgSmartctl);
+    m_ListUpdate.append(cmdSgSmartctl);
+
+    // lspci -v -s *** 依赖 lspci
+    Cmd cmdLspciVs;
+    cmdLspciVs.cmd = CMD_LSPCI_VS;
+    cmdLspciVs.file = "lspci_vs.txt";
+    cmdLspciVs.canNotReplace = false;
+    cmdLspciVs.cost = 50;
+    cmdLspciVs.deps << cmdLspci.name();
+    m_ListCmd.append(cmdLspciVs);
+    m_ListUpdate.append(cmdLspciVs);
 }
@@ -9,18 +9,36 @@
 #include <QThreadPool>
 #include <QList>
 #include <QVector>
+#include <QMap>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QStringList>
+
+#define COLLECT_DEADLINE    30000   // 一次信息采集的全局超时时间(ms)
+#define CMD_TIMEOUT         20000   // 单个命令默认的超时时间(ms)
 
 /**
  * @brief The Cmd struct
  */
 struct Cmd {
-    Cmd(): cmd(""), file(""), canNotReplace(false), waitingTime(-1)
+    Cmd(): cmd(""), file("")
     {}
 
+    /**
+     * @brief name : the node name of the collection graph, same as the cache key
+     */
+    QString name() const
+    {
+        return QString(file).replace(".txt", "");
+    }
+
     QString cmd;         //<! the cmd
     QString file;        //<! the file
-    bool canNotReplace;  //<! mark can replace or not
-    int waitingTime;     //<! waiting time
+    bool canNotReplace = false;  //<! mark can replace or not
+    int waitingTime = -1;        //<! waiting time, -1 means using the default command timeout
+    int cost = 1;                //<! estimated cost(ms), used to run the critical path first
+    QStringList deps;    //<! nodes which must be finished before this one
 };
 
 /**
@@ -42,7 +60,67 @@ public:
      */
     void updateDeviceInfo();
 
+    /**
+     * @brief updateDeviceInfo : 只更新指定的信息，其它缓存信息保持不变
+     * @param keys : 需要更新的节点名称(缓存关键字)
+     * @param disks : 需要重新读取SMART信息的硬盘，如 sdb
+     */
+    void updateDeviceInfo(const QStringList &keys, const QStringList &disks = QStringList());
+
+    /**
+     * @brief setDeadline : 设置一次采集的全局超时时间
+     * @param msec : 毫秒
+     */
+    void setDeadline(int msec);
+
+    /**
+     * @brief setCmdTimeout : 设置单个命令默认的超时时间
+     * @param msec : 毫秒
+     */
+    void setCmdTimeout(int msec);
+
+    /**
+     * @brief collectStatus : 最近一次采集中每个命令的执行结果
+     * @return file -> ThreadPoolTask::TaskStatus
+     */
+    QMap<QString, int> collectStatus();
+
 private:
+    /**
+     * @brief runCmdList : 按依赖关系执行命令列表，并阻塞等待所有任务结束或全局超时
+     * @param lstCmd : 命令列表
+     */
+    void runCmdList(const QList<Cmd> &lstCmd);
+
+    /**
+     * @brief startNode : 启动一个依赖已满足的节点，调用时需持有m_Mutex
+     * @param batch : 任务所属批次
+     * @param name : 节点名称
+     */
+    void startNode(int batch, const QString &name);
+
+    /**
+     * @brief nodeRank : 从该节点到终点的最长路径代价，代价越大越先执行
+     * @param name : 节点名称
+     * @return
+     */
+    int nodeRank(const QString &name);
+
+    /**
+     * @brief criticalPath : 根据实际结束时间回溯本批次的关键路径
+     * @return 节点列表，从起点到终点
+     */
+    QStringList criticalPath();
+
+    /**
+     * @brief onTaskFinished : 任务结束时在工作线程中调用
+     * @param batch : 任务所属批次
+     * @param name : 节点名称
+     * @param status : ThreadPoolTask::TaskStatus
+     * @param elapsed : 任务耗时
+     */
+    void onTaskFinished(int batch, const QString &name, int status, qint64 elapsed);
+
     /**
      * @brief runCmdToCache
      * @param cmd
@@ -57,6 +135,21 @@ private:
 private:
     QList<Cmd>        m_ListCmd;             // all cmd
     QList<Cmd>        m_ListUpdate;          // update cmd
+
+    QMutex            m_Mutex;               // 保护以下采集状态
+    QWaitCondition    m_Condition;           // 任务结束时唤醒等待的线程
+    QMap<QString, int> m_MapStatus;          // 当前批次每个命令的执行结果
+    QMap<QString, Cmd> m_MapNode;            // 当前批次的节点
+    QMap<QString, QStringList> m_MapChildren;// 节点 -> 依赖它的节点
+    QMap<QString, int> m_MapRemainDeps;      // 节点 -> 未完成的依赖数
+    QMap<QString, int> m_MapRank;            // 节点 -> 到终点的最长路径代价
+    QMap<QString, qint64> m_MapWallTime;     // 节点 -> 执行耗时
+    QMap<QString, qint64> m_MapFinishTime;   // 节点 -> 相对批次开始的结束时间
+    QElapsedTimer     m_Timer;               // 批次计时
+    int               m_Pending;             // 当前批次未结束的任务数
+    int               m_Batch;               // 当前批次，用于忽略超时后才结束的旧任务
+    int               m_Deadline;            // 全局超时时间
+    int               m_CmdTimeout;          // 单个命令默认超时时间
 };
 
 #endif // THREADPOOL_H
@@ -5,23 +5,29 @@
 #include "threadpooltask.h"
 #include "deviceinfomanager.h"
 #include "cpu/cpuinfo.h"
+#include "diskidentify.h"
 #include "DDLog.h"
 using namespace DDLog;
 
 #include <QTime>
+#include <QElapsedTimer>
+#include <QDateTime>
 #include <QProcess>
 #include <QFile>
 #include <QLoggingCategory>
 #include <QDir>
 #include <unistd.h>
 #include <QRegularExpression>
+#include <QThreadPool>
+#include <QThread>
 
 ThreadPoolTask::ThreadPoolTask(QString cmd, QString file, bool replace, int waiting, QObject *parent)
     : QObject(parent),
       m_Cmd(cmd),
       m_File(file),
       m_CanNotReplace(replace),
-      m_Waiting(waiting)
+      m_Waiting(waiting),
+      m_Deadline(0)
 {
     qCDebug(appLog) << "Creating ThreadPoolTask for cmd:" << cmd << "output file:" << file;
 }
@@ -34,13 +40,50 @@ ThreadPoolTask::~ThreadPoolTask()
 void ThreadPoolTask::run()
 {
     qCDebug(appLog) << "Running task for cmd:" << m_Cmd;
+    QElapsedTimer timer;
+    timer.start();
+    TaskStatus status = TS_Finished;
     if (m_Cmd == "lscpu") {
         qCDebug(appLog) << "Loading CPU info";
         loadCpuInfo();
-        return;
+    } else if (m_Cmd == CMD_SMARTCTL_LSBLK) {
+        // 依赖 lsblk_d 节点，执行 smartctl --all /dev/*** 命令
+        loadSmartCtlInfoToCache(QString(DeviceInfoManager::getInstance()->getStagedInfo("lsblk_d")));
+    } else if (m_Cmd == CMD_SMARTCTL_SG) {
+        // 依赖 ls_sg 节点，执行 smartctl --all /dev/sg* 命令
+        loadSgSmartCtlInfoToCache(QString(DeviceInfoManager::getInstance()->getStagedInfo("ls_sg")));
+    } else if (m_Cmd.startsWith(CMD_SMARTCTL_DISKS " ")) {
+        // 热插拔时只读取插入的硬盘
+        QStringList names;
+        foreach (const QString &name, m_Cmd.mid(QString(CMD_SMARTCTL_DISKS).size()).split(" ")) {
+            if (!name.isEmpty())
+                names.append(name);
+        }
+        runSmartCtlTasks(names, true);
+    } else if (m_Cmd == CMD_LSPCI_VS) {
+        // 依赖 lspci 节点，执行 lspci -v -s %1 命令
+        loadLspciVSInfoToCache(QString(DeviceInfoManager::getInstance()->getStagedInfo("lspci")));
+    } else {
+        status = runCmdToCache(m_Cmd);
     }
-    runCmdToCache(m_Cmd);
-    qCDebug(appLog) << "Finished running task for cmd:" << m_Cmd;
+    qCDebug(appLog) << "Finished running task for cmd:" << m_Cmd << "status:" << status << "elapsed:" << timer.elapsed();
+    emit finished(m_File, status, timer.elapsed());
+}
+
+void ThreadPoolTask::setDeadline(qint64 msecsSinceEpoch)
+{
+    m_Deadline = msecsSinceEpoch;
+}
+
+int ThreadPoolTask::remainingTime() const
+{
+    if (m_Deadline <= 0)
+        return m_Waiting;
+
+    qint64 remain = qMax<qint64>(0, m_Deadline - QDateTime::currentMSecsSinceEpoch());
+    if (m_Waiting < 0 || remain < m_Waiting)
+        return static_cast<int>(remain);
+    return m_Waiting;
 }
 
 void ThreadPoolTask::runCmd(const QString &cmd)
@@ -68,7 +111,7 @@ void ThreadPoolTask::runCmd(const QString &cmd)
     }
 }
 
-void ThreadPoolTask::runCmd(const QString &cmd, QString &info)
+ThreadPoolTask::TaskStatus ThreadPoolTask::runCmd(const QString &cmd, QString &info)
 {
     QString cmdExec = cmd.left(cmd.indexOf('>')).trimmed();
     QString cmdStr = cmdExec.split(' ').first().trimmed();
@@ -77,19 +120,19 @@ void ThreadPoolTask::runCmd(const QString &cmd, QString &info)
     if (!cmdArg.isEmpty())
         args = cmdArg.split(' ');
     if (cmdStr.isEmpty())
-        return;
+        return TS_Failed;
 
     // 处理包含*的命令参数
     if (cmd.startsWith("ls /dev/sg*")) {
         info = runAsteriskCmd(cmdStr, args.first().trimmed());
-        return;
+        return TS_Finished;
     } else if (cmdExec.startsWith("cat /boot/config*")) {
         QString filter = cmdExec.split('|').last().split(' ').last().replace('\'', "");
         if (filter.isEmpty())
-            return;
+            return TS_Failed;
         QString outPut = runAsteriskCmd("ls", "/boot/config*");
         if (outPut.isEmpty())
-            return;
+            return TS_Finished;
         QStringList paths = outPut.split('\n');
         QStringList results;
         for (auto path : paths) {
@@ -113,20 +156,35 @@ void ThreadPoolTask::runCmd(const QString &cmd, QString &info)
         if (!results.isEmpty())
             info = results.join('\n');
         //qCInfo(deviceInfoLog) << "runcmdExec:" << cmdExec << "args:" << args << "outPut:" << info;
-        return;
+        return TS_Finished;
     }
 
-    qCDebug(appLog) << "Executing command with output capture:" << cmdStr;
+    // 已到达本批次的截止时间，不再启动新的进程
+    int timeout = remainingTime();
+    if (0 == timeout) {
+        qCWarning(appLog) << "Collect deadline reached, skip command:" << cmdStr << args;
+        return TS_TimedOut;
+    }
+
+    qCDebug(appLog) << "Executing command with output capture:" << cmdStr << "timeout:" << timeout;
     QProcess process;
     process.start(cmdStr, args);
-    if (!process.waitForFinished(m_Waiting)) {
-        qCWarning(appLog) << "Command execution timed out:" << cmdStr;
-        return;
+    if (!process.waitForFinished(timeout)) {
+        // 进程仍在运行说明已超时，需要强制结束，避免占用线程池
+        if (process.state() != QProcess::NotRunning) {
+            qCWarning(appLog) << "Command execution timed out:" << cmdStr << "timeout:" << timeout;
+            process.kill();
+            process.waitForFinished(1000);
+            return TS_TimedOut;
+        }
+        qCWarning(appLog) << "Command execution failed:" << cmdStr << process.errorString();
+        return TS_Failed;
     }
     info = process.readAllStandardOutput();
     qCDebug(appLog) << "Command output length:" << info.length();
 
     //qCInfo(deviceInfoLog) << "runcmdExec:" << cmdExec << "args:" << args << "outPut:" << info;
+    return QProcess::NormalExit == process.exitStatus() ? TS_Finished : TS_Failed;
 }
 
 QString ThreadPoolTask::runAsteriskCmd(const QString &cmd, const QString &arg)
@@ -166,7 +224,7 @@ QString ThreadPoolTask::runAsteriskCmd(const QString &cmd, const QString &arg)
     return info;
 }
 
-void ThreadPoolTask::runCmdToCache(const QString &cmd)
+ThreadPoolTask::TaskStatus ThreadPoolTask::runCmdToCache(const QString &cmd)
 {
     QString key = m_File;
     key.replace(".txt", "");
@@ -174,37 +232,47 @@ void ThreadPoolTask::runCmdToCache(const QString &cmd)
 
     // 1. 先判断通过该命令获取的信息是不是需要刷新的,如果是cpu，内存条，主板等信息则只需要开机获取即可
     if (m_CanNotReplace && existed) {
-        return;
+        return TS_Skipped;
     }
 
     // 2. 执行命令获取设备信息
     QString info;
-    runCmd(cmd, info);
-    // 3. 管理设备信息
-    // 如果命令是 lsblk  , 则需要执行 smartctl --all /dev/***命令
-    if (m_File == "lsblk_d.txt") {
-        loadSmartCtlInfoToCache(info);
-    }
+    TaskStatus status = runCmd(cmd, info);
 
-    // 如果命令是 ls /dev/sg* ,则需要执行 smartctl --all /dev/*** 命令
-    if (m_File == "ls_sg.txt") {
-        loadSgSmartCtlInfoToCache(info);
-    }
+    // 3. 管理设备信息
+    // smartctl, lspci -v -s 等后续命令作为依赖该节点的独立节点由线程池调度
+    DeviceInfoManager::getInstance()->addInfo(key, info);
+    return status;
+}
 
-    // 如果命令是 lspci  , 则需要执行 lspci -v -s %1 > lspci_vs.txt 命令
-    if (m_File == "lspci.txt") {
-        loadLspciVSInfoToCache(info);
+/**
+ * @brief The SmartCtlTask class : 单个硬盘的smartctl任务
+ */
+class SmartCtlTask : public QRunnable
+{
+public:
+    SmartCtlTask(ThreadPoolTask *parent, const QString &name, bool retryPartition)
+        : mp_Parent(parent)
+        , m_Name(name)
+        , m_RetryPartition(retryPartition)
+    {
     }
 
-    if ("hwinfo_display.txt" == m_File) {
-        loadDisplayWidth(info);
+protected:
+    void run() override
+    {
+        mp_Parent->loadSmartCtlDevice(m_Name, m_RetryPartition);
     }
 
-    DeviceInfoManager::getInstance()->addInfo(key, info);
-}
+private:
+    ThreadPoolTask *mp_Parent;
+    QString         m_Name;
+    bool            m_RetryPartition;
+};
 
 void ThreadPoolTask::loadSmartCtlInfoToCache(const QString &info)
 {
+    QStringList names;
     QStringList lines = info.split("\n");
     foreach (QString line, lines) {
         QStringList words = line.replace(QRegularExpression("[\\s]+"), " ").split(" ");
@@ -212,17 +280,55 @@ void ThreadPoolTask::loadSmartCtlInfoToCache(const QString &info)
         if (words.size() != 2 || words[0] == "NAME") {
             continue;
         }
+        names.append(words[0].trimmed());
+    }
+
+    runSmartCtlTasks(names, true);
+}
 
-        QString smartCmd = QString("smartctl --all /dev/%1").arg(words[0].trimmed());
-        QString sInfo;
-        runCmd(smartCmd, sInfo);
-        // 在使用smartctl的时候会出现对 /dev/sda 出现判断错误的情况，此时可以对/dev/sda1进行处理
-        if (sInfo.contains("Read Device Identity failed:")) {
+void ThreadPoolTask::loadSmartCtlDevice(const QString &name, bool retryPartition)
+{
+    // 优先通过ioctl直接读取，USB/SAS桥接等不支持的设备再使用smartctl
+    DiskIdentifyInfo identify;
+    if (DiskIdentify::readDevice(name, identify)) {
+        DeviceInfoManager::getInstance()->addInfo(QString("smartctl_%1").arg(name), DiskIdentify::recordToText(DiskIdentify::toRecord(identify)));
+        return;
+    }
+
+    // 每个硬盘的超时时间由runCmd根据截止前的剩余时间计算
+    QString smartCmd = QString("smartctl --all /dev/%1").arg(name);
+    QString sInfo;
+    runCmd(smartCmd, sInfo);
+    // 在使用smartctl的时候会出现对 /dev/sda 出现判断错误的情况，此时可以对/dev/sda1进行处理
+    // 剩余时间不足时不再重试，保留第一次的结果
+    if (retryPartition && sInfo.contains("Read Device Identity failed:")) {
+        int remain = remainingTime();
+        if (remain < 0 || remain >= SMARTCTL_RETRY_MIN) {
             smartCmd = smartCmd + "1";
             runCmd(smartCmd, sInfo);
+        } else {
+            qCWarning(appLog) << "Not enough time left to retry smartctl on partition:" << name << "remain:" << remain;
         }
-        DeviceInfoManager::getInstance()->addInfo(QString("smartctl_%1").arg(words[0].trimmed()), sInfo);
     }
+    // 每个硬盘结束后立即写入缓存，慢盘不影响其它硬盘
+    DeviceInfoManager::getInstance()->addInfo(QString("smartctl_%1").arg(name), sInfo);
+}
+
+void ThreadPoolTask::runSmartCtlTasks(const QStringList &names, bool retryPartition)
+{
+    if (names.isEmpty())
+        return;
+
+    // 每个硬盘一个子任务，并发数受限，单个硬盘的超时由runCmd按截止时间保证
+    QThreadPool pool;
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), SMARTCTL_CONCURRENCY));
+    foreach (const QString &name, names) {
+        SmartCtlTask *task = new SmartCtlTask(this, name, retryPartition);
+        task->setAutoDelete(true);
+        pool.start(task);
+    }
+    pool.waitForDone(-1);
+    qCDebug(appLog) << "smartctl finished for" << names.size() << "devices";
 }
 
 void ThreadPoolTask::loadCpuInfo()
@@ -243,6 +349,7 @@ void ThreadPoolTask::loadCpuInfo()
 
 void ThreadPoolTask::loadSgSmartCtlInfoToCache(const QString &info)
 {
+    QStringList names;
     QStringList lines = info.split("\n");
 
     foreach (QString line, lines) {
@@ -251,12 +358,12 @@ void ThreadPoolTask::loadSgSmartCtlInfoToCache(const QString &info)
         }
 
         QStringList words = line.split("/");
-
-        QString smartCmd = QString("smartctl --all /dev/%1").arg(words[2].trimmed());
-        QString sInfo;
-        runCmd(smartCmd, sInfo);
-        DeviceInfoManager::getInstance()->addInfo(QString("smartctl_%1").arg(words[2]), sInfo);
+        if (words.size() < 3)
+            continue;
+        names.append(words[2].trimmed());
     }
+
+    runSmartCtlTasks(names, false);
 }
 
 void ThreadPoolTask::loadLspciVSInfoToCache(const QString &info)
@@ -277,49 +384,6 @@ void ThreadPoolTask::loadLspciVSInfoToCache(const QString &info)
     }
 }
 
-void ThreadPoolTask::loadDisplayWidth(const QString &info)
-{
-    QString widthS;
-    QStringList params = info.split("\n\n");
-    foreach (const QString &param, params) {
-
-        QStringList lines = param.split("\n");
-        if (lines.size() < 5)
-            continue;
-        foreach (const QString &line, lines) {
-            if (line.contains("SysFS ID")) {
-                QString pci = line.right(7);
-                int width = getDisplayWidthFromLspci(pci);
-                widthS += pci;
-                widthS += "-";
-                widthS += QString::number(width);
-                widthS += "\n";
-                break;
-            }
-        }
-
-        DeviceInfoManager::getInstance()->addInfo("width", widthS);
-    }
-}
-
-int ThreadPoolTask::getDisplayWidthFromLspci(const QString &info)
-{
-    QString cmd = QString("lspci -v -s %1").arg(info);
-    QString sInfo;
-    runCmd(cmd, sInfo);
-    QStringList lines = sInfo.split("\n");
-    foreach (const QString &line, lines) {
-        if (!line.contains("Memory at")) {
-            continue;
-        }
-        if (line.contains("32-bit"))
-            return 32;
-        else
-            return 64;
-    }
-    return 64;
-}
-
 void ThreadPoolTask::runCmdToFile(const QString &cmd)
 {
     // 1. 先判断通过该命令获取的信息是不是需要刷新的,如果是cpu，内存条，主板等信息则只需要开机获取即可
@@ -12,21 +12,51 @@
 //#define PATH "/home/liujun/device-info/"
 #define PATH "/tmp/device-info/"  // 设备文件存放的目录
 
+// 依赖其它节点输出的后续任务
+#define CMD_SMARTCTL_LSBLK  "smartctl_lsblk"    // lsblk_d -> smartctl --all /dev/***
+#define CMD_SMARTCTL_SG     "smartctl_sg"       // ls_sg -> smartctl --all /dev/sg*
+#define CMD_LSPCI_VS        "lspci_vs"          // lspci -> lspci -v -s ***
+#define CMD_SMARTCTL_DISKS  "smartctl_disks"    // smartctl_disks sdb sdc，只读取指定的硬盘
+
+#define SMARTCTL_CONCURRENCY 8                  // 同时执行smartctl的最大硬盘数
+#define SMARTCTL_RETRY_MIN   3000               // 截止前剩余时间少于该值(ms)时不再重试分区
+
 /**
  * @brief The ThreadPoolTask class
  */
 class ThreadPoolTask : public QObject, public QRunnable
 {
     Q_OBJECT
+    friend class SmartCtlTask;
 public:
+    /**
+     * @brief The TaskStatus enum : 任务执行结果
+     */
+    enum TaskStatus {
+        TS_Running   = 0,   //<! 正在执行
+        TS_Finished  = 1,   //<! 正常结束
+        TS_Skipped   = 2,   //<! 缓存已存在，无需执行
+        TS_TimedOut  = 3,   //<! 超时，进程已被终止
+        TS_Failed    = 4    //<! 命令启动失败或异常退出
+    };
+
     explicit ThreadPoolTask(QString cmd, QString file, bool replace, int waiting, QObject *parent = nullptr);
     ~ThreadPoolTask() override;
 
+    /**
+     * @brief setDeadline : 设置本批次采集的截止时间，命令的超时时间不会超过截止前的剩余时间
+     * @param msecsSinceEpoch : 截止时间，小于等于0表示不限制
+     */
+    void setDeadline(qint64 msecsSinceEpoch);
+
 signals:
     /**
      * @brief finished : finish task
+     * @param file : the file of the task
+     * @param status : TaskStatus
+     * @param elapsed : wall time of the task (ms)
      */
-    void finished();
+    void finished(const QString &file, int status, qint64 elapsed);
 
 protected:
     void run() override;
@@ -42,8 +72,15 @@ private:
      * @brief runCmd
      * @param cmd
      * @param info
+     * @return TaskStatus
+     */
+    TaskStatus runCmd(const QString &cmd, QString &info);
+
+    /**
+     * @brief remainingTime : 命令可用的超时时间，取单个命令超时时间与截止前剩余时间的较小值
+     * @return 毫秒，-1表示不限制
      */
-    void runCmd(const QString &cmd, QString &info);
+    int remainingTime() const;
 
     /**
      * @brief runAsteriskCmd
@@ -56,8 +93,9 @@ private:
     /**
      * @brief runCmdToCache
      * @param cmd
+     * @return TaskStatus
      */
-    void runCmdToCache(const QString &cmd);
+    TaskStatus runCmdToCache(const QString &cmd);
 
     /**
      * @brief loadSmartCtlInfoToCache
@@ -66,34 +104,35 @@ private:
     void loadSmartCtlInfoToCache(const QString &info);
 
     /**
-     * @brief loadCpuInfo
+     * @brief loadSmartCtlDevice : 获取单个硬盘的smartctl信息并写入缓存
+     * @param name : 设备名称，如 sda
+     * @param retryPartition : 读取失败时是否尝试第一个分区
      */
-    void loadCpuInfo();
+    void loadSmartCtlDevice(const QString &name, bool retryPartition);
 
     /**
-     * @brief loadSgSmartCtlInfoToCache
-     * @param info
+     * @brief runSmartCtlTasks : 以有限并发执行每个硬盘的smartctl任务
+     * @param names : 设备名称列表
+     * @param retryPartition : 读取失败时是否尝试第一个分区
      */
-    void loadSgSmartCtlInfoToCache(const QString &info);
+    void runSmartCtlTasks(const QStringList &names, bool retryPartition);
 
     /**
-     * @brief loadLspciVSInfoToCache
-     * @param info
+     * @brief loadCpuInfo
      */
-    void loadLspciVSInfoToCache(const QString &info);
+    void loadCpuInfo();
 
     /**
-     * @brief loadDisplayWidth
+     * @brief loadSgSmartCtlInfoToCache
      * @param info
      */
-    void loadDisplayWidth(const QString &info);
+    void loadSgSmartCtlInfoToCache(const QString &info);
 
     /**
-     * @brief getDisplayWidthFromLspci
+     * @brief loadLspciVSInfoToCache
      * @param info
-     * @return
      */
-    int getDisplayWidthFromLspci(const QString &info);
+    void loadLspciVSInfoToCache(const QString &info);
 
     /**
      * @brief runCmdToTxt
@@ -118,6 +157,7 @@ private:
     QString   m_File;                 //<! file name
     bool      m_CanNotReplace;        //<! Whether to replace if file existed
     int       m_Waiting;              //<! waiting time
+    qint64    m_Deadline;             //<! 本批次的截止时间(ms since epoch)，0表示不限制
 };
 
 #endif // THREADPOOLTASK_H
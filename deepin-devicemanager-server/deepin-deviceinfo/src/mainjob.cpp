@@ -7,7 +7,9 @@
 #include "debugtimemanager.h"
 #include "threadpool.h"
 #include "detectthread.h"
+#include "monitorusb.h"
 #include "controlinterface.h"
+#include "deviceinfomanager.h"
 #include "DDLog.h"
 
 #include <QMutex>
@@ -15,6 +17,7 @@
 #include <QFile>
 #include <QLoggingCategory>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QDBusConnection>
 
 #include <DSysInfo>
@@ -40,7 +43,7 @@ MainJob::MainJob(const char *name, QObject *parent)
     // 启动线程监听USB是否有新的设备
     mp_DetectThread = new DetectThread(this);
     mp_DetectThread->setWorkingFlag(ControlInterface::getInstance()->monitorWorkingDBFlag());
-    connect(mp_DetectThread, &DetectThread::usbChanged, this, &MainJob::slotUsbChanged, Qt::ConnectionType::QueuedConnection);
+    connect(mp_DetectThread, &DetectThread::usbChanged, this, &MainJob::slotHotplugChanged, Qt::ConnectionType::QueuedConnection);
 
     // 在驱动管理延迟加载1000ms
     QTimer::singleShot(1000, this, [ = ]() {
@@ -53,7 +56,6 @@ MainJob::MainJob(const char *name, QObject *parent)
 
         sqlCopytoKernel();
 
-        connect(m_deviceInterface, &DeviceInterface::sigUpdate, this, &MainJob::slotUsbChanged);
         connect(ControlInterface::getInstance(), &ControlInterface::sigUpdate, this, &MainJob::slotUsbChanged);
 #ifndef DISABLE_DRIVER
         connect(ControlInterface::getInstance(), &ControlInterface::sigFinished, this, &MainJob::slotDriverControl);
@@ -110,6 +112,37 @@ bool MainJob::clientIsRunning()
     return s_ClientIsUpdating;
 }
 
+quint64 MainJob::requestRefresh()
+{
+    // 采集与dbus调用都在主线程，已排队的刷新请求合并为一次
+    if (!m_RefreshPending) {
+        m_RefreshPending = true;
+        // 正在进行的采集开始于本次刷新之前，发布后还需要再采集一次
+        m_RefreshTarget = DeviceInfoManager::getInstance()->generation() + (s_ServerIsUpdating ? 2 : 1);
+        QMetaObject::invokeMethod(this, "slotRefresh", Qt::QueuedConnection);
+    }
+    qCDebug(appLog) << "Refresh requested, target generation:" << m_RefreshTarget;
+    return m_RefreshTarget;
+}
+
+void MainJob::slotRefresh()
+{
+    if (!m_RefreshPending) {
+        qCDebug(appLog) << "Refresh already included in a previous collection";
+        return;
+    }
+    executeClientInstruction("DETECT");
+}
+
+void MainJob::finishCollect()
+{
+    // 本次采集的信息整体发布，客户端只看到完整的一次采集
+    DeviceInfoManager::getInstance()->publish();
+    quint64 generation = DeviceInfoManager::getInstance()->generation();
+    qCDebug(appLog) << "Collect generation" << generation << "complete";
+    m_deviceInterface->notifyReady(generation);
+}
+
 void MainJob::setWorkingFlag(bool flag)
 {
     mp_DetectThread->setWorkingFlag(flag);
@@ -121,6 +154,74 @@ void MainJob::slotUsbChanged()
     executeClientInstruction("DETECT");
 }
 
+void MainJob::slotHotplugChanged(const QStringList &eventClasses, const QStringList &disks)
+{
+    QStringList keys = hotplugKeys(eventClasses);
+    if (keys.isEmpty()) {
+        qCInfo(appLog) << "Hotplug event classes" << eventClasses << "unknown, update all device info";
+        executeClientInstruction("DETECT");
+        return;
+    }
+    // 有等待中的刷新时改为全部采集，保证refreshInfo返回的版本包含该刷新
+    if (m_RefreshPending) {
+        qCInfo(appLog) << "Hotplug event classes" << eventClasses << "merged into the pending refresh";
+        executeClientInstruction("DETECT");
+        return;
+    }
+
+    qCDebug(appLog) << "Hotplug event classes:" << eventClasses << "keys:" << keys << "disks:" << disks;
+    QMutexLocker locker(&mainJobMutex);
+    // MonitorUsb 在事件静默COALESCE_WINDOW后才发出信号，这里不再等待
+    s_ServerIsUpdating = true;
+
+    QElapsedTimer timer;
+    timer.start();
+    m_pool->updateDeviceInfo(keys, disks);
+    qint64 elapsed = timer.elapsed();
+
+    // 统计每个事件类别的刷新耗时
+    foreach (const QString &eventClass, eventClasses) {
+        QPair<int, qint64> &latency = m_MapRefreshLatency[eventClass];
+        latency.first++;
+        latency.second += elapsed;
+        qCInfo(appLog) << "Hotplug refresh" << eventClass << "took" << elapsed << "ms, average"
+                       << latency.second / latency.first << "ms over" << latency.first << "events";
+    }
+    s_ServerIsUpdating = false;
+    finishCollect();
+}
+
+QVariantMap MainJob::hotplugStatistics() const
+{
+    return mp_DetectThread ? mp_DetectThread->statistics() : QVariantMap();
+}
+
+QStringList MainJob::hotplugKeys(const QStringList &eventClasses)
+{
+    static QMap<QString, QStringList> mapKeys;
+    if (mapKeys.isEmpty()) {
+        // 硬盘的SMART信息只读取插入的硬盘，见ThreadPool::updateDeviceInfo
+        mapKeys.insert(EVENT_CLASS_STORAGE, QStringList() << "lsblk_d" << "hwinfo" << "lshw");
+        mapKeys.insert(EVENT_CLASS_INPUT, QStringList() << "hwinfo");
+        mapKeys.insert(EVENT_CLASS_PRINTER, QStringList() << "lpstat" << "hwinfo");
+        mapKeys.insert(EVENT_CLASS_BLUETOOTH, QStringList() << "hciconfig" << "bt_device" << "hwinfo");
+        mapKeys.insert(EVENT_CLASS_NETWORK, QStringList() << "hwinfo" << "lshw");
+        mapKeys.insert(EVENT_CLASS_MULTIMEDIA, QStringList() << "hwinfo" << "lshw");
+        mapKeys.insert(EVENT_CLASS_OTHER, QStringList() << "hwinfo" << "lshw");
+    }
+
+    QStringList keys;
+    foreach (const QString &eventClass, eventClasses) {
+        if (!mapKeys.contains(eventClass))
+            return QStringList();
+        foreach (const QString &key, mapKeys[eventClass]) {
+            if (!keys.contains(key))
+                keys.append(key);
+        }
+    }
+    return keys;
+}
+
 void MainJob::slotDriverControl(bool success)
 {
     if (success)
@@ -176,9 +277,9 @@ void MainJob::updateAllDevice()
         qCDebug(appLog) << "Updating existing device info";
         m_pool->updateDeviceInfo();
     }
-    m_pool->waitForDone(-1);
     PERF_PRINT_END("POINT-01");
     m_firstUpdate = false;
+    finishCollect();
 }
 
 void MainJob::executeClientInstruction(const QString &instructions)
@@ -190,6 +291,8 @@ void MainJob::executeClientInstruction(const QString &instructions)
 
     if (instructions.startsWith("DETECT")) {
         qCDebug(appLog) << "Processing DETECT instruction";
+        // 全部采集包含此前所有的刷新请求
+        m_RefreshPending = false;
         this->thread()->msleep(1000);
         // 跟新缓存信息
         updateAllDevice();
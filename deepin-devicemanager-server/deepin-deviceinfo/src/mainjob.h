@@ -6,6 +6,10 @@
 #define MAINJOB_H
 
 #include <QObject>
+#include <QMap>
+#include <QPair>
+#include <QStringList>
+#include <QVariantMap>
 
 class DeviceInterface;
 class ThreadPool;
@@ -29,16 +33,46 @@ public:
      */
     static bool clientIsRunning();
 
+    /**
+     * @brief requestRefresh 请求一次全部采集，采集排队执行
+     * 刷新等待期间到达的热插拔采集会改为全部采集，所以之后第一次完成的采集一定包含本次刷新
+     * @return 包含本次刷新的信息版本，见DeviceInfoManager::generation
+     */
+    quint64 requestRefresh();
+
     /**
      * @brief setWorkingFlag 设置工作状态
      */
     void setWorkingFlag(bool flag);
 
+    /**
+     * @brief hotplugKeys 根据热插拔事件类别获取需要重新采集的信息
+     * @param eventClasses : MonitorUsb 中定义的事件类别
+     * @return 缓存关键字，包含未知类别时返回空，表示需要全部更新
+     */
+    static QStringList hotplugKeys(const QStringList &eventClasses);
+
+    /**
+     * @brief hotplugStatistics 热插拔事件统计
+     * @return received/dropped/coalesced/refreshes
+     */
+    QVariantMap hotplugStatistics() const;
+
 private slots:
     /**
      * @brief slotUsbChanged
      */
     void slotUsbChanged();
+    /**
+     * @brief slotHotplugChanged 热插拔时只更新受影响的信息
+     * @param eventClasses : 事件类别
+     * @param disks : 插入的硬盘，只读取这些硬盘的信息
+     */
+    void slotHotplugChanged(const QStringList &eventClasses, const QStringList &disks);
+    /**
+     * @brief slotRefresh 执行排队的刷新请求，已被其它全部采集包含时不再执行
+     */
+    void slotRefresh();
     /**
      * @brief slotUsbChanged
      * @param usbchanged
@@ -62,6 +96,10 @@ private:
      * @brief updateAllDevice
      */
     void updateAllDevice();
+    /**
+     * @brief finishCollect 采集完成，发布本次采集的信息并通知等待的客户端
+     */
+    void finishCollect();
     /**
      * @brief executeClientInstruction
      * @param instructions
@@ -81,6 +119,9 @@ private:
     bool                   m_firstUpdate;                      //<! 是否是第一次更新
     DeviceInterface       *m_deviceInterface = nullptr;        //<! 设备信息
     DetectThread          *mp_DetectThread = nullptr;         //<! 检测usb的线程
+    QMap<QString, QPair<int, qint64> > m_MapRefreshLatency;   //<! 事件类别 -> (次数, 总耗时ms)
+    bool                   m_RefreshPending = false;          //<! 有尚未开始的刷新请求
+    quint64                m_RefreshTarget = 0;               //<! 包含排队刷新请求的信息版本
 };
 
 #endif // MAINJOB_H
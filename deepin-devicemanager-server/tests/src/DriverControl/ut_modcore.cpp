@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "modcore.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QAtomicInt>
+
+#define BENCH_ROUND_COUNT 20
+
+// 驱动安装、卸载过程中连续查询的模块，不同机器上可能是模块、内建或不存在
+static const char *const MODULES[] = {
+    "usbhid", "snd_hda_intel", "xhci_hcd", "btusb", "not_a_module",
+};
+
+// 修改前每次查询都新建上下文
+static QString modGetPathWithNewContext(const QString &modName)
+{
+    QString path;
+    struct kmod_ctx *ctx = kmod_new(nullptr, nullptr);
+    if (ctx) {
+        struct kmod_module *mod = nullptr;
+        if (kmod_module_new_from_name(ctx, modName.toStdString().c_str(), &mod) >= 0) {
+            path.append(kmod_module_get_path(mod));
+            kmod_module_get_initstate(mod);
+            kmod_module_unref(mod);
+        }
+        kmod_unref(ctx);
+    }
+    return path;
+}
+
+class ModCore_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        ModCore::resetContext();
+        m_core = new ModCore;
+    }
+    void TearDown()
+    {
+        delete m_core;
+        ModCore::resetContext();
+    }
+    ModCore *m_core = nullptr;
+};
+
+TEST_F(ModCore_UT, ModCore_UT_sharedContext)
+{
+    m_core->modGetPath("usbhid");
+    struct kmod_ctx *ctx = ModCore::s_ctx;
+    ASSERT_NE(ctx, nullptr);
+
+    // 索引文件未变化时继续使用同一个上下文
+    ModCore other;
+    other.modIsLoaded("usbhid");
+    EXPECT_EQ(ctx, ModCore::s_ctx);
+    EXPECT_EQ(ModCore::s_ctxMtimes, ModCore::ctxFilesMtime(ModCore::s_ctx));
+
+    ModCore::resetContext();
+    EXPECT_EQ(ModCore::s_ctx, nullptr);
+    m_core->modGetPath("usbhid");
+    EXPECT_NE(ModCore::s_ctx, nullptr);
+}
+
+TEST_F(ModCore_UT, ModCore_UT_reloadOnChange)
+{
+    m_core->modGetPath("usbhid");
+    ASSERT_NE(ModCore::s_ctx, nullptr);
+    // 修改时间变化后重新创建上下文，结果不变
+    ModCore::s_ctxMtimes[0] += 1;
+    QString path = m_core->modGetPath("usbhid");
+    EXPECT_EQ(ModCore::s_ctxMtimes, ModCore::ctxFilesMtime(ModCore::s_ctx));
+    EXPECT_EQ(path, modGetPathWithNewContext("usbhid"));
+}
+
+TEST_F(ModCore_UT, ModCore_UT_threads)
+{
+    // 多线程同时查询时结果与单独查询一致
+    QString expect = modGetPathWithNewContext("usbhid");
+    QList<QThread *> threads;
+    QAtomicInt mismatch(0);
+    for (int i = 0; i < 4; ++i) {
+        threads.append(QThread::create([this, &expect, &mismatch]() {
+            for (int j = 0; j < 50; ++j) {
+                if (m_core->modGetPath("usbhid") != expect)
+                    mismatch.ref();
+                m_core->modIsBuildIn("usbhid");
+            }
+        }));
+        threads.last()->start();
+    }
+    foreach (QThread *thread, threads) {
+        thread->wait();
+        delete thread;
+    }
+    EXPECT_EQ(mismatch.loadAcquire(), 0);
+}
+
+TEST_F(ModCore_UT, ModCore_UT_benchmark)
+{
+    // 每轮查询路径与状态，对比每次新建上下文与共享上下文的耗时
+    size_t moduleCount = sizeof(MODULES) / sizeof(MODULES[0]);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < BENCH_ROUND_COUNT; ++i) {
+        for (size_t j = 0; j < moduleCount; ++j) {
+            modGetPathWithNewContext(MODULES[j]);
+            modGetPathWithNewContext(MODULES[j]);
+        }
+    }
+    qint64 newContextTime = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < BENCH_ROUND_COUNT; ++i) {
+        for (size_t j = 0; j < moduleCount; ++j) {
+            m_core->modGetPath(MODULES[j]);
+            m_core->modGetInitState(MODULES[j]);
+        }
+    }
+    qint64 sharedContextTime = timer.nsecsElapsed();
+
+    for (size_t j = 0; j < moduleCount; ++j)
+        EXPECT_EQ(modGetPathWithNewContext(MODULES[j]), m_core->modGetPath(MODULES[j]));
+    qInfo() << "queries:" << BENCH_ROUND_COUNT * moduleCount * 2
+            << "new context:" << newContextTime / 1000 << "us" << "shared context:" << sharedContextTime / 1000 << "us";
+}
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "deviceinfomanager.h"
+
+#include <QDBusConnection>
+#include <QDBusInterface>
+#include <QDBusMetaType>
+#include <QDBusReply>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define BENCH_KEY_COUNT  30
+#define BENCH_INFO_SIZE  (300 * 1024)
+
+class DeviceInfoManager_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        for (int i = 0; i < BENCH_KEY_COUNT; ++i) {
+            QString key = QString("bench_%1").arg(i);
+            DeviceInfoManager::getInstance()->addInfo(key, QString(BENCH_INFO_SIZE, QChar('a' + i % 26)));
+            m_Keys.append(key);
+        }
+        DeviceInfoManager::getInstance()->publish();
+    }
+    void TearDown()
+    {
+    }
+    QStringList m_Keys;
+};
+
+TEST_F(DeviceInfoManager_UT, DeviceInfoManager_UT_getInfos)
+{
+    QMap<QString, QString> infos = DeviceInfoManager::getInstance()->getInfos(QStringList() << "bench_0" << "bench_1" << "bench_unknown");
+    EXPECT_EQ(infos.size(), 2);
+    EXPECT_EQ(infos["bench_1"], QString(BENCH_INFO_SIZE, 'b'));
+    EXPECT_FALSE(infos.contains("bench_unknown"));
+
+    QMap<QString, QString> all = DeviceInfoManager::getInstance()->getAllInfo();
+    foreach (const QString &key, m_Keys)
+        EXPECT_TRUE(all.contains(key));
+}
+
+TEST_F(DeviceInfoManager_UT, DeviceInfoManager_UT_generation)
+{
+    quint64 generation = DeviceInfoManager::getInstance()->generation();
+    QString info = DeviceInfoManager::getInstance()->getInfo("bench_2");
+    DeviceInfoManager::getInstance()->addInfo("bench_2", "changed");
+    DeviceInfoManager::getInstance()->addInfo("bench_4", "changed");
+
+    // 发布前客户端读到的仍是上一版本，采集中可以读到已写入的信息
+    EXPECT_EQ(DeviceInfoManager::getInstance()->generation(), generation);
+    EXPECT_EQ(DeviceInfoManager::getInstance()->getInfo("bench_2"), info);
+    EXPECT_EQ(DeviceInfoManager::getInstance()->getStagedInfo("bench_2"), QString("changed"));
+
+    // 一次采集只递增一次版本号
+    EXPECT_TRUE(DeviceInfoManager::getInstance()->publish());
+    EXPECT_FALSE(DeviceInfoManager::getInstance()->publish());
+    EXPECT_EQ(DeviceInfoManager::getInstance()->generation(), generation + 1);
+    EXPECT_EQ(DeviceInfoManager::getInstance()->getInfo("bench_4"), QString("changed"));
+
+    // 已读取的信息不受之后写入的影响
+    EXPECT_EQ(info, QString(BENCH_INFO_SIZE, 'c'));
+    EXPECT_EQ(DeviceInfoManager::getInstance()->getInfo("bench_2"), QString("changed"));
+
+    // 读取不存在的关键字不会插入
+    EXPECT_TRUE(DeviceInfoManager::getInstance()->getInfo("bench_unknown").isEmpty());
+    EXPECT_FALSE(DeviceInfoManager::getInstance()->isInfoExisted("bench_unknown"));
+    EXPECT_EQ(DeviceInfoManager::getInstance()->generation(), generation + 1);
+}
+
+TEST_F(DeviceInfoManager_UT, DeviceInfoManager_UT_concurrent)
+{
+    // 多个写者同时写入时每次写入都不丢失
+    QList<QThread *> threads;
+    for (int t = 0; t < 4; ++t) {
+        QThread *thread = QThread::create([t]() {
+            for (int i = 0; i < 50; ++i)
+                DeviceInfoManager::getInstance()->addInfo(QString("concurrent_%1_%2").arg(t).arg(i), "x");
+        });
+        threads.append(thread);
+        thread->start();
+    }
+    for (int i = 0; i < 200; ++i)
+        EXPECT_EQ(DeviceInfoManager::getInstance()->getInfo("bench_3").size(), BENCH_INFO_SIZE);
+    foreach (QThread *thread, threads) {
+        thread->wait();
+        delete thread;
+    }
+    DeviceInfoManager::getInstance()->publish();
+
+    QMap<QString, QString> all = DeviceInfoManager::getInstance()->getAllInfo();
+    for (int t = 0; t < 4; ++t) {
+        for (int i = 0; i < 50; ++i)
+            EXPECT_TRUE(all.contains(QString("concurrent_%1_%2").arg(t).arg(i)));
+    }
+}
+
+TEST_F(DeviceInfoManager_UT, DeviceInfoManager_UT_snapshot)
+{
+    int fd = DeviceInfoManager::getInstance()->snapshot();
+    ASSERT_GE(fd, 0);
+    // 信息未变化时复用同一个快照
+    EXPECT_EQ(DeviceInfoManager::getInstance()->snapshot(), fd);
+
+    struct stat st;
+    ASSERT_EQ(fstat(fd, &st), 0);
+    const char *data = static_cast<const char *>(mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0));
+    ASSERT_NE(data, MAP_FAILED);
+    EXPECT_EQ(memcmp(data, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE), 0);
+    QByteArray bytes = QByteArray::fromRawData(data, static_cast<int>(st.st_size));
+    EXPECT_TRUE(bytes.contains("bench_0"));
+    munmap(const_cast<char *>(data), static_cast<size_t>(st.st_size));
+
+    // 快照已密封，不能写入
+    EXPECT_LT(write(fd, "x", 1), 0);
+
+    DeviceInfoManager::getInstance()->addInfo("bench_0", "changed");
+    DeviceInfoManager::getInstance()->publish();
+    EXPECT_GE(DeviceInfoManager::getInstance()->snapshot(), 0);
+}
+
+TEST_F(DeviceInfoManager_UT, DeviceInfoManager_UT_benchmark)
+{
+    // 逐个获取与批量获取的对比，dbus服务存在时同时对比系统总线上的耗时
+    QElapsedTimer timer;
+    timer.start();
+    foreach (const QString &key, m_Keys)
+        EXPECT_EQ(DeviceInfoManager::getInstance()->getInfo(key).size(), BENCH_INFO_SIZE);
+    qint64 single = timer.nsecsElapsed();
+
+    timer.restart();
+    QMap<QString, QString> infos = DeviceInfoManager::getInstance()->getInfos(m_Keys);
+    qint64 batched = timer.nsecsElapsed();
+    EXPECT_EQ(infos.size(), BENCH_KEY_COUNT);
+    qInfo() << "in-process single:" << single / 1000 << "us batched:" << batched / 1000 << "us";
+
+    QDBusInterface iface("org.deepin.DeviceInfo", "/org/deepin/DeviceInfo", "org.deepin.DeviceInfo", QDBusConnection::systemBus());
+    if (!iface.isValid())
+        return;
+
+    qDBusRegisterMetaType<QMap<QString, QString> >();
+    QStringList keys = QStringList() << "lshw" << "hwinfo" << "lscpu" << "lsblk_d" << "dmidecode_0" << "dmidecode_1"
+                                     << "dmidecode_2" << "dmidecode_3" << "dmidecode_4" << "dmidecode_13" << "dmidecode_16"
+                                     << "dmidecode_17" << "hwinfo_monitor" << "upower_dump" << "dmesg" << "hciconfig";
+    timer.restart();
+    foreach (const QString &key, keys) {
+        QDBusReply<QString> reply = iface.call("getInfo", key);
+        EXPECT_TRUE(reply.isValid());
+    }
+    single = timer.elapsed();
+
+    timer.restart();
+    QDBusReply<QMap<QString, QString> > reply = iface.call("getAllInfo");
+    batched = timer.elapsed();
+    qInfo() << "system bus single:" << single << "ms batched:" << batched << "ms valid:" << reply.isValid();
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "diskidentify.h"
+
+class DiskIdentify_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+
+    static void setWord(QByteArray &page, int index, quint16 value)
+    {
+        page[index * 2] = static_cast<char>(value & 0xFF);
+        page[index * 2 + 1] = static_cast<char>(value >> 8);
+    }
+
+    static void setAtaString(QByteArray &page, int firstWord, int lastWord, const QByteArray &str)
+    {
+        QByteArray padded = str.leftJustified((lastWord - firstWord + 1) * 2, ' ');
+        for (int i = firstWord; i <= lastWord; ++i) {
+            int offset = (i - firstWord) * 2;
+            setWord(page, i, static_cast<quint16>((static_cast<unsigned char>(padded[offset]) << 8) | static_cast<unsigned char>(padded[offset + 1])));
+        }
+    }
+
+    static QByteArray ataPage()
+    {
+        QByteArray page(ATA_IDENTIFY_SIZE, 0);
+        setAtaString(page, 10, 19, "S3Z9NB0K123456");
+        setAtaString(page, 23, 26, "RVT02B6Q");
+        setAtaString(page, 27, 46, "Samsung SSD 860 EVO 1TB");
+        // 1953525168 sectors, 48bit
+        setWord(page, 83, 0x0400);
+        setWord(page, 100, 0x6DB0);
+        setWord(page, 101, 0x7470);
+        setWord(page, 217, 0x0001);
+        setWord(page, 222, 0x10FF);
+        setWord(page, 76, 0x000E);
+        setWord(page, 77, 0x0006);
+        return page;
+    }
+};
+
+TEST_F(DiskIdentify_UT, DiskIdentify_UT_parseAtaIdentify)
+{
+    DiskIdentifyInfo info;
+    EXPECT_TRUE(DiskIdentify::parseAtaIdentify(ataPage(), info));
+    EXPECT_FALSE(info.nvme);
+    EXPECT_EQ(info.model, QString("Samsung SSD 860 EVO 1TB"));
+    EXPECT_EQ(info.serial, QString("S3Z9NB0K123456"));
+    EXPECT_EQ(info.firmware, QString("RVT02B6Q"));
+    EXPECT_EQ(info.capacity, Q_UINT64_C(1000204886016));
+    EXPECT_EQ(info.rotationRate, 1);
+    EXPECT_EQ(info.sataVersion, QString("SATA 3.2, 6.0 Gb/s (current: 6.0 Gb/s)"));
+}
+
+TEST_F(DiskIdentify_UT, DiskIdentify_UT_parseAtaIdentifyInvalid)
+{
+    DiskIdentifyInfo info;
+    EXPECT_FALSE(DiskIdentify::parseAtaIdentify(QByteArray(16, 0), info));
+
+    // ATAPI设备
+    QByteArray page = ataPage();
+    setWord(page, 0, 0x8580);
+    EXPECT_FALSE(DiskIdentify::parseAtaIdentify(page, info));
+}
+
+TEST_F(DiskIdentify_UT, DiskIdentify_UT_parseNvme)
+{
+    QByteArray page(NVME_IDENTIFY_SIZE, 0);
+    page.replace(4, 20, QByteArray("S4EWNX0N123456").leftJustified(20, ' '));
+    page.replace(24, 40, QByteArray("Samsung SSD 970 EVO Plus 250GB").leftJustified(40, ' '));
+    page.replace(64, 8, QByteArray("2B2QEXM7").leftJustified(8, ' '));
+    // 250059350016 bytes
+    quint64 capacity = Q_UINT64_C(250059350016);
+    for (int i = 0; i < 8; ++i)
+        page[280 + i] = static_cast<char>((capacity >> (i * 8)) & 0xFF);
+
+    DiskIdentifyInfo info;
+    EXPECT_TRUE(DiskIdentify::parseNvmeIdentify(page, info));
+    EXPECT_TRUE(info.nvme);
+    EXPECT_EQ(info.model, QString("Samsung SSD 970 EVO Plus 250GB"));
+    EXPECT_EQ(info.serial, QString("S4EWNX0N123456"));
+    EXPECT_EQ(info.firmware, QString("2B2QEXM7"));
+    EXPECT_EQ(info.capacity, capacity);
+
+    QMap<QString, QString> record = DiskIdentify::toRecord(info);
+    EXPECT_EQ(record[DISK_KEY_INTERFACE], QString("nvme"));
+    EXPECT_EQ(record[DISK_KEY_MODEL], QString("Samsung SSD 970 EVO Plus 250GB"));
+    EXPECT_EQ(record[DISK_KEY_CAPACITY], QString("250059350016"));
+    EXPECT_EQ(record[DISK_KEY_CAPACITY_TEXT], QString("250 GB"));
+}
+
+TEST_F(DiskIdentify_UT, DiskIdentify_UT_nvmeRecordWithoutCapacity)
+{
+    // 容量未知时，标识字段仍然完整输出
+    QByteArray page(NVME_IDENTIFY_SIZE, 0);
+    page.replace(4, 20, QByteArray("S4EWNX0N123456").leftJustified(20, ' '));
+    page.replace(24, 40, QByteArray("Samsung SSD 970 EVO Plus 250GB").leftJustified(40, ' '));
+    page.replace(64, 8, QByteArray("2B2QEXM7").leftJustified(8, ' '));
+
+    DiskIdentifyInfo info;
+    EXPECT_TRUE(DiskIdentify::parseNvmeIdentify(page, info));
+
+    QMap<QString, QString> record = DiskIdentify::toRecord(info);
+    EXPECT_EQ(record.size(), 9);
+    EXPECT_EQ(record[DISK_KEY_SERIAL], QString("S4EWNX0N123456"));
+    EXPECT_EQ(record[DISK_KEY_FIRMWARE], QString("2B2QEXM7"));
+
+    QString text = DiskIdentify::recordToText(record);
+    EXPECT_TRUE(text.startsWith(QString("%1\n").arg(DISK_RECORD_MAGIC)));
+    EXPECT_TRUE(text.contains("model: Samsung SSD 970 EVO Plus 250GB\n"));
+    EXPECT_TRUE(text.contains("serial: S4EWNX0N123456\n"));
+    EXPECT_TRUE(text.contains("firmware: 2B2QEXM7\n"));
+    EXPECT_TRUE(text.contains("capacity_text: \n"));
+}
+
+TEST_F(DiskIdentify_UT, DiskIdentify_UT_toRecord)
+{
+    DiskIdentifyInfo info;
+    DiskIdentify::parseAtaIdentify(ataPage(), info);
+
+    QMap<QString, QString> record = DiskIdentify::toRecord(info);
+    EXPECT_EQ(record[DISK_KEY_INTERFACE], QString("ata"));
+    EXPECT_EQ(record[DISK_KEY_MODEL], QString("Samsung SSD 860 EVO 1TB"));
+    EXPECT_EQ(record[DISK_KEY_CAPACITY], QString("1000204886016"));
+    EXPECT_EQ(record[DISK_KEY_CAPACITY_TEXT], QString("1.00 TB"));
+    EXPECT_EQ(record[DISK_KEY_ROTATION_RATE], QString("1"));
+    EXPECT_EQ(record[DISK_KEY_SATA_VERSION], QString("SATA 3.2, 6.0 Gb/s (current: 6.0 Gb/s)"));
+}
+
+TEST_F(DiskIdentify_UT, DiskIdentify_UT_formatCapacity)
+{
+    EXPECT_EQ(DiskIdentify::formatCapacity(Q_UINT64_C(1000204886016)), QString("1.00 TB"));
+    EXPECT_EQ(DiskIdentify::formatCapacity(Q_UINT64_C(256060514304)), QString("256 GB"));
+    EXPECT_EQ(DiskIdentify::formatCapacity(Q_UINT64_C(16008343552)), QString("16.0 GB"));
+}
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "threadpool.h"
+
+class ThreadPool_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_pool = new ThreadPool;
+        foreach (const Cmd &cmd, m_pool->m_ListCmd)
+            m_pool->m_MapNode.insert(cmd.name(), cmd);
+        foreach (const Cmd &cmd, m_pool->m_ListCmd) {
+            foreach (const QString &dep, cmd.deps)
+                m_pool->m_MapChildren[dep].append(cmd.name());
+        }
+    }
+    void TearDown()
+    {
+        delete m_pool;
+    }
+    ThreadPool *m_pool = nullptr;
+};
+
+TEST_F(ThreadPool_UT, ThreadPool_UT_nodeRank)
+{
+    // 依赖节点的代价计入前驱节点
+    EXPECT_EQ(m_pool->nodeRank("lsblk_d"), m_pool->m_MapNode["lsblk_d"].cost + m_pool->m_MapNode["smartctl_lsblk"].cost);
+    EXPECT_GT(m_pool->nodeRank("lshw"), m_pool->nodeRank("dmidecode_0"));
+    EXPECT_GT(m_pool->nodeRank("hwinfo"), m_pool->nodeRank("lspci"));
+}
+
+TEST_F(ThreadPool_UT, ThreadPool_UT_criticalPath)
+{
+    m_pool->m_MapFinishTime.insert("lsblk_d", 20);
+    m_pool->m_MapFinishTime.insert("lshw", 1000);
+    m_pool->m_MapFinishTime.insert("smartctl_lsblk", 1500);
+
+    QStringList path = m_pool->criticalPath();
+    EXPECT_EQ(path, QStringList() << "lsblk_d" << "smartctl_lsblk");
+}
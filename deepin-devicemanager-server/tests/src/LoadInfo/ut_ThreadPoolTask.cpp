@@ -7,6 +7,9 @@
 #include "../stub.h"
 #include "threadpooltask.h"
 #include <QThreadPool>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutex>
 #include "cpu/cpuinfo.h"
 #include "deviceinfomanager.h"
 
@@ -68,7 +71,76 @@ TEST_F(ThreadPoolTask_UT, ThreadPoolTask_UT_lscpu)
     QThreadPool tp;
     ThreadPoolTask *task = new ThreadPoolTask("lscpu", "lscpu.txt",true, 500);
     tp.start(task);
+    tp.waitForDone(-1);
+    DeviceInfoManager::getInstance()->publish();
 
     EXPECT_TRUE(!DeviceInfoManager::getInstance()->getInfo("lscpu").isEmpty());
     EXPECT_TRUE(!DeviceInfoManager::getInstance()->getInfo("lscpu_num").isEmpty());
 }
+
+TEST_F(ThreadPoolTask_UT, ThreadPoolTask_UT_finishedSkipped)
+{
+    DeviceInfoManager::getInstance()->addInfo("dmidecode_0", "cached");
+
+    int status = ThreadPoolTask::TS_Running;
+    ThreadPoolTask *task = new ThreadPoolTask("dmidecode -t 0", "dmidecode_0.txt", true, 500);
+    QObject::connect(task, &ThreadPoolTask::finished, [&status](const QString &, int st, qint64) {
+        status = st;
+    });
+    QThreadPool tp;
+    tp.start(task);
+    tp.waitForDone(-1);
+
+    EXPECT_EQ(ThreadPoolTask::TS_Skipped, status);
+}
+
+TEST_F(ThreadPoolTask_UT, ThreadPoolTask_UT_remainingTime)
+{
+    ThreadPoolTask task("sleep 1", "sleep.txt", false, 20000);
+    EXPECT_EQ(20000, task.remainingTime());
+
+    // 截止前的剩余时间小于命令超时时间时，以剩余时间为准
+    task.setDeadline(QDateTime::currentMSecsSinceEpoch() + 5000);
+    EXPECT_LE(task.remainingTime(), 5000);
+    EXPECT_GT(task.remainingTime(), 0);
+
+    task.setDeadline(QDateTime::currentMSecsSinceEpoch() - 1);
+    EXPECT_EQ(0, task.remainingTime());
+}
+
+TEST_F(ThreadPoolTask_UT, ThreadPoolTask_UT_deadlineReached)
+{
+    ThreadPoolTask task("sleep 1", "sleep.txt", false, 20000);
+    task.setDeadline(QDateTime::currentMSecsSinceEpoch() - 1);
+
+    // 已超过截止时间的命令不再启动
+    QElapsedTimer timer;
+    timer.start();
+    QString info;
+    EXPECT_EQ(ThreadPoolTask::TS_TimedOut, task.runCmd("sleep 1", info));
+    EXPECT_LT(timer.elapsed(), 1000);
+}
+
+static QMutex ut_smartctlMutex;
+static QStringList ut_smartctlNames;
+void ut_loadSmartCtlDevice(void *, const QString &name, bool)
+{
+    QMutexLocker locker(&ut_smartctlMutex);
+    ut_smartctlNames.append(name);
+}
+
+TEST_F(ThreadPoolTask_UT, ThreadPoolTask_UT_smartctlDisks)
+{
+    // 热插拔时只读取指定的硬盘
+    Stub stub;
+    stub.set(ADDR(ThreadPoolTask, loadSmartCtlDevice), ut_loadSmartCtlDevice);
+    ut_smartctlNames.clear();
+
+    ThreadPoolTask *task = new ThreadPoolTask(QString("%1 sdb sdc").arg(CMD_SMARTCTL_DISKS), "smartctl_disks.txt", false, 500);
+    QThreadPool tp;
+    tp.start(task);
+    tp.waitForDone(-1);
+
+    ut_smartctlNames.sort();
+    EXPECT_EQ(ut_smartctlNames, QStringList() << "sdb" << "sdc");
+}
@@ -32,3 +32,46 @@ TEST_F(MonitorUsb_UT, MonitorUsb_UT_monitor)
     stub.set(ADDR(MonitorUsb, monitor), ut_monitor);
     m_monitor->monitor();
 }
+
+TEST_F(MonitorUsb_UT, MonitorUsb_UT_eventClasses)
+{
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ":080650:"), QStringList() << EVENT_CLASS_STORAGE);
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ":030102:030000:"), QStringList() << EVENT_CLASS_INPUT);
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ":e00101:"), QStringList() << EVENT_CLASS_BLUETOOTH);
+    EXPECT_EQ(MonitorUsb::eventClasses("bluetooth", "link", ""), QStringList() << EVENT_CLASS_BLUETOOTH);
+    // 复合设备取所有接口的类别
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ":030101:080650:"), QStringList() << EVENT_CLASS_STORAGE << EVENT_CLASS_INPUT);
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ":080650:e00101:"), QStringList() << EVENT_CLASS_STORAGE << EVENT_CLASS_BLUETOOTH);
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ":070102:020600:0a0000:"), QStringList() << EVENT_CLASS_PRINTER << EVENT_CLASS_NETWORK);
+    EXPECT_EQ(MonitorUsb::eventClasses("usb", "usb_device", ""), QStringList() << EVENT_CLASS_OTHER);
+    EXPECT_EQ(MonitorUsb::eventClasses("block", "disk", ""), QStringList() << EVENT_CLASS_STORAGE);
+}
+
+TEST_F(MonitorUsb_UT, MonitorUsb_UT_isPhysicalDisk)
+{
+    EXPECT_TRUE(MonitorUsb::isPhysicalDisk("sdb"));
+    EXPECT_TRUE(MonitorUsb::isPhysicalDisk("nvme1n1"));
+    EXPECT_FALSE(MonitorUsb::isPhysicalDisk("loop3"));
+    EXPECT_FALSE(MonitorUsb::isPhysicalDisk("zram0"));
+    EXPECT_FALSE(MonitorUsb::isPhysicalDisk(""));
+}
+
+TEST_F(MonitorUsb_UT, MonitorUsb_UT_windowDisks)
+{
+    // 同一窗口内插入的硬盘一起发出
+    QStringList classes, disks;
+    QObject::connect(m_monitor, &MonitorUsb::usbChanged, [&](const QStringList &eventClasses, const QStringList &changedDisks) {
+        classes = eventClasses;
+        disks = changedDisks;
+    });
+    m_monitor->pushEvent(QStringList() << EVENT_CLASS_STORAGE, "sdb");
+    m_monitor->pushEvent(QStringList() << EVENT_CLASS_STORAGE, "sdb");
+    m_monitor->pushEvent(QStringList() << EVENT_CLASS_INPUT);
+    m_monitor->slotTimeout();
+    EXPECT_TRUE(disks.isEmpty());
+
+    m_monitor->m_LastEventTime -= COALESCE_WINDOW;
+    m_monitor->slotTimeout();
+    EXPECT_EQ(classes, QStringList() << EVENT_CLASS_STORAGE << EVENT_CLASS_INPUT);
+    EXPECT_EQ(disks, QStringList() << "sdb");
+}
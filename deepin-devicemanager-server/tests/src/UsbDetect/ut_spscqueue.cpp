@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <QThread>
+#include <QDateTime>
+
+#define private public // hack complier
+#define protected public
+
+#include "monitorusb.h"
+
+#undef private
+#undef protected
+#include "mainjob.h"
+#include "../ut_Head.h"
+
+class SpscQueue_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_monitor = new MonitorUsb;
+        m_monitor->mp_Timer->stop();
+    }
+    void TearDown()
+    {
+        delete m_monitor;
+    }
+    MonitorUsb *m_monitor = nullptr;
+};
+
+TEST_F(SpscQueue_UT, SpscQueue_UT_bounded)
+{
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(i));
+    // 队列满时不阻塞
+    EXPECT_FALSE(queue.push(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST_F(SpscQueue_UT, SpscQueue_UT_threads)
+{
+    // 生产者与消费者在不同线程时顺序不变且不丢失
+    SpscQueue<int, 64> queue;
+    const int count = 100000;
+    QThread *producer = QThread::create([&queue, count]() {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.push(i))
+                QThread::yieldCurrentThread();
+        }
+    });
+    producer->start();
+
+    int expected = 0;
+    int value = 0;
+    while (expected < count) {
+        if (!queue.pop(value))
+            continue;
+        EXPECT_EQ(value, expected);
+        ++expected;
+    }
+    producer->wait();
+    delete producer;
+}
+
+TEST_F(SpscQueue_UT, SpscQueue_UT_coalesce)
+{
+    int emitted = 0;
+    QStringList classes;
+    QObject::connect(m_monitor, &MonitorUsb::usbChanged, [&emitted, &classes](const QStringList &eventClasses) {
+        ++emitted;
+        classes = eventClasses;
+    });
+
+    // 一次插入多个设备只发出一次变化
+    for (int i = 0; i < 10; ++i)
+        m_monitor->pushEvent(QStringList() << (i % 2 ? EVENT_CLASS_STORAGE : EVENT_CLASS_INPUT));
+    m_monitor->slotTimeout();
+    EXPECT_EQ(emitted, 0);
+
+    m_monitor->m_LastEventTime -= COALESCE_WINDOW;
+    m_monitor->slotTimeout();
+    EXPECT_EQ(emitted, 1);
+    EXPECT_EQ(classes.size(), 2);
+    EXPECT_TRUE(classes.contains(EVENT_CLASS_STORAGE));
+
+    QVariantMap statistics = m_monitor->statistics();
+    EXPECT_EQ(statistics["received"].toULongLong(), 10u);
+    EXPECT_EQ(statistics["coalesced"].toULongLong(), 9u);
+    EXPECT_EQ(statistics["refreshes"].toULongLong(), 1u);
+    EXPECT_EQ(statistics["dropped"].toULongLong(), 0u);
+}
+
+TEST_F(SpscQueue_UT, SpscQueue_UT_overflow)
+{
+    QStringList classes;
+    QObject::connect(m_monitor, &MonitorUsb::usbChanged, [&classes](const QStringList &eventClasses) {
+        classes = eventClasses;
+    });
+
+    // 队列溢出时按全部更新处理
+    for (int i = 0; i < EVENT_QUEUE_SIZE + 10; ++i)
+        m_monitor->pushEvent(QStringList() << EVENT_CLASS_STORAGE);
+    EXPECT_EQ(m_monitor->statistics()["dropped"].toULongLong(), 10u);
+
+    m_monitor->slotTimeout();
+    m_monitor->m_LastEventTime -= COALESCE_WINDOW;
+    m_monitor->slotTimeout();
+    EXPECT_TRUE(classes.contains(EVENT_CLASS_ALL));
+    EXPECT_TRUE(MainJob::hotplugKeys(classes).isEmpty());
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "usbenumerator.h"
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+
+#include <QCryptographicHash>
+
+class UsbEnumerator_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_enumerator = new UsbEnumerator;
+    }
+    void TearDown()
+    {
+        delete m_enumerator;
+    }
+    UsbEnumerator *m_enumerator = nullptr;
+};
+
+TEST_F(UsbEnumerator_UT, UsbEnumerator_UT_uniqueID)
+{
+    // 与 hwinfo --usb 解析结果的计算方式一致
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("Vendor", "usb 0x046d \"Logitech, Inc.\"");
+    mapInfo.insert("Device", "usb 0xc077 \"M105 Optical Mouse\"");
+    mapInfo.insert("SysFS ID", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0");
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(QByteArray("0x046dc077/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0"));
+    EXPECT_EQ(UsbEnumerator::uniqueID(mapInfo), QString::fromLatin1(hash.result().toBase64()));
+}
+
+TEST_F(UsbEnumerator_UT, UsbEnumerator_UT_enumerate)
+{
+    QMap<QString, QMap<QString, QString>> usbInfo;
+    m_enumerator->enumerate(usbInfo);
+    foreach (const QString &key, usbInfo.keys()) {
+        EXPECT_EQ(key, usbInfo[key]["Unique ID"]);
+        EXPECT_NE(usbInfo[key]["Hardware Class"], QString("hub"));
+    }
+}
+
+TEST_F(UsbEnumerator_UT, UsbEnumerator_UT_toHwinfoText)
+{
+    // 禁用及唤醒信息按 hwinfo --usb 的格式解析，单个设备的文本也需要满足
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("SysFS ID", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0");
+    mapInfo.insert("SysFS BusID", "1-2:1.0");
+    mapInfo.insert("Hotplug", "USB");
+    mapInfo.insert("Hardware Class", "mouse");
+    mapInfo.insert("Vendor", "usb 0x046d \"Logitech, Inc.\"");
+    mapInfo.insert("Device", "usb 0xc077 \"M105 Optical Mouse\"");
+    mapInfo.insert("Model", "\"Logitech, Inc. M105 Optical Mouse\"");
+    mapInfo.insert("Revision", "\"72.00\"");
+    mapInfo.insert("Speed", "1.5 Mbps");
+    mapInfo.insert("Unique ID", UsbEnumerator::uniqueID(mapInfo));
+
+    QString text = UsbEnumerator::toHwinfoText(mapInfo);
+    QStringList lines = text.split("\n");
+    EXPECT_TRUE(lines[0].startsWith("USB 1-2:1.0"));
+    EXPECT_GT(lines.size(), 10);
+    EXPECT_TRUE(lines.contains("  Hardware Class: mouse"));
+    EXPECT_TRUE(lines.contains("  SysFS ID: /devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0"));
+    EXPECT_FALSE(text.contains("\n\n"));
+}
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "mainjob.h"
+#include "deviceinfomanager.h"
+#include "monitorusb.h"
 #include "ut_Head.h"
 #include <gtest/gtest.h>
 #include "stub.h"
@@ -53,3 +55,47 @@ TEST_F(MainJob_UT, MainJob_UT_serverIsRunning)
 {
     m_mainJob->serverIsRunning();
 }
+
+TEST_F(MainJob_UT, MainJob_UT_hotplugKeys)
+{
+    // 插入鼠标不会重新获取硬盘信息
+    QStringList keys = MainJob::hotplugKeys(QStringList() << "input");
+    EXPECT_EQ(keys, QStringList() << "hwinfo");
+
+    // 插入硬盘只更新硬盘列表，SMART信息只读取插入的硬盘
+    keys = MainJob::hotplugKeys(QStringList() << "input" << "storage");
+    EXPECT_TRUE(keys.contains("lsblk_d"));
+    EXPECT_FALSE(keys.contains("smartctl_lsblk"));
+    EXPECT_FALSE(keys.contains("smartctl_sg"));
+    EXPECT_EQ(keys.count("hwinfo"), 1);
+
+    // 未知类别全部更新
+    EXPECT_TRUE(MainJob::hotplugKeys(QStringList() << "unknown").isEmpty());
+    EXPECT_TRUE(MainJob::hotplugKeys(QStringList()).isEmpty());
+}
+
+TEST_F(MainJob_UT, MainJob_UT_collectGeneration)
+{
+    // 每次采集发布一个新版本
+    quint64 generation = DeviceInfoManager::getInstance()->generation();
+    m_mainJob->slotUsbChanged();
+    EXPECT_EQ(DeviceInfoManager::getInstance()->generation(), generation + 1);
+}
+
+TEST_F(MainJob_UT, MainJob_UT_requestRefresh)
+{
+    quint64 generation = DeviceInfoManager::getInstance()->generation();
+    quint64 target = m_mainJob->requestRefresh();
+    EXPECT_EQ(target, generation + 1);
+    // 排队的刷新请求合并
+    EXPECT_EQ(m_mainJob->requestRefresh(), target);
+
+    // 刷新前已排队的热插拔采集改为全部采集，完成后即包含该刷新
+    m_mainJob->slotHotplugChanged(QStringList() << EVENT_CLASS_INPUT, QStringList());
+    EXPECT_FALSE(m_mainJob->m_RefreshPending);
+    EXPECT_EQ(DeviceInfoManager::getInstance()->generation(), target);
+
+    // 已被包含的刷新不再采集
+    m_mainJob->slotRefresh();
+    EXPECT_EQ(DeviceInfoManager::getInstance()->generation(), target);
+}
@@ -39,6 +39,7 @@ DeviceAudio::DeviceAudio()
 
 bool DeviceAudio::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromHwinfo start";
     if (mapInfo.find("path") != mapInfo.end()) {
         qCDebug(appLog) << "Path found in mapInfo, setting basic attributes.";
@@ -92,6 +93,7 @@ bool DeviceAudio::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceAudio::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     //1. 先判断传入的设备信息是否是该设备信息，根据总线信息来判断
     qCDebug(appLog) << "setInfoFromLshw start";
     if (!matchToLshw(mapInfo)) {
@@ -138,6 +140,7 @@ bool DeviceAudio::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceAudio::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceAudio::setInfoFromTomlOneByOne started.";
     TomlFixMethod ret = TOML_None;
 //  must cover the  loadOtherDeviceInfo
@@ -156,6 +159,7 @@ TomlFixMethod DeviceAudio::setInfoFromTomlOneByOne(const QMap<QString, QString>
 }
 bool DeviceAudio::setInfoFrom_sysFS(QMap<QString, QString> &mapInfo, int ii)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceAudio::setInfoFrom_sysFS started for card: " << ii;
     //4. get from cat /sys/class/sound
     QString hwCxDx;
@@ -234,6 +238,7 @@ bool DeviceAudio::setInfoFrom_sysFS(QMap<QString, QString> &mapInfo, int ii)
 
 bool DeviceAudio::setInfoFromCatDevices(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceAudio::setInfoFromCatDevices started.";
     //1. 获取设备的基本信息
     setAttribute(mapInfo, "Name", m_Name);
@@ -261,6 +266,7 @@ bool DeviceAudio::setInfoFromCatDevices(const QMap<QString, QString> &mapInfo)
 
 void DeviceAudio::setInfoFromCatAudio(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceAudio::setInfoFromCatAudio started.";
     //1. 获取设备的基本信息
     setAttribute(mapInfo, "Name", m_Name);
@@ -276,6 +282,7 @@ void DeviceAudio::setInfoFromCatAudio(const QMap<QString, QString> &mapInfo)
 
 bool DeviceAudio::setAudioChipFromDmesg(const QString &info)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceAudio::setAudioChipFromDmesg started with info: " << info;
     // 设置声卡芯片型号
     m_Chip = info;
@@ -318,6 +325,7 @@ const QString &DeviceAudio::uniqueID() const
 }
 EnableDeviceStatus DeviceAudio::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceAudio::setEnable called with status: " << e;
     if (!m_SysPath.contains("usb")) {
         qCDebug(appLog) << "SysPath does not contain 'usb', setting UniqueID to Name.";
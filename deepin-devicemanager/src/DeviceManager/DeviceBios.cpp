@@ -24,6 +24,7 @@ DeviceBios::DeviceBios()
 
 TomlFixMethod DeviceBios::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBios::setInfoFromTomlOneByOne started.";
     TomlFixMethod ret = TOML_None;
 
@@ -42,6 +43,7 @@ TomlFixMethod DeviceBios::setInfoFromTomlOneByOne(const QMap<QString, QString> &
 
 bool DeviceBios::setBiosInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting BIOS info";
 
     if (mapInfo.size() < 2) {
@@ -64,6 +66,7 @@ bool DeviceBios::setBiosInfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceBios::setBiosLanguageInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting bios language info";
     getOtherMapInfo(mapInfo);
     return true;
@@ -71,6 +74,7 @@ bool DeviceBios::setBiosLanguageInfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceBios::setBaseBoardInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting base board info";
 
     if (mapInfo.size() < 2) {
@@ -100,6 +104,7 @@ bool DeviceBios::setBaseBoardInfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceBios::setSystemInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBios::setSystemInfo started.";
     if (mapInfo.size() < 2) {
         qCDebug(appLog) << "mapInfo size less than 2, returning false.";
@@ -121,6 +126,7 @@ bool DeviceBios::setSystemInfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceBios::setChassisInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBios::setChassisInfo started.";
     if (mapInfo.size() < 2) {
         qCDebug(appLog) << "mapInfo size less than 2, returning false.";
@@ -142,6 +148,7 @@ bool DeviceBios::setChassisInfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceBios::setMemoryInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBios::setMemoryInfo started.";
     if (mapInfo.size() < 2) {
         qCDebug(appLog) << "mapInfo size less than 2, returning false.";
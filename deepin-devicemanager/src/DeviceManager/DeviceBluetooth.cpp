@@ -35,6 +35,7 @@ DeviceBluetooth::DeviceBluetooth()
 
 void DeviceBluetooth::setInfoFromHciconfig(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBluetooth::setInfoFromHciconfig started.";
     // 获取设备的基本信息
     setAttribute(mapInfo, "Name", m_Name);
@@ -50,6 +51,7 @@ void DeviceBluetooth::setInfoFromHciconfig(const QMap<QString, QString> &mapInfo
 
 bool DeviceBluetooth::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting bluetooth info from hwinfo";
 
     if (mapInfo.find("path") != mapInfo.end()) {
@@ -108,6 +110,7 @@ bool DeviceBluetooth::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceBluetooth::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting bluetooth info from lshw";
 
     // 根据 总线信息 与 设备信息中的唯一key值 判断是否是同一台设备
@@ -137,6 +140,7 @@ bool DeviceBluetooth::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceBluetooth::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBluetooth::setInfoFromTomlOneByOne started.";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息
@@ -163,6 +167,7 @@ TomlFixMethod DeviceBluetooth::setInfoFromTomlOneByOne(const QMap<QString, QStri
 
 bool DeviceBluetooth::setInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBluetooth::setInfoFromWifiInfo started.";
     // 机器自身蓝牙
     const QList<QPair<QString, QString> > &otherAttribs = getOtherAttribs();
@@ -217,6 +222,7 @@ const QString DeviceBluetooth::getOverviewInfo()
 
 EnableDeviceStatus DeviceBluetooth::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBluetooth::setEnable called with status: " << e;
     if (m_SerialID.isEmpty()) {
         qCWarning(appLog) << "SerialID is empty, returning EDS_NoSerial.";
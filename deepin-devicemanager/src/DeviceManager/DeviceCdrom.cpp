@@ -23,6 +23,7 @@ DeviceCdrom::DeviceCdrom()
 
 bool DeviceCdrom::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting CDROM info from lshw";
 
     // 通过总线信息判断是否是同一台设备
@@ -51,6 +52,7 @@ bool DeviceCdrom::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceCdrom::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceCdrom::setInfoFromTomlOneByOne started.";
     TomlFixMethod ret = TOML_None;
     ret = setTomlAttribute(mapInfo, "Model", m_Type);
@@ -67,6 +69,7 @@ TomlFixMethod DeviceCdrom::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 void DeviceCdrom::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting CDROM info from hwinfo";
 
     // 获取设备的基本信息
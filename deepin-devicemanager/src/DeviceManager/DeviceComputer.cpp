@@ -24,6 +24,7 @@ DeviceComputer::DeviceComputer()
 
 TomlFixMethod DeviceComputer::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting computer info from toml";
 
         TomlFixMethod ret = TOML_None;
@@ -61,6 +62,7 @@ const QString &DeviceComputer::driver() const
 
 void DeviceComputer::setHomeUrl(const QString &value)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceComputer::setHomeUrl called with value: " << value;
     // 设置主页网站
     m_HomeUrl = value;
@@ -68,6 +70,7 @@ void DeviceComputer::setHomeUrl(const QString &value)
 
 void DeviceComputer::setOsDescription(const QString &value)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceComputer::setOsDescription called with value: " << value;
     // 设置操作系统描述
     m_OsDescription = value;
@@ -75,6 +78,7 @@ void DeviceComputer::setOsDescription(const QString &value)
 
 void DeviceComputer::setOS(const QString &value)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceComputer::setOS called with value: " << value;
     // 设置操作系统
     m_OS = value;
@@ -82,6 +86,7 @@ void DeviceComputer::setOS(const QString &value)
 
 void DeviceComputer::setVendor(const QString &value)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceComputer::setVendor called with value: " << value;
     // 设置制造商
     m_Vendor = value;
@@ -89,6 +94,7 @@ void DeviceComputer::setVendor(const QString &value)
 
 void DeviceComputer::setName(const QString &value)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceComputer::setName called with value: " << value;
     // 设置计算机名称
     m_Name = value;
@@ -101,6 +107,7 @@ void DeviceComputer::setName(const QString &value)
 
 void DeviceComputer::setType(const QString &value)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceComputer::setType called with value: " << value;
     // 设置设备类型
     m_Type = value;
@@ -108,6 +115,7 @@ void DeviceComputer::setType(const QString &value)
 
 void DeviceComputer::setVendor(const QString &dm1Vendor, const QString &dm2Vendor)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceComputer::setVendor (overload) called with dm1Vendor: " << dm1Vendor << ", dm2Vendor: " << dm2Vendor;
     // 设置制造商
     if (dm1Vendor.contains("System manufacturer")) {
@@ -122,6 +130,7 @@ void DeviceComputer::setVendor(const QString &dm1Vendor, const QString &dm2Vendo
 
 void DeviceComputer::setName(const QString &dm1Name, const QString &dm2Name, const QString &dm1Family, const QString &dm1Version)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceComputer::setName (overload) called with dm1Name: " << dm1Name << ", dm2Name: " << dm2Name << ", dm1Family: " << dm1Family << ", dm1Version: " << dm1Version;
     // name
     QString pname;
@@ -41,6 +41,7 @@ DeviceCpu::DeviceCpu()
 
 void DeviceCpu::setCpuInfo(const QMap<QString, QString> &mapLscpu, const QMap<QString, QString> &mapLshw, const QMap<QString, QString> &mapDmidecode, int coreNum, int logicalNum)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting CPU info";
 
     // 设置CPU信息
@@ -149,6 +150,7 @@ const QString DeviceCpu::getOverviewInfo()
 
 void DeviceCpu::setInfoFromLscpu(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Start setting CPU info from lscpu";
 
     // 设置CPU属性
@@ -216,6 +218,7 @@ void DeviceCpu::setInfoFromLscpu(const QMap<QString, QString> &mapInfo)
 
 void DeviceCpu::setCurFreq(const QString &curFreq)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceCpu::setCurFreq called with curFreq: " << curFreq;
     if (!curFreq.isEmpty()) {
         m_CurFrequency = curFreq;
@@ -225,12 +228,14 @@ void DeviceCpu::setCurFreq(const QString &curFreq)
 
 void DeviceCpu::setFrequencyIsCur(const bool &flag)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceCpu::setFrequencyIsCur called with flag: " << flag;
     m_FrequencyIsCur = flag;
 }
 
 void DeviceCpu::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceCpu::setInfoFromLshw started.";
     // longxin CPU型号不从lshw中获取
     // bug39874
@@ -259,6 +264,7 @@ void DeviceCpu::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceCpu::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceCpu::setInfoFromTomlOneByOne started.";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息
@@ -290,6 +296,7 @@ TomlFixMethod DeviceCpu::setInfoFromTomlOneByOne(const QMap<QString, QString> &m
 
 void DeviceCpu::setInfoFromDmidecode(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting CPU info from dmidecode";
     // longxin CPU型号不从dmidecode中获取
     // bug39874
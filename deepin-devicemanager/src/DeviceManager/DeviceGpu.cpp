@@ -75,6 +75,7 @@ void DeviceGpu::loadBaseDeviceInfo()
 
 void DeviceGpu::setLshwInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting LSHW info";
 
     // 判断是否是同一个gpu
@@ -115,6 +116,7 @@ void DeviceGpu::setLshwInfo(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceGpu::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceGpu::setInfoFromTomlOneByOne started.";
     TomlFixMethod ret = TOML_None;
     setTomlAttribute(mapInfo, "Model", m_Model);
@@ -147,6 +149,7 @@ TomlFixMethod DeviceGpu::setInfoFromTomlOneByOne(const QMap<QString, QString> &m
 
 bool DeviceGpu::setHwinfoInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting HWINFO info";
 
     // 设置属性
@@ -271,6 +274,7 @@ bool DeviceGpu::setHwinfoInfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceGpu::setXrandrInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceGpu::setXrandrInfo started.";
     // 设置分辨率属性
     m_MinimumResolution = mapInfo["minResolution"];
@@ -310,6 +314,7 @@ void DeviceGpu::setXrandrInfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceGpu::setDmesgInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting DMESG info";
 
     if (mapInfo.contains("BusID") && mapInfo["BusID"].size() >= m_HwinfoToLshw.size()
@@ -339,6 +344,7 @@ void DeviceGpu::setDmesgInfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceGpu::setGpuInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting GPU info";
 
     // 华为KLU和PanGuV机器中不需要显示以下信息
@@ -26,6 +26,7 @@ DeviceImage::DeviceImage()
 
 void DeviceImage::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromLshw";
     if (!matchToLshw(mapInfo)) {
         qCDebug(appLog) << "not match to lshw";
@@ -50,6 +51,7 @@ void DeviceImage::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceImage::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromTomlOneByOne";
 
     TomlFixMethod ret = TOML_None;
@@ -71,6 +73,7 @@ TomlFixMethod DeviceImage::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 void DeviceImage::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromHwinfo";
 
     if (mapInfo.find("unique_id") != mapInfo.end()) {
@@ -157,6 +160,7 @@ const QString DeviceImage::getOverviewInfo()
 
 EnableDeviceStatus DeviceImage::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceImage::setEnable called with status: " << e;
     if (m_SerialID.isEmpty()) {
         qCWarning(appLog) << "SerialID is empty, returning EDS_NoSerial.";
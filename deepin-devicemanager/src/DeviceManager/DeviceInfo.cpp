@@ -7,6 +7,7 @@
 #include "commonfunction.h"
 #include "commondefine.h"
 #include"DeviceManager.h"
+#include "KernelModuleInfo.h"
 #include "DDLog.h"
 
 #include <DApplication>
@@ -15,6 +16,8 @@
 #include <QProcess>
 #include <QMap>
 #include <QRegularExpression>
+#include <QLocale>
+#include <QHash>
 using namespace DDLog;
 
 DWIDGET_USE_NAMESPACE
@@ -37,6 +40,9 @@ DeviceBaseInfo::DeviceBaseInfo(QObject *parent)
     , m_Index(0)
     , m_forcedDisplay(false)
     , m_Driver("")
+    , m_BaseInfoDirty(true)
+    , m_OtherInfoDirty(true)
+    , m_TableDataDirty(true)
 {
     qCDebug(appLog) << "DeviceBaseInfo constructor initialized.";
 }
@@ -49,20 +55,28 @@ DeviceBaseInfo::~DeviceBaseInfo()
 const QList<QPair<QString, QString>> &DeviceBaseInfo::getOtherAttribs()
 {
     qCDebug(appLog) << "DeviceBaseInfo::getOtherAttribs called.";
-    // 获取其他设备信息列表
-    m_LstOtherInfo.clear();
-    loadOtherDeviceInfo();
-    qCDebug(appLog) << "Other attributes loaded. Count: " << m_LstOtherInfo.count();
+    // 获取其他设备信息列表，设备信息变化后才重新加载
+    checkAttribsLocale();
+    if (m_OtherInfoDirty) {
+        m_LstOtherInfo.clear();
+        loadOtherDeviceInfo();
+        m_OtherInfoDirty = false;
+        qCDebug(appLog) << "Other attributes loaded. Count: " << m_LstOtherInfo.count();
+    }
     return m_LstOtherInfo;
 }
 
 const QList<QPair<QString, QString> > &DeviceBaseInfo::getBaseAttribs()
 {
     qCDebug(appLog) << "DeviceBaseInfo::getBaseAttribs called.";
-    // 获取基本信息列表
-    m_LstBaseInfo.clear();
-    loadBaseDeviceInfo();
-    qCDebug(appLog) << "Base attributes loaded. Count: " << m_LstBaseInfo.count();
+    // 获取基本信息列表，设备信息变化后才重新加载
+    checkAttribsLocale();
+    if (m_BaseInfoDirty) {
+        m_LstBaseInfo.clear();
+        loadBaseDeviceInfo();
+        m_BaseInfoDirty = false;
+        qCDebug(appLog) << "Base attributes loaded. Count: " << m_LstBaseInfo.count();
+    }
     return m_LstBaseInfo;
 }
 
@@ -82,10 +96,14 @@ const QStringList &DeviceBaseInfo::getTableHeader()
 const QStringList &DeviceBaseInfo::getTableData()
 {
     qCDebug(appLog) << "DeviceBaseInfo::getTableData called.";
-    // 获取表格数据
-    m_TableData.clear();
-    loadTableData();
-    qCDebug(appLog) << "Table data loaded. Count: " << m_TableData.count();
+    // 获取表格数据，设备信息变化后才重新加载
+    checkAttribsLocale();
+    if (m_TableDataDirty) {
+        m_TableData.clear();
+        loadTableData();
+        m_TableDataDirty = false;
+        qCDebug(appLog) << "Table data loaded. Count: " << m_TableData.count();
+    }
     return m_TableData;
 }
 
@@ -179,379 +197,22 @@ bool DeviceBaseInfo::isValueValid(QString &value)
 
 void DeviceBaseInfo::setForcedDisplay(const bool &flag)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBaseInfo::setForcedDisplay called with flag: " << flag;
     m_forcedDisplay = flag;
     qCDebug(appLog) << "m_forcedDisplay set to: " << m_forcedDisplay;
 }
 
-void DeviceBaseInfo::toHtmlString(QDomDocument &doc)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::toHtmlString called.";
-    // 设备信息转为Html
-    baseInfoToHTML(doc, m_LstBaseInfo);
-    baseInfoToHTML(doc, m_LstOtherInfo);
-    qCDebug(appLog) << "HTML string conversion finished.";
-}
-
-void DeviceBaseInfo::baseInfoToHTML(QDomDocument &doc, QList<QPair<QString, QString> > &infoLst)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::baseInfoToHTML called for info list.";
-    // 设备信息转为HTML
-    QDomElement table = doc.createElement("table");
-    table.setAttribute("border", "0");
-    table.setAttribute("width", "100%");
-    table.setAttribute("cellpadding", "3");
-    qCDebug(appLog) << "HTML table element created.";
-
-    // 添加HTML表格内容
-    foreach (auto info, infoLst) {
-        if (isValueValid(info.second)) {
-            // qCDebug(appLog) << "Adding valid info to HTML table: " << info.first << ": " << info.second;
-            QDomElement tr = doc.createElement("tr");
-
-            // 第一列
-            QDomElement td = doc.createElement("td");
-            td.setAttribute("width", "15%");
-            td.setAttribute("style", "text-align:left;");
-
-            QDomText nameText = doc.createTextNode(info.first + ": ");
-            td.appendChild(nameText);
-            tr.appendChild(td);
-
-            // 第二列
-            QDomElement td2 = doc.createElement("td");
-            td2.setAttribute("width", "85%");
-
-            QDomText valueText;
-            valueText = doc.createTextNode(info.second);
-            td2.appendChild(valueText);
-
-            tr.appendChild(td2);
-
-            table.appendChild(tr);
-        }
-
-        doc.appendChild(table);
-    }
-    qCDebug(appLog) << "Finished adding items to HTML table.";
-}
-
-void DeviceBaseInfo::subTitleToHTML(QDomDocument &doc)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::subTitleToHTML called.";
-    // 子标题转为HTML格式
-    if (false == this->subTitle().isEmpty()) {
-        qCDebug(appLog) << "Subtitle is not empty, adding to HTML: " << this->subTitle();
-        QDomElement h3 = doc.createElement("h3");
-        QDomText valueText = doc.createTextNode(this->subTitle());
-        h3.appendChild(valueText);
-        doc.appendChild(h3);
-    } else {
-        qCDebug(appLog) << "Subtitle is empty, skipping HTML addition.";
-    }
-}
-
-void DeviceBaseInfo::toDocString(Docx::Document &doc)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::toDocString called.";
-    // 设备信息转为doc
-    baseInfoToDoc(doc, m_LstBaseInfo);
-    baseInfoToDoc(doc, m_LstOtherInfo);
-    qCDebug(appLog) << "Doc string conversion finished.";
-}
-
-void DeviceBaseInfo::baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QString> > &infoLst)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::baseInfoToDoc called for info list.";
-    // 设备信息保存为Doc
-    foreach (auto item, infoLst) {
-        QString value = item.second;
-
-        // 判断属性值是否有效
-        if (false == isValueValid(value)) {
-            // qCDebug(appLog) << "Skipping invalid info for Doc: " << item.first << ": " << item.second;
-            continue;
-        }
-
-        // 添加doc段落
-        QString line = item.first + ":  " + item.second;
-        doc.addParagraph(line);
-        // qCDebug(appLog) << "Added paragraph to Doc: " << line;
-    }
-    qCDebug(appLog) << "Finished adding items to Doc.";
-}
-
-void DeviceBaseInfo::toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::toXlsxString called.";
-    // 设备信息转为xlxs表格
-    baseInfoToXlsx(xlsx, boldFont, m_LstBaseInfo);
-    baseInfoToXlsx(xlsx, boldFont, m_LstOtherInfo);
-    qCDebug(appLog) << "Xlsx string conversion finished.";
-}
-
-void DeviceBaseInfo::baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString> > &infoLst)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::baseInfoToXlsx called for info list.";
-    // 设置表格内容字体不加粗,字号10
-    boldFont.setFontBold(false);
-    boldFont.setFontSize(10);
-    qCDebug(appLog) << "Xlsx format set: bold=" << boldFont.fontBold() << ", size=" << boldFont.fontSize();
-
-    foreach (auto item, infoLst) {
-        QString value = item.second;
-
-        // 判断属性值是否有效
-        if (false == isValueValid(value)) {
-            // qCDebug(appLog) << "Skipping invalid info for Xlsx: " << item.first << ": " << item.second;
-            continue;
-        }
-
-        // 获取行数
-        int _row = DeviceManager::instance()->currentXlsRow();
-        xlsx.write(_row, 1, item.first, boldFont);
-        xlsx.write(_row, 2, item.second, boldFont);
-        // qCDebug(appLog) << "Written to Xlsx at row " << _row << ": " << item.first << " = " << item.second;
-    }
-    qCDebug(appLog) << "Finished writing items to Xlsx.";
-}
-
-void DeviceBaseInfo::toTxtString(QTextStream &out)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::toTxtString called.";
-    // 设备信息转为txt
-    baseInfoToTxt(out, m_LstBaseInfo);
-    baseInfoToTxt(out, m_LstOtherInfo);
-    qCDebug(appLog) << "Txt string conversion finished.";
-}
-
-void DeviceBaseInfo::baseInfoToTxt(QTextStream &out, QList<QPair<QString, QString> > &infoLst)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::baseInfoToTxt called for info list.";
-    foreach (auto item, infoLst) {
-        QString value = item.second;
-
-        // 判断属性值是否有效
-        if (false == isValueValid(value)) {
-            // qCDebug(appLog) << "Skipping invalid info for Txt: " << item.first << ": " << item.second;
-            continue;
-        }
-
-        // 设置第一列占21个字符
-        out.setFieldWidth(21);
-        out.setFieldAlignment(QTextStream::FieldAlignment::AlignLeft);
-        out << item.first + ": ";
-        out.setFieldWidth(0);
-        out << item.second;
-        out << "\n";
-        // qCDebug(appLog) << "Written to Txt: " << item.first << " = " << item.second;
-    }
-    qCDebug(appLog) << "Finished writing items to Txt.";
-}
-
-void DeviceBaseInfo::tableInfoToTxt(QTextStream &out)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableInfoToTxt called.";
-    // 获取表格内容
-    getTableData();
-
-    // 判断是否有表格内容
-    if (m_TableData.size() < 1) {
-        qCDebug(appLog) << "Table data is empty, skipping Txt conversion.";
-        return;
-    }
-
-    // 设置占位宽度
-    QString text = m_TableData[0];
-    out.setFieldWidth(int(text.size() * 1.5));
-    out.setFieldAlignment(QTextStream::FieldAlignment::AlignRight);
-    qCDebug(appLog) << "Txt field width set for table info.";
-
-    foreach (auto item, m_TableData) {
-        out.setFieldWidth(28);
-        out << item;
-        // qCDebug(appLog) << "Written table item to Txt: " << item;
-    }
-
-    out.setFieldWidth(0);
-    out << "\n";
-    qCDebug(appLog) << "Finished writing table info to Txt.";
-}
-
-void DeviceBaseInfo::tableHeaderToTxt(QTextStream &out)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableHeaderToTxt called.";
-    // 获取表头
-    getTableHeader();
-
-    // 判断是否有表头
-    if (m_TableHeader.size() < 1) {
-        qCDebug(appLog) << "Table header is empty, skipping Txt conversion.";
-        return;
-    }
-
-    // 设置占位宽度
-    QString text = m_TableHeader[0];
-    out.setFieldWidth(int(text.size() * 1.5));
-    out.setFieldAlignment(QTextStream::FieldAlignment::AlignLeft);
-    qCDebug(appLog) << "Txt field width set for table header.";
-
-    out << "\n";
-    for (int col = 0; col < m_TableHeader.size() - 1; ++col) {
-        out.setFieldWidth(30);
-        out << m_TableHeader[col];
-        // qCDebug(appLog) << "Written table header item to Txt: " << m_TableHeader[col];
-    }
-    out.setFieldWidth(0);
-    out << "\n";
-    qCDebug(appLog) << "Finished writing table header to Txt.";
-}
-
-void DeviceBaseInfo::tableInfoToHtml(QFile &html)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableInfoToHtml called.";
-    // 获取表格内容
-    getTableData();
-
-    // 判断是否有表格内容
-    if (m_TableData.size() < 1) {
-        qCDebug(appLog) << "Table data is empty, skipping HTML table info conversion.";
-        return;
-    }
-
-    // 写表格内容
-    foreach (auto item, m_TableData) {
-        html.write(QString("<td style=\"width:200px;text-align:left;\">" + item + "</td>").toUtf8().data());
-        // qCDebug(appLog) << "Written table info item to HTML: " << item;
-    }
-
-    html.write("</tr>\n");
-    qCDebug(appLog) << "Finished writing table info to HTML.";
-}
-
-void DeviceBaseInfo::tableHeaderToHtml(QFile &html)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableHeaderToHtml called.";
-    // 获取表头信息
-    getTableHeader();
-
-    // 判断是否有表头
-    if (m_TableHeader.size() < 1) {
-        qCDebug(appLog) << "Table header is empty, skipping HTML table header conversion.";
-        return;
-    }
-
-    html.write("<thead><tr>\n");
-    qCDebug(appLog) << "Written HTML table header start tags.";
-
-    // 写表头内容
-    for (int col = 0; col < m_TableHeader.size() - 1; ++col) {
-        html.write(QString("<th style=\"width:200px;text-align:left; white-space:pre;\">" + m_TableHeader[col] + "</th>").toUtf8().data());
-        // qCDebug(appLog) << "Written table header item to HTML: " << m_TableHeader[col];
-    }
-
-    html.write("</tr></thead>\n");
-    qCDebug(appLog) << "Finished writing table header to HTML.";
-}
-
-void DeviceBaseInfo::tableInfoToDoc(Docx::Table *tab, int &row)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableInfoToDoc called with row: " << row;
-    // 表格信息保存为Doc
-    if (nullptr == tab) {
-        qCDebug(appLog) << "Table pointer is null, returning.";
-        return;
-    }
-
-    // 获取表格数据
-    getTableData();
-
-    if (m_TableData.size() < 1) {
-        qCDebug(appLog) << "Table data is empty, skipping Doc table info conversion.";
-        return;
-    }
-
-    // 添加doc表格
-    for (int col = 0; col < m_TableData.size(); ++col) {
-        auto cel = tab->cell(row, col);
-        cel->addText(m_TableData[col]);
-        // qCDebug(appLog) << "Added table info to Doc cell (" << row << ", " << col << "): " << m_TableData[col];
-    }
-    qCDebug(appLog) << "Finished adding table info to Doc.";
-}
-
-void DeviceBaseInfo::tableHeaderToDoc(Docx::Table *tab)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableHeaderToDoc called.";
-    // 表头保存为doc
-    getTableHeader();
-
-    if (m_TableHeader.size() < 1) {
-        qCDebug(appLog) << "Table header is empty, skipping Doc table header conversion.";
-        return;
-    }
-
-    // 添加表头信息
-    for (int col = 0; col < m_TableHeader.size() - 1; ++col)  {
-        tab->addColumn();
-        auto cel = tab->cell(0, col);
-        cel->addText(m_TableHeader[col]);
-        // qCDebug(appLog) << "Added table header to Doc cell (0, " << col << "): " << m_TableHeader[col];
-    }
-    qCDebug(appLog) << "Finished adding table header to Doc.";
-}
-
-void DeviceBaseInfo::tableInfoToXlsx(QXlsx::Document &xlsx)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableInfoToXlsx called.";
-    // 获取表格信息
-    getTableData();
-
-    if (m_TableData.size() < 1) {
-        qCDebug(appLog) << "Table data is empty, skipping Xlsx table info conversion.";
-        return;
-    }
-
-    // 添加表格信息
-    int curRow = DeviceManager::instance()->currentXlsRow();
-    for (int col = 0; col < m_TableData.size(); ++col) {
-        xlsx.write(curRow, col + 1, m_TableData[col]);
-        // qCDebug(appLog) << "Written table info to Xlsx at row " << curRow << ", col " << col + 1 << ": " << m_TableData[col];
-    }
-    qCDebug(appLog) << "Finished writing table info to Xlsx.";
-}
-
-void DeviceBaseInfo::tableHeaderToXlsx(QXlsx::Document &xlsx)
-{
-    qCDebug(appLog) << "DeviceBaseInfo::tableHeaderToXlsx called.";
-    // 获取表头
-    getTableHeader();
-
-    if (m_TableHeader.size() < 1) {
-        qCDebug(appLog) << "Table header is empty, skipping Xlsx table header conversion.";
-        return;
-    }
-
-    // 添加表头信息
-    int curRow = DeviceManager::instance()->currentXlsRow();
-    for (int col = 0; col < m_TableHeader.size() - 1; ++col) {
-        QXlsx::Format boldFont;
-        boldFont.setFontSize(10);
-        boldFont.setFontBold(true);
-        xlsx.write(curRow, col + 1, m_TableHeader[col], boldFont);
-        // qCDebug(appLog) << "Written table header to Xlsx at row " << curRow << ", col " << col + 1 << ": " << m_TableHeader[col];
-    }
-    qCDebug(appLog) << "Finished writing table header to Xlsx.";
-}
-
 void DeviceBaseInfo::setOtherDeviceInfo(const QString &key, const QString &value)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceBaseInfo::setOtherDeviceInfo called for key: " << key << ", value: " << value;
     m_MapOtherInfo[key] = value;
 }
 
 TomlFixMethod DeviceBaseInfo::setInfoFromTomlBase(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBaseInfo::setInfoFromTomlBase started.";
     TomlFixMethod ret = TOML_None;
     TomlFixMethod ret1 = TOML_None;
@@ -586,6 +247,7 @@ TomlFixMethod DeviceBaseInfo::setInfoFromTomlBase(const QMap<QString, QString> &
 
 EnableDeviceStatus DeviceBaseInfo::setEnable(bool e)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceBaseInfo::setEnable called with status: " << e;
     return EDS_Success;
 }
@@ -625,15 +287,15 @@ bool DeviceBaseInfo::driverIsKernelIn(const QString &driver)
         return false;
     }
 
-    // 判断lsmod是否能查询
-    QString outInfo = Common::executeClientCmd("modinfo", QStringList() << driver, QString(), -1);
-    bool isKernelIn = !outInfo.contains("filename:");
+    // 判断modinfo是否能查询，内建模块同样有 filename: (builtin)
+    bool isKernelIn = !KernelModuleInfo::instance()->info(driver).found;
     qCDebug(appLog) << "Driver: " << driver << ", modinfo output contains filename: " << !isKernelIn << ", returning: " << isKernelIn;
     return isKernelIn;
 }
 
 void DeviceBaseInfo::setCanEnale(bool can)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceBaseInfo::setCanEnale called with can: " << can;
     m_CanEnable = can;
     // qCDebug(appLog) << "m_CanEnable set to: " << m_CanEnable;
@@ -647,6 +309,7 @@ bool DeviceBaseInfo::canEnable()
 
 void DeviceBaseInfo::setEnableValue(bool e)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceBaseInfo::setEnableValue called with e: " << e;
     m_Enable = e;
     // qCDebug(appLog) << "m_Enable set to: " << m_Enable;
@@ -660,6 +323,7 @@ bool DeviceBaseInfo::canUninstall()
 
 void DeviceBaseInfo::setCanUninstall(bool can)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceBaseInfo::setCanUninstall called with can: " << can;
     m_CanUninstall = can;
     // qCDebug(appLog) << "m_CanUninstall set to: " << m_CanUninstall;
@@ -667,6 +331,7 @@ void DeviceBaseInfo::setCanUninstall(bool can)
 
 void DeviceBaseInfo::setHardwareClass(const QString &hclass)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceBaseInfo::setHardwareClass called with hclass: " << hclass;
     m_HardwareClass = hclass;
     // qCDebug(appLog) << "m_HardwareClass set to: " << m_HardwareClass;
@@ -732,25 +397,10 @@ const QString DeviceBaseInfo::getVendorOrModelId(const QString &sysPath, bool fl
 const QString DeviceBaseInfo::getDriverVersion()
 {
     qCDebug(appLog) << "DeviceBaseInfo::getDriverVersion called.";
-    QString outInfo = Common::executeClientCmd("modinfo", QStringList() << driver(), QString(), -1);
-    if(outInfo.isEmpty()) {
-        qCDebug(appLog) << "Modinfo output is empty, returning empty string.";
-        return  QString("");
-    }
-
-    foreach (QString out, outInfo.split("\n")) {
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-        QStringList item = out.split(":", QString::SkipEmptyParts);
-#else
-        QStringList item = out.split(":", Qt::SkipEmptyParts);
-#endif
-        if (!item.isEmpty() && "version" == item[0].trimmed()) {
-            // qCDebug(appLog) << "Found driver version: " << item[1].trimmed();
-            return item[1].trimmed();
-        }
-    }
-    qCDebug(appLog) << "Driver version not found, returning empty string.";
-    return QString("");
+    QString version = KernelModuleInfo::instance()->info(driver()).version;
+    if (version.isEmpty())
+        qCDebug(appLog) << "Driver version not found, returning empty string.";
+    return version;
 }
 
 const QString DeviceBaseInfo::getOverviewInfo()
@@ -802,10 +452,22 @@ void DeviceBaseInfo::addFilterKey(const QString &key)
 void DeviceBaseInfo::getOtherMapInfo(const QMap<QString, QString> &mapInfo)
 {
     // qCDebug(appLog) << "DeviceBaseInfo::getOtherMapInfo called.";
+    // 属性名的翻译按语言缓存，设备在多个线程中生成，每个线程一份，不需要加锁
+    static thread_local QString translatedLocale;
+    static thread_local QHash<QString, QString> translatedKeys;
+    QString locale = QLocale().name();
+    if (translatedLocale != locale) {
+        translatedKeys.clear();
+        translatedLocale = locale;
+    }
+
     // 获取其他设备信息
     QMap<QString, QString>::const_iterator it = mapInfo.begin();
     for (; it != mapInfo.end(); ++it) {
-        QString k = DApplication::translate("QObject", it.key().trimmed().toStdString().data());
+        QHash<QString, QString>::const_iterator translated = translatedKeys.constFind(it.key());
+        if (translated == translatedKeys.constEnd())
+            translated = translatedKeys.insert(it.key(), DApplication::translate("QObject", it.key().trimmed().toStdString().data()));
+        const QString &k = translated.value();
 
         // 可显示设备属性中存在该属性
         if (m_FilterKey.find(k) != m_FilterKey.end()) {
@@ -820,6 +482,24 @@ void DeviceBaseInfo::getOtherMapInfo(const QMap<QString, QString> &mapInfo)
     }
 }
 
+void DeviceBaseInfo::setAttribsDirty()
+{
+    m_BaseInfoDirty = true;
+    m_OtherInfoDirty = true;
+    m_TableDataDirty = true;
+}
+
+void DeviceBaseInfo::checkAttribsLocale()
+{
+    // 信息中包含翻译后的文字，语言变化后重新加载
+    QString locale = QLocale().name();
+    if (m_AttribsLocale != locale) {
+        qCDebug(appLog) << "Locale changed to" << locale << ", reload attributes.";
+        m_AttribsLocale = locale;
+        setAttribsDirty();
+    }
+}
+
 void DeviceBaseInfo::addBaseDeviceInfo(const QString &key, const QString &value)
 {
     qCDebug(appLog) << "DeviceBaseInfo::addBaseDeviceInfo called with key: " << key << ", value: " << value;
@@ -842,33 +522,36 @@ void DeviceBaseInfo::addOtherDeviceInfo(const QString &key, const QString &value
 
 void DeviceBaseInfo::setAttribute(const QMap<QString, QString> &mapInfo, const QString &key, QString &variable, bool overwrite)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBaseInfo::setAttribute called with key: " << key << ", overwrite: " << overwrite;
-    // map中存在该属性
-    if (mapInfo.find(key) == mapInfo.end()) {
+    // map中存在该属性，只查找一次
+    QMap<QString, QString>::const_iterator it = mapInfo.constFind(key);
+    if (it == mapInfo.constEnd()) {
         qCDebug(appLog) << "DeviceBaseInfo::setAttribute map does not contain key: " << key;
         return;
     }
 
     // 属性值不能为空
-    if (mapInfo[key] == "") {
+    const QString &value = it.value();
+    if (value.isEmpty()) {
         qCDebug(appLog) << "DeviceBaseInfo::setAttribute attribute value is empty";
         return;
     }
 
     // overwrite 为true直接覆盖
     if (overwrite) {
-        variable = mapInfo[key].trimmed();
+        variable = value.trimmed();
     } else {
         qCDebug(appLog) << "DeviceBaseInfo::setAttribute overwrite is false";
         // overwrite 为false,如果当前属性值为空或unknown时可覆盖
         if (variable.isEmpty()) {
             qCDebug(appLog) << "DeviceBaseInfo::setAttribute variable is empty, set value from map";
-            variable = mapInfo[key].trimmed();
+            variable = value.trimmed();
         }
 
         if (variable.contains("Unknown", Qt::CaseInsensitive)) {
             qCDebug(appLog) << "DeviceBaseInfo::setAttribute variable contains Unknown, set value from map";
-            variable = mapInfo[key].trimmed();
+            variable = value.trimmed();
         }
     }
     qCDebug(appLog) << "DeviceBaseInfo::setAttribute end";
@@ -876,6 +559,7 @@ void DeviceBaseInfo::setAttribute(const QMap<QString, QString> &mapInfo, const Q
 
 TomlFixMethod DeviceBaseInfo::setTomlAttribute(const QMap<QString, QString> &mapInfo, const QString &key, QString &variable, bool overwrite)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBaseInfo::setTomlAttribute called with key: " << key << ", overwrite: " << overwrite;
     // map中存在该属性
     if (mapInfo.find(key) == mapInfo.end()) {
@@ -923,6 +607,7 @@ void DeviceBaseInfo::mapInfoToList()
 
 void DeviceBaseInfo::setHwinfoLshwKey(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBaseInfo::setHwinfoLshwKey called";
     // 网卡使用物理地址+逻辑设备名作为匹配值
     if (mapInfo.find("HW Address") != mapInfo.end()) {
@@ -1031,6 +716,7 @@ bool DeviceBaseInfo::matchToLshw(const QMap<QString, QString> &mapInfo)
 
 void DeviceBaseInfo::setPhysIDMapKey(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceBaseInfo::setPhysIDMapKey called";
     if (mapInfo.find("VID_PID") != mapInfo.end()) {
         m_PhysIDMap = mapInfo["VID_PID"];
@@ -234,115 +234,6 @@ public:
      */
     void setForcedDisplay(const bool &flag);
 
-    /**
-     * @brief toHtmlString:导出信息为html格式
-     * @param doc xml格式文本
-     */
-    void toHtmlString(QDomDocument &doc);
-
-    /**
-     * @brief baseInfoToHTML:基本信息导出html
-     * @param doc:xml格式文本
-     * @param infoLst:信息列表
-     */
-    void baseInfoToHTML(QDomDocument &doc, QList<QPair<QString, QString>> &infoLst);
-
-    /**
-     * @brief subTitleToHTML:子标题导出
-     * @param doc:xml格式文本
-     */
-    void subTitleToHTML(QDomDocument &doc);
-
-    /**
-     * @brief toDocString:导出信息为html格式
-     * @param doc:doc文档
-     */
-    void toDocString(Docx::Document &doc);
-
-    /**
-     * @brief baseInfoToDoc:基本信息导出doc
-     * @param doc:doc文档
-     * @param infoLst:信息列表
-     */
-    void baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QString>> &infoLst);
-
-    /**
-     * @brief toXlsxString:导出信息为xlsx格式
-     * @param xlsx:xlsx文档
-     * @param boldFontc:字体格式
-     */
-    void toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont);
-
-    /**
-     * @brief baseInfoToXlsx:基本信息导出xlsx
-     * @param xlsx:xlsx文档
-     * @param boldFont:字体格式
-     * @param infoLst:信息列表
-     */
-    void baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString>> &infoLst);
-
-    /**
-     * @brief toTxtString:导出信息为txt格式
-     * @param out:文本输出流
-     */
-    void toTxtString(QTextStream &out);
-
-    /**
-     * @brief baseInfoToTxt:导出信息为txt格式
-     * @param out:文本输出流
-     * @param infoLst:信息列表
-     */
-    void baseInfoToTxt(QTextStream &out, QList<QPair<QString, QString>> &infoLst);
-
-    /**
-     * @brief tableInfoToTxt:表格内容写到txt
-     * @param out:txt文件流
-     */
-    void tableInfoToTxt(QTextStream &out);
-
-    /**
-     * @brief tableHeaderToTxt:表头信息写到txt
-     * @param out:txt文件流
-     */
-    void tableHeaderToTxt(QTextStream &out);
-
-    /**
-     * @brief tableInfoToHtml:表格内容写到html
-     * @param html:html文档
-     */
-    void tableInfoToHtml(QFile &html);
-
-    /**
-     * @brief tableHeaderToHtml:表头信息写到html
-     * @param html:html文档
-     */
-    void tableHeaderToHtml(QFile &html);
-
-    /**
-     * @brief tableInfoToDoc:表格信息写到doc
-     * @param tab:doc文档表格
-     * @param row:表格行数，第row行
-     */
-    void tableInfoToDoc(Docx::Table *tab, int &row);
-
-    /**
-     * @brief tableHeaderToDoc:表头信息写到doc
-     * @param tab doc文档的表格
-     */
-    void tableHeaderToDoc(Docx::Table *tab);
-
-    /**
-     * @brief tableInfoToXlsx:表格信息写到xlsx
-     * @param xlsx xlsx文件
-     */
-    void tableInfoToXlsx(QXlsx::Document &xlsx);
-
-    /**
-     * @brief tableHeaderToXlsx:表头信息写到xlsx
-     * @param xlsx xlsx文件
-     */
-    void tableHeaderToXlsx(QXlsx::Document &xlsx);
-
     /**
      * @brief setOtherDeviceInfo:设置其他信息信息
      * @param key:属性名称
@@ -408,6 +299,11 @@ protected:
      */
     void addOtherDeviceInfo(const QString &key, const QString &value);
 
+    /**
+     * @brief setAttribsDirty:设备信息变化，基本信息、其它信息和表格数据在下次获取时重新加载
+     */
+    void setAttribsDirty();
+
     /**@brief:将属性设置到成员变量*/
     /**
      * @brief setAttribute:将属性设置到成员变量
@@ -493,6 +389,15 @@ protected:
     QString            m_Driver;                  //<! 【驱动】
 
 private:
+    /**
+     * @brief checkAttribsLocale:语言变化时需要重新加载翻译后的信息
+     */
+    void checkAttribsLocale();
+
     QMap<QString, QString>  m_MapOtherInfo;         //<! 其它信息
+    bool                    m_BaseInfoDirty;        //<! 基本信息需要重新加载
+    bool                    m_OtherInfoDirty;       //<! 其它信息需要重新加载
+    bool                    m_TableDataDirty;       //<! 表格数据需要重新加载
+    QString                 m_AttribsLocale;        //<! 加载信息时的语言
 };
 #endif // DEVICEINFO_H
@@ -37,6 +37,7 @@ DeviceInput::DeviceInput()
 
 bool DeviceInput::setInfoFromlshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromlshw";
     // 根据bus info属性值与m_KeyToLshw对比,判断是否为同一设备
     if (!matchToLshw(mapInfo)) {
@@ -77,6 +78,7 @@ bool DeviceInput::setInfoFromlshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceInput::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromTomlOneByOne";
 
     TomlFixMethod ret = TOML_None;
@@ -97,6 +99,7 @@ TomlFixMethod DeviceInput::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 void DeviceInput::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setInfoFromHwinfo";
 
     //取触摸板的状态
@@ -184,6 +187,7 @@ void DeviceInput::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceInput::setKLUInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setKLUInfoFromHwinfo";
 
     // 设置设备基本属性
@@ -233,6 +237,7 @@ void DeviceInput::setKLUInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceInput::setInfoFromBluetoothctl()
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Entering setInfoFromBluetoothctl.";
     // 判断该设备信息是否存在于Bluetoothctl中
     if (isValueValid(m_keysToPairedDevice)) {
@@ -477,6 +482,7 @@ const QString DeviceInput::getOverviewInfo()
 
 EnableDeviceStatus DeviceInput::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "setEnable";
     if (m_Name.contains("Touchpad", Qt::CaseInsensitive)) {
         qCDebug(appLog) << "setEnable touchpad";
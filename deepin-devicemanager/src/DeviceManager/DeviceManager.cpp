@@ -10,6 +10,7 @@
 #include <QLoggingCategory>
 #include <QFile>
 #include <QMutexLocker>
+#include <QElapsedTimer>
 
 // 其它头文件
 #include "DeviceCpu.h"
@@ -29,19 +30,73 @@
 #include "DeviceComputer.h"
 #include "DeviceCdrom.h"
 #include "DeviceInput.h"
-#include "MacroDefinition.h"
+#include "TomlMatchIndex.h"
+#include "ExportWriter.h"
 #include <QRegularExpression>   
 #include <algorithm> // for std::sort
 
 using namespace DDLog;
 
 DeviceManager    *DeviceManager::sInstance = nullptr;
-int DeviceManager::m_CurrentXlsRow = 1;
+
+/**
+ * @brief The ExportSection struct : 导出的设备类型，按导出顺序排列
+ */
+struct ExportSection {
+    DeviceType  type;       //<! 设备类型
+    const char *title;      //<! 标题
+    const char *msg;        //<! 没有设备时的提示信息
+};
+
+static const ExportSection EXPORT_SECTIONS[] = {
+    {DT_Cpu, QT_TRANSLATE_NOOP("QObject", "CPU"), QT_TRANSLATE_NOOP("QObject", "No CPU found")},
+    {DT_Bios, QT_TRANSLATE_NOOP("QObject", "Motherboard"), QT_TRANSLATE_NOOP("QObject", "No motherboard found")},
+    {DT_Memory, QT_TRANSLATE_NOOP("QObject", "Memory"), QT_TRANSLATE_NOOP("QObject", "No memory found")},
+    {DT_Storage, QT_TRANSLATE_NOOP("QObject", "Storage"), QT_TRANSLATE_NOOP("QObject", "No disk found")},
+    {DT_Gpu, QT_TRANSLATE_NOOP("QObject", "Display Adapter"), QT_TRANSLATE_NOOP("QObject", "No GPU found")},
+    {DT_Monitor, QT_TRANSLATE_NOOP("QObject", "Monitor"), QT_TRANSLATE_NOOP("QObject", "No monitor found")},
+    {DT_Network, QT_TRANSLATE_NOOP("QObject", "Network Adapter"), QT_TRANSLATE_NOOP("QObject", "No network adapter found")},
+    {DT_Audio, QT_TRANSLATE_NOOP("QObject", "Sound Adapter"), QT_TRANSLATE_NOOP("QObject", "No audio device found")},
+    {DT_Bluetoorh, QT_TRANSLATE_NOOP("QObject", "Bluetooth"), QT_TRANSLATE_NOOP("QObject", "No Bluetooth device found")},
+    {DT_OtherPCI, QT_TRANSLATE_NOOP("QObject", "Other PCI Devices"), QT_TRANSLATE_NOOP("QObject", "No other PCI devices found")},
+    {DT_Power, QT_TRANSLATE_NOOP("QObject", "Power"), QT_TRANSLATE_NOOP("QObject", "No battery found")},
+    {DT_Keyboard, QT_TRANSLATE_NOOP("QObject", "Keyboard"), QT_TRANSLATE_NOOP("QObject", "No keyboard found")},
+    {DT_Mouse, QT_TRANSLATE_NOOP("QObject", "Mouse"), QT_TRANSLATE_NOOP("QObject", "No mouse found")},
+    {DT_Print, QT_TRANSLATE_NOOP("QObject", "Printer"), QT_TRANSLATE_NOOP("QObject", "No printer found")},
+    {DT_Image, QT_TRANSLATE_NOOP("QObject", "Camera"), QT_TRANSLATE_NOOP("QObject", "No camera found")},
+    {DT_Cdrom, QT_TRANSLATE_NOOP("QObject", "CD-ROM"), QT_TRANSLATE_NOOP("QObject", "No CD-ROM found")},
+    {DT_Others, QT_TRANSLATE_NOOP("QObject", "Other Devices"), QT_TRANSLATE_NOOP("QObject", "No other devices found")},
+};
+
+/**
+ * @brief validAttribs:过滤掉无效的属性值，导出时只写有效的属性
+ */
+static QList<QPair<QString, QString>> validAttribs(DeviceBaseInfo *device, const QList<QPair<QString, QString>> &attribs)
+{
+    QList<QPair<QString, QString>> lst;
+    for (const QPair<QString, QString> &item : attribs) {
+        QString value = item.second;
+        if (device->isValueValid(value))
+            lst.append(item);
+    }
+    return lst;
+}
 
 QMutex addCmdMutex;
 
+// 生成线程内暂存的设备，提交前只有本线程访问，不需要加锁
+struct StagingDevices {
+    DeviceType                          type = DT_Null;
+    QList<DeviceBaseInfo *>             list;
+    QHash<QString, DeviceBaseInfo *>    index;
+};
+static thread_local StagingDevices stagingDevices;
+
 DeviceManager::DeviceManager()
     : m_CpuNum(1)
+    , m_AddCmdWaitTime(0)
+    , m_GeneratingTypes(0)
+    , m_CmdInfoFrozen(false)
 {
     qCDebug(appLog) << "DeviceManager constructor initialized";
 }
@@ -57,7 +112,12 @@ void DeviceManager::clear()
     qCDebug(appLog) << "Starting to clear all device resources";
     
     // 清除所有命令
+    addCmdMutex.lock();
+    m_CmdInfoFrozen = false;
+    m_FrozenCmdInfo.clear();
     m_cmdInfo.clear();
+    addCmdMutex.unlock();
+    m_AddCmdWaitTime = 0;
 
     // 清除内存中的所有设备指针
     foreach (auto device, m_ListDeviceMouse)
@@ -133,6 +193,8 @@ void DeviceManager::clear()
     m_ListDeviceGPU.clear();
     m_ListDeviceMemory.clear();
     m_ListDeviceCPU.clear();
+    for (int i = 0; i <= DT_Others; ++i)
+        m_DeviceIndex[i].clear();
     m_DeviceClassMap.clear();
     qCDebug(appLog) << "All device resources cleared successfully";
 }
@@ -152,13 +214,13 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 添加cpu信息
-    if (m_ListDeviceCPU.size() > 0) {
+    if (hasDevice(DT_Cpu)) {
         qCDebug(appLog) << "Adding CPU information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("CPU"), "cpu##CPU"));
         addSeperator = true;
     }
 
-    if (m_CpuNum > 1) {
+    if (!isTypeGenerating(DT_Cpu) && m_CpuNum > 1) {
         qCDebug(appLog) << "Adding CPU quantity information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("CPU quantity"), ""));
         addSeperator = true;
@@ -171,43 +233,43 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 板载接口设备
-    if (m_ListDeviceBios.size() > 0) {
+    if (hasDevice(DT_Bios)) {
         qCDebug(appLog) << "Adding Motherboard information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Motherboard"), "motherboard##Bios"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceMemory.size() > 0) {
+    if (hasDevice(DT_Memory)) {
         qCDebug(appLog) << "Adding Memory information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Memory"), "memory##Memory"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceGPU.size() > 0) {
+    if (hasDevice(DT_Gpu)) {
         qCDebug(appLog) << "Adding Display Adapter information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Display Adapter"), "displayadapter##GPU"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceAudio.size() > 0) {
+    if (hasDevice(DT_Audio)) {
         qCDebug(appLog) << "Adding Sound Adapter information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Sound Adapter"), "audiodevice##Audio"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceStorage.size() > 0) {
+    if (hasDevice(DT_Storage)) {
         qCDebug(appLog) << "Adding Storage information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Storage"), "storage##Storage"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceOtherPCI.size() > 0) {
+    if (hasDevice(DT_OtherPCI)) {
         qCDebug(appLog) << "Adding Other PCI Devices information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Other PCI Devices"), "otherpcidevices##OtherPCI"));
         addSeperator = true;
     }
 
-    if (m_ListDevicePower.size() > 0) {
+    if (hasDevice(DT_Power)) {
         qCDebug(appLog) << "Adding Battery information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Battery"), "battery##Power"));
         addSeperator = true;
@@ -220,13 +282,13 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 网络设备
-    if (m_ListDeviceBluetooth.size() > 0) {
+    if (hasDevice(DT_Bluetoorh)) {
         qCDebug(appLog) << "Adding Bluetooth information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Bluetooth"), "bluetooth##Bluetooth"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceNetwork.size() > 0) {
+    if (hasDevice(DT_Network)) {
         qCDebug(appLog) << "Adding Network Adapter information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Network Adapter"), "networkadapter##Network"));
         addSeperator = true;
@@ -239,13 +301,13 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 输入设备
-    if (m_ListDeviceMouse.size() > 0) {
+    if (hasDevice(DT_Mouse)) {
         qCDebug(appLog) << "Adding Mouse information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Mouse"), "mouse##Mouse"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceKeyboard.size() > 0) {
+    if (hasDevice(DT_Keyboard)) {
         qCDebug(appLog) << "Adding Keyboard information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Keyboard"), "keyboard##Keyboard"));
         addSeperator = true;
@@ -257,27 +319,27 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 外设设备
-    if (m_ListDeviceMonitor.size() > 0) {
+    if (hasDevice(DT_Monitor)) {
         qCDebug(appLog) << "Adding Monitor information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Monitor"), "monitor##Monitor"));
     }
 
-    if (m_ListDeviceCdrom.size() > 0) {
+    if (hasDevice(DT_Cdrom)) {
         qCDebug(appLog) << "Adding CD-ROM information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("CD-ROM"), "cdrom##Cdrom"));
     }
 
-    if (m_ListDevicePrint.size() > 0) {
+    if (hasDevice(DT_Print)) {
         qCDebug(appLog) << "Adding Printer information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Printer"), "printer##Print"));
     }
 
-    if (m_ListDeviceImage.size() > 0) {
+    if (hasDevice(DT_Image)) {
         qCDebug(appLog) << "Adding Camera information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Camera"), "camera##Image"));
     }
 
-    if (m_ListDeviceOthers.size() > 0) {
+    if (hasDevice(DT_Others)) {
         qCDebug(appLog) << "Adding Other Devices information";
         m_ListDeviceType.append(QPair<QString, QString>(tr("Other Devices", "Other Input Devices"), "otherdevices##Others"));
     }
@@ -289,24 +351,28 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
 void DeviceManager::setDeviceListClass()
 {
     qCDebug(appLog) << "Setting device list class";
-    // 添加设备类型与设备指针列表的映射关系
-    m_DeviceClassMap[tr("CPU")] = m_ListDeviceCPU;
-    m_DeviceClassMap[tr("Motherboard")] =  m_ListDeviceBios;
-    m_DeviceClassMap[tr("Memory")]  =  m_ListDeviceMemory;
-    m_DeviceClassMap[tr("Display Adapter")] =  m_ListDeviceGPU;
-    m_DeviceClassMap[tr("Sound Adapter")] =  m_ListDeviceAudio;
-    m_DeviceClassMap[tr("Storage")]  =  m_ListDeviceStorage;
-    m_DeviceClassMap[tr("Other PCI Devices")] =  m_ListDeviceOtherPCI;
-    m_DeviceClassMap[tr("Battery")] =  m_ListDevicePower;
-    m_DeviceClassMap[tr("Bluetooth")] =  m_ListDeviceBluetooth;
-    m_DeviceClassMap[tr("Network Adapter")]  =  m_ListDeviceNetwork;
-    m_DeviceClassMap[tr("Mouse")] =  m_ListDeviceMouse;
-    m_DeviceClassMap[tr("Keyboard")]  =  m_ListDeviceKeyboard;
-    m_DeviceClassMap[tr("Monitor")] =  m_ListDeviceMonitor;
-    m_DeviceClassMap[tr("CD-ROM")] =  m_ListDeviceCdrom;
-    m_DeviceClassMap[tr("Printer")] =  m_ListDevicePrint;
-    m_DeviceClassMap[tr("Camera")] =  m_ListDeviceImage;
-    m_DeviceClassMap[tr("Other Devices", "Other Input Devices")] =  m_ListDeviceOthers;
+    // 添加设备类型与设备指针列表的映射关系，正在生成的类型暂不添加
+    auto setClass = [this](const QString &name, DeviceType deviceType, const QList<DeviceBaseInfo *> &lst) {
+        if (!isTypeGenerating(deviceType))
+            m_DeviceClassMap[name] = lst;
+    };
+    setClass(tr("CPU"), DT_Cpu, deviceList(DT_Cpu));
+    setClass(tr("Motherboard"), DT_Bios, deviceList(DT_Bios));
+    setClass(tr("Memory"), DT_Memory, deviceList(DT_Memory));
+    setClass(tr("Display Adapter"), DT_Gpu, deviceList(DT_Gpu));
+    setClass(tr("Sound Adapter"), DT_Audio, deviceList(DT_Audio));
+    setClass(tr("Storage"), DT_Storage, deviceList(DT_Storage));
+    setClass(tr("Other PCI Devices"), DT_OtherPCI, deviceList(DT_OtherPCI));
+    setClass(tr("Battery"), DT_Power, deviceList(DT_Power));
+    setClass(tr("Bluetooth"), DT_Bluetoorh, deviceList(DT_Bluetoorh));
+    setClass(tr("Network Adapter"), DT_Network, deviceList(DT_Network));
+    setClass(tr("Mouse"), DT_Mouse, deviceList(DT_Mouse));
+    setClass(tr("Keyboard"), DT_Keyboard, deviceList(DT_Keyboard));
+    setClass(tr("Monitor"), DT_Monitor, deviceList(DT_Monitor));
+    setClass(tr("CD-ROM"), DT_Cdrom, deviceList(DT_Cdrom));
+    setClass(tr("Printer"), DT_Print, deviceList(DT_Print));
+    setClass(tr("Camera"), DT_Image, deviceList(DT_Image));
+    setClass(tr("Other Devices", "Other Input Devices"), DT_Others, deviceList(DT_Others));
 }
 
 bool DeviceManager::getDeviceList(const QString &name, QList<DeviceBaseInfo *> &lst)
@@ -354,49 +420,12 @@ QString DeviceManager::convertDeviceTomlClassName(DeviceType deviceType)
 QList<DeviceBaseInfo *> *DeviceManager::convertDeviceListAddr(DeviceType deviceType)
 {
     qCDebug(appLog) << "Converting device type to list address for deviceType:" << deviceType;
-//    if (deviceType == DT_Null)      {return &m_ListDeviceOthers;}
-    if (deviceType == DT_Computer)  {return &m_ListDeviceComputer;}
-    if (deviceType == DT_Cpu)       {return &m_ListDeviceCPU;}
-    if (deviceType == DT_Bios)      {return &m_ListDeviceBios;}
-    if (deviceType == DT_Memory)    {return &m_ListDeviceMemory;}
-    if (deviceType == DT_Gpu)       {return &m_ListDeviceGPU;}
-    if (deviceType == DT_Audio)     {return &m_ListDeviceAudio;}
-    if (deviceType == DT_Storage)   {return &m_ListDeviceStorage;}
-    if (deviceType == DT_OtherPCI)  {return &m_ListDeviceOtherPCI;}
-    if (deviceType == DT_Power)     {return &m_ListDevicePower;}
-    if (deviceType == DT_Bluetoorh) {return &m_ListDeviceBluetooth;}
-    if (deviceType == DT_Network)   {return &m_ListDeviceNetwork;}
-    if (deviceType == DT_Mouse)     {return &m_ListDeviceMouse;}
-    if (deviceType == DT_Keyboard)  {return &m_ListDeviceKeyboard;}
-    if (deviceType == DT_Monitor)   {return &m_ListDeviceMonitor;}
-    if (deviceType == DT_Cdrom)     {return &m_ListDeviceCdrom;}
-    if (deviceType == DT_Print)     {return &m_ListDevicePrint;}
-    if (deviceType == DT_Image)     {return &m_ListDeviceImage;}
-    if (deviceType == DT_Others)    {return &m_ListDeviceOthers;}
-    return &m_ListDeviceOthers;
+    return &deviceList(deviceType);
 }
 QList<DeviceBaseInfo *> DeviceManager::convertDeviceList(DeviceType deviceType)
 {
     qCDebug(appLog) << "Converting device type to list for deviceType:" << deviceType;
-//    if (deviceType == DT_Null)      {return m_ListDeviceOthers;}
-    if (deviceType == DT_Computer)  {return m_ListDeviceComputer;}
-    if (deviceType == DT_Cpu)       {return m_ListDeviceCPU;}
-    if (deviceType == DT_Bios)      {return m_ListDeviceBios;}
-    if (deviceType == DT_Memory)    {return m_ListDeviceMemory;}
-    if (deviceType == DT_Gpu)       {return m_ListDeviceGPU;}
-    if (deviceType == DT_Audio)     {return m_ListDeviceAudio;}
-    if (deviceType == DT_Storage)   {return m_ListDeviceStorage;}
-    if (deviceType == DT_OtherPCI)  {return m_ListDeviceOtherPCI;}
-    if (deviceType == DT_Power)     {return m_ListDevicePower;}
-    if (deviceType == DT_Bluetoorh) {return m_ListDeviceBluetooth;}
-    if (deviceType == DT_Network)   {return m_ListDeviceNetwork;}
-    if (deviceType == DT_Mouse)     {return m_ListDeviceMouse;}
-    if (deviceType == DT_Keyboard)  {return m_ListDeviceKeyboard;}
-    if (deviceType == DT_Monitor)   {return m_ListDeviceMonitor;}
-    if (deviceType == DT_Cdrom)     {return m_ListDeviceCdrom;}
-    if (deviceType == DT_Print)     {return m_ListDevicePrint;}
-    if (deviceType == DT_Image)     {return m_ListDeviceImage;}
-    if (deviceType == DT_Others)    {return m_ListDeviceOthers;}
+    return deviceList(deviceType);
 }
 
 DeviceBaseInfo *DeviceManager::createDevice(DeviceType deviceType)
@@ -517,38 +546,35 @@ void DeviceManager::tomlDeviceSet(DeviceType deviceType)
     qCDebug(appLog) << "Setting TOML device for deviceType:" << deviceType;
     QString deviceTypeName = convertDeviceTomlClassName(deviceType);
     const QList<QMap<QString, QString>> &tomlMapLst = cmdInfo(deviceTypeName);
+    if (tomlMapLst.isEmpty())
+        return;
+
+    // 原设备信息只归一化一次，每条toml信息通过索引找到相同的设备
+    TomlMatchIndex index(deviceType);
+    foreach (DeviceBaseInfo *device, convertDeviceList(deviceType))
+        index.insert(device);
+
     for (int j = 0; j < tomlMapLst.size(); j++) { // 加载从toml中获取的信息
-        bool fixSameOne = false;                  //初始值设为该项信息没有用过
-        bool isSameOne = false;
-        QList<DeviceBaseInfo *> lst = convertDeviceList(deviceType);
-        for (int i = 0; i < lst.size(); i++) {   // toml中获取的信息 与 原设备信息遍历，相比较作处理
-            DeviceBaseInfo *device = lst[i];
-            QString modalias = PhysID(tomlMapLst[j], "Modalias");
-            QString vid = PhysID(tomlMapLst[j], "Vendor_ID");
-            QString pid = PhysID(tomlMapLst[j], "Product_ID");
-            QString vendor = PhysID(tomlMapLst[j], "Vendor");
-            QString name = PhysID(tomlMapLst[j], "Name");
-            //取出toml中获取的关键字信息设备唯一标识硬件IDS "Modalias"， "Vendor_ID"， "Vendor"，"Name"；作比较处理
-            isSameOne = findByModalias(deviceType, device, modalias);
-            if (!isSameOne) {
-                isSameOne = findByVIDPID(deviceType, device, vid, pid);
-            }
-            if (!isSameOne) {
-                isSameOne = findByVendorName(deviceType, device, vendor, name);
-            }
-            if (isSameOne) {   //存在 就合并信息 setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo);
-                fixSameOne = true;   //标记为该项信息有用过 ，
-                if (TOML_Del == tomlDeviceSet(deviceType, device, tomlMapLst[j])) {
-                    tomlDeviceDel(deviceType, device); //toml 去掉该设备
-                    delete (device);
-                }
+        //取出toml中获取的关键字信息设备唯一标识硬件IDS "Modalias"， "Vendor_ID"， "Vendor"，"Name"；作比较处理
+        QList<DeviceBaseInfo *> sameDevices = index.match(PhysID(tomlMapLst[j], "Modalias"),
+                                                          PhysID(tomlMapLst[j], "Vendor_ID"),
+                                                          PhysID(tomlMapLst[j], "Product_ID"),
+                                                          PhysID(tomlMapLst[j], "Vendor"),
+                                                          PhysID(tomlMapLst[j], "Name"));
+        foreach (DeviceBaseInfo *device, sameDevices) {   //存在 就合并信息 setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo);
+            if (TOML_Del == tomlDeviceSet(deviceType, device, tomlMapLst[j])) {
+                index.remove(device);
+                tomlDeviceDel(deviceType, device); //toml 去掉该设备
+                delete (device);
+            } else {
+                index.update(device);   // 合并后用于比较的信息可能变化
             }
         }  //与原设备信息遍历相比完再作添加设备
-        if ((deviceType != DT_Bios) && (deviceType != DT_Computer) && !fixSameOne) {
-                fixSameOne = true;  //标记为该项信息有用过 ，则不再增加了
-                DeviceBaseInfo *device = createDevice(deviceType);
-                tomlDeviceSet(deviceType, device, tomlMapLst[j]);
-                tomlDeviceAdd(deviceType, device); //不存在 就加
+        if ((deviceType != DT_Bios) && (deviceType != DT_Computer) && sameDevices.isEmpty()) {
+            DeviceBaseInfo *device = createDevice(deviceType);
+            tomlDeviceSet(deviceType, device, tomlMapLst[j]);
+            tomlDeviceAdd(deviceType, device); //不存在 就加
+            index.insert(device);
         }
     } //end of for (int j = 0;...
 }
@@ -576,6 +602,7 @@ void DeviceManager::tomlDeviceDel(DeviceType deviceType, DeviceBaseInfo *const d
     }
     QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
     lst->removeOne(device);
+    rebuildIndex(deviceType);
 }
 
 void DeviceManager::tomlDeviceAdd(DeviceType deviceType, DeviceBaseInfo *const device)
@@ -587,6 +614,7 @@ void DeviceManager::tomlDeviceAdd(DeviceType deviceType, DeviceBaseInfo *const d
     }
     QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
     lst->append(device);
+    indexDevice(deviceType, device);
 }
 
 bool DeviceManager::findByModalias(DeviceType deviceType, DeviceBaseInfo *device, const QString &modalias)
@@ -718,18 +746,19 @@ bool DeviceManager::findByVendorName(DeviceType deviceType, DeviceBaseInfo *devi
 DeviceBaseInfo *DeviceManager::getBluetoothAtIndex(int index)
 {
     qCDebug(appLog) << "Getting Bluetooth device at index:" << index;
-    if (m_ListDeviceBluetooth.size() <= index) {
+    if (deviceList(DT_Bluetoorh).size() <= index) {
         qCDebug(appLog) << "Index is out of range";
         return nullptr;
     }
-    return m_ListDeviceBluetooth[index];
+    return deviceList(DT_Bluetoorh)[index];
 }
 
 void DeviceManager::addMouseDevice(DeviceInput *const device)
 {
     // qCDebug(appLog) << "Adding mouse device";
     // 如果不是重复设备则添加到设备列表
-    m_ListDeviceMouse.append(device);
+    deviceList(DT_Mouse).append(device);
+    indexDevice(DT_Mouse, device);
 }
 
 DeviceBaseInfo *DeviceManager::getMouseDevice(const QString &unique_id)
@@ -739,12 +768,9 @@ DeviceBaseInfo *DeviceManager::getMouseDevice(const QString &unique_id)
         qCDebug(appLog) << "Unique ID is empty";
         return nullptr;
     }
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMouse.begin(); it != m_ListDeviceMouse.end(); ++it) {
-        DeviceInput *mouse = dynamic_cast<DeviceInput *>(*it);
-        if (mouse && mouse->uniqueID() == unique_id) {
-            return *it;
-        }
-    }
+    DeviceBaseInfo *device = deviceIndex(DT_Mouse).value(unique_id, nullptr);
+    if (device)
+        return device;
     qCDebug(appLog) << "Mouse device with unique ID:" << unique_id << "not found";
     return nullptr;
 }
@@ -753,8 +779,8 @@ bool DeviceManager::addMouseInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Adding mouse info from lshw";
     // 从lshw中添加鼠标信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMouse.begin();
-    for (; it != m_ListDeviceMouse.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Mouse).begin();
+    for (; it != deviceList(DT_Mouse).end(); ++it) {
         DeviceInput *device = dynamic_cast<DeviceInput *>(*it);
         if (!device)
             continue;
@@ -772,21 +798,21 @@ void DeviceManager::addCpuDevice(DeviceCpu *const device)
 {
     // qCDebug(appLog) << "Adding CPU device";
     // 添加CPU设备
-    m_ListDeviceCPU.append(device);
+    deviceList(DT_Cpu).append(device);
 }
 
 void DeviceManager::addStorageDeivce(DeviceStorage *const device)
 {
     // qCDebug(appLog) << "Adding storage device";
-    m_ListDeviceStorage.append(device);
+    deviceList(DT_Storage).append(device);
 }
 
 void DeviceManager::addLshwinfoIntoStorageDevice(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Adding lshw info into storage device";
     // 从lshw中添加存储设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceStorage.begin();
-    for (; it != m_ListDeviceStorage.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Storage).begin();
+    for (; it != deviceList(DT_Storage).end(); ++it) {
         DeviceStorage *device = dynamic_cast<DeviceStorage *>(*it);
         if (!device)
             continue;
@@ -800,8 +826,8 @@ void DeviceManager::addLshwinfoIntoNVMEStorageDevice(const QMap<QString, QString
 {
     qCDebug(appLog) << "Adding NVME info into storage device";
     // 从lshw中添加NVME存储设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceStorage.begin();
-    for (; it != m_ListDeviceStorage.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Storage).begin();
+    for (; it != deviceList(DT_Storage).end(); ++it) {
         DeviceStorage *device = dynamic_cast<DeviceStorage *>(*it);
         if (!device)
             continue;
@@ -815,8 +841,8 @@ void DeviceManager::setStorageInfoFromSmartctl(const QString &name, const QMap<Q
 {
     qCDebug(appLog) << "Adding smartctl info into storage device";
     // // 从smartctl中添加存储设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceStorage.begin();
-    for (; it != m_ListDeviceStorage.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Storage).begin();
+    for (; it != deviceList(DT_Storage).end(); ++it) {
         DeviceStorage *device = dynamic_cast<DeviceStorage *>(*it);
         if (!device)
             continue;
@@ -831,8 +857,8 @@ void DeviceManager::mergeDisk()
     qCDebug(appLog) << "Merging disk";
     QList<int> m_ListStorageIndex;
     QMap<QString, QList<int> > allSerialIDs;
-    for (int i = 0; i < m_ListDeviceStorage.size(); ++i) {
-        DeviceStorage *device = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[i]);
+    for (int i = 0; i < deviceList(DT_Storage).size(); ++i) {
+        DeviceStorage *device = dynamic_cast<DeviceStorage *>(deviceList(DT_Storage)[i]);
         if (!device->getDiskSerialID().isEmpty()) {
             allSerialIDs[device->getDiskSerialID()].append(i);
         }
@@ -840,9 +866,9 @@ void DeviceManager::mergeDisk()
     for (auto serialIDs : allSerialIDs) {
         if (serialIDs.size() < 2)
             continue;
-        DeviceStorage *fDevice = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[serialIDs[0] ]);
+        DeviceStorage *fDevice = dynamic_cast<DeviceStorage *>(deviceList(DT_Storage)[serialIDs[0] ]);
         for (int i = serialIDs.size() - 1; i > 0; --i) {
-            DeviceStorage *curDevice = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[serialIDs[i] ]);
+            DeviceStorage *curDevice = dynamic_cast<DeviceStorage *>(deviceList(DT_Storage)[serialIDs[i] ]);
             fDevice->appendDisk(curDevice);
             m_ListStorageIndex.append(serialIDs[i]);
         }
@@ -850,13 +876,13 @@ void DeviceManager::mergeDisk()
 
     std::sort(m_ListStorageIndex.begin(), m_ListStorageIndex.end(), std::greater<int>());
     for(auto index : m_ListStorageIndex) {
-        DeviceStorage *curDevice = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[index]);
-        m_ListDeviceStorage.removeAt(index);
+        DeviceStorage *curDevice = dynamic_cast<DeviceStorage *>(deviceList(DT_Storage)[index]);
+        deviceList(DT_Storage).removeAt(index);
         delete curDevice;
     }
 
-    for (int i = 0; i < m_ListDeviceStorage.size(); ++i) {
-        DeviceStorage *device = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[i]);
+    for (int i = 0; i < deviceList(DT_Storage).size(); ++i) {
+        DeviceStorage *device = dynamic_cast<DeviceStorage *>(deviceList(DT_Storage)[i]);
         device->unitConvertByDecimal();
     }
 }
@@ -864,8 +890,8 @@ void DeviceManager::mergeDisk()
 void DeviceManager::checkDiskSize()
 {
     qCDebug(appLog) << "Checking disk size";
-    for (int i = 0; i < m_ListDeviceStorage.size(); ++i) {
-        DeviceStorage *device = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[i]);
+    for (int i = 0; i < deviceList(DT_Storage).size(); ++i) {
+        DeviceStorage *device = dynamic_cast<DeviceStorage *>(deviceList(DT_Storage)[i]);
         device->checkDiskSize();
     }
 }
@@ -874,8 +900,8 @@ bool DeviceManager::setStorageDeviceMediaType(const QString &name, const QString
 {
     qCDebug(appLog) << "Setting storage device media type";
     // 设置存储设备介质类型
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceStorage.begin();
-    for (; it != m_ListDeviceStorage.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Storage).begin();
+    for (; it != deviceList(DT_Storage).end(); ++it) {
         DeviceStorage *device = dynamic_cast<DeviceStorage *>(*it);
         if (!device)
             continue;
@@ -892,8 +918,8 @@ bool DeviceManager::setKLUStorageDeviceMediaType(const QString &name, const QStr
 {
     qCDebug(appLog) << "Setting KLU storage device media type";
     // 设置KLU机器存储设备介质类型
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceStorage.begin();
-    for (; it != m_ListDeviceStorage.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Storage).begin();
+    for (; it != deviceList(DT_Storage).end(); ++it) {
         DeviceStorage *device = dynamic_cast<DeviceStorage *>(*it);
 
         if (!device)
@@ -910,15 +936,15 @@ void DeviceManager::addGpuDevice(DeviceGpu *const device)
 {
     // qCDebug(appLog) << "Adding GPU device";
     // 添加显示适配器
-    m_ListDeviceGPU.append(device);
+    deviceList(DT_Gpu).append(device);
 }
 
 void DeviceManager::setGpuInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting GPU info from lshw";
     // 从lshw中添加显示适配器信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceGPU.begin();
-    for (; it != m_ListDeviceGPU.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Gpu).begin();
+    for (; it != deviceList(DT_Gpu).end(); ++it) {
         DeviceGpu *device = dynamic_cast<DeviceGpu *>(*it);
         if (!device)
             continue;
@@ -931,8 +957,8 @@ void DeviceManager::setGpuInfoFromXrandr(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting GPU info from xrandr";
     // 从xrandr中添加显示适配器信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceGPU.begin();
-    for (; it != m_ListDeviceGPU.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Gpu).begin();
+    for (; it != deviceList(DT_Gpu).end(); ++it) {
         DeviceGpu *device = dynamic_cast<DeviceGpu *>(*it);
         if (!device)
             continue;
@@ -945,8 +971,8 @@ void DeviceManager::setGpuSizeFromDmesg(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting GPU size from dmesg";
     // 从dmesg中设置显卡大小
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceGPU.begin();
-    for (; it != m_ListDeviceGPU.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Gpu).begin();
+    for (; it != deviceList(DT_Gpu).end(); ++it) {
         DeviceGpu *device = dynamic_cast<DeviceGpu *>(*it);
         if (!device)
             continue;
@@ -959,15 +985,15 @@ void DeviceManager::addMemoryDevice(DeviceMemory *const device)
 {
     // qCDebug(appLog) << "Adding memory device";
     // 添加内存
-    m_ListDeviceMemory.append(device);
+    deviceList(DT_Memory).append(device);
 }
 
 void DeviceManager::setMemoryInfoFromDmidecode(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting memory info from dmidecode";
     // 从dmidecode中添加内存信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMemory.begin();
-    for (; it != m_ListDeviceMemory.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Memory).begin();
+    for (; it != deviceList(DT_Memory).end(); ++it) {
         DeviceMemory *device = dynamic_cast<DeviceMemory *>(*it);
         if (!device)
             continue;
@@ -981,15 +1007,15 @@ void DeviceManager::addMonitor(DeviceMonitor *const device)
 {
     // qCDebug(appLog) << "Adding monitor device";
     // 添加显示设备
-    m_ListDeviceMonitor.append(device);
+    deviceList(DT_Monitor).append(device);
 }
 
 void DeviceManager::setMonitorInfoFromXrandr(const QString &main, const QString &edid, const QString &rate)
 {
     qCDebug(appLog) << "Setting monitor info from xrandr";
     // 从xrandr中添加显示设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMonitor.begin();
-    for (; it != m_ListDeviceMonitor.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Monitor).begin();
+    for (; it != deviceList(DT_Monitor).end(); ++it) {
         DeviceMonitor *device = dynamic_cast<DeviceMonitor *>(*it);
         if (!device)
             continue;
@@ -1003,8 +1029,8 @@ void DeviceManager::setMonitorInfoFromDbus(const QMap<QString, QString> &mapInfo
 {
     qCDebug(appLog) << "Setting monitor info from dbus";
     // 从 dbus 中添加显示设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMonitor.begin();
-    for (; it != m_ListDeviceMonitor.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Monitor).begin();
+    for (; it != deviceList(DT_Monitor).end(); ++it) {
         DeviceMonitor *device = dynamic_cast<DeviceMonitor *>(*it);
         if (!device)
             continue;
@@ -1018,15 +1044,15 @@ void DeviceManager::addBiosDevice(DeviceBios *const device)
 {
     // qCDebug(appLog) << "Adding bios device";
     // 添加主板信息
-    m_ListDeviceBios.append(device);
+    deviceList(DT_Bios).append(device);
 }
 
 void DeviceManager::setLanguageInfo(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting language info";
     // 设置语言信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBios.begin();
-    for (; it != m_ListDeviceBios.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Bios).begin();
+    for (; it != deviceList(DT_Bios).end(); ++it) {
         DeviceBios *device = dynamic_cast<DeviceBios *>(*it);
         if (!device)
             continue;
@@ -1039,15 +1065,16 @@ void DeviceManager::setLanguageInfo(const QMap<QString, QString> &mapInfo)
 void DeviceManager::addBluetoothDevice(DeviceBluetooth *const device)
 {
     // qCDebug(appLog) << "Adding bluetooth device";
-    m_ListDeviceBluetooth.append(device);
+    deviceList(DT_Bluetoorh).append(device);
+    indexDevice(DT_Bluetoorh, device);
 }
 
 void DeviceManager::setBluetoothInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting bluetooth info from lshw";
     // 从lshw中获取蓝牙信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin();
-    for (; it != m_ListDeviceBluetooth.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Bluetoorh).begin();
+    for (; it != deviceList(DT_Bluetoorh).end(); ++it) {
         DeviceBluetooth *device = dynamic_cast<DeviceBluetooth *>(*it);
         if (!device)
             continue;
@@ -1061,8 +1088,8 @@ bool DeviceManager::setBluetoothInfoFromHwinfo(const QMap<QString, QString> &map
 {
     qCDebug(appLog) << "Setting bluetooth info from hwinfo";
     // 从hwinfo中获取蓝牙信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin();
-    for (; it != m_ListDeviceBluetooth.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Bluetoorh).begin();
+    for (; it != deviceList(DT_Bluetoorh).end(); ++it) {
         DeviceBluetooth *device = dynamic_cast<DeviceBluetooth *>(*it);
         if (!device)
             continue;
@@ -1076,8 +1103,8 @@ bool DeviceManager::setBluetoothInfoFromHwinfo(const QMap<QString, QString> &map
 bool DeviceManager::setBluetoothInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting bluetooth info from wifi info";
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin();
-    for (; it != m_ListDeviceBluetooth.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Bluetoorh).begin();
+    for (; it != deviceList(DT_Bluetoorh).end(); ++it) {
         DeviceBluetooth *device = dynamic_cast<DeviceBluetooth *>(*it);
         if (device->setInfoFromWifiInfo(mapInfo)) {
             return true;
@@ -1089,76 +1116,52 @@ bool DeviceManager::setBluetoothInfoFromWifiInfo(const QMap<QString, QString> &m
 DeviceBaseInfo *DeviceManager::getBluetoothDevice(const QString &unique_id)
 {
     qCDebug(appLog) << "Getting bluetooth device with unique ID:" << unique_id;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin(); it != m_ListDeviceBluetooth.end(); ++it) {
-        DeviceBluetooth *bt = dynamic_cast<DeviceBluetooth *>(*it);
-        if (bt && bt->uniqueID() == unique_id) {
-            return *it;
-        }
-    }
-    return nullptr;
+    return deviceIndex(DT_Bluetoorh).value(unique_id, nullptr);
 }
 
 void DeviceManager::addAudioDevice(DeviceAudio *const device)
 {
     // qCDebug(appLog) << "Adding audio device";
-    m_ListDeviceAudio.append(device);
+    deviceList(DT_Audio).append(device);
+    indexDevice(DT_Audio, device);
 }
 
 void DeviceManager::delAudioDevice(DeviceAudio *const device)
 {
     // qCDebug(appLog) << "Deleting audio device";
-    m_ListDeviceAudio.removeOne(device);
+    deviceList(DT_Audio).removeOne(device);
+    rebuildIndex(DT_Audio);
 }
 
 void DeviceManager::deleteDisableDuplicate_AudioDevice(void)
 {
     qCDebug(appLog) << "Deleting disable duplicate audio device";
-    if (m_ListDeviceAudio.size() > 0) {
-        for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin(); it != m_ListDeviceAudio.end(); ++it) {
+    if (deviceList(DT_Audio).size() > 0) {
+        for (QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Audio).begin(); it != deviceList(DT_Audio).end(); ++it) {
             DeviceAudio *audio_1 = dynamic_cast<DeviceAudio *>(*it);
             //QString tpath = audio_1->uniqueID();
             // 判断该设备是否已经存在，
             if (!audio_1->enable()) {
-                for (QList<DeviceBaseInfo *>::iterator it2 = m_ListDeviceAudio.begin(); it2 != m_ListDeviceAudio.end(); ++it2) {
+                for (QList<DeviceBaseInfo *>::iterator it2 = deviceList(DT_Audio).begin(); it2 != deviceList(DT_Audio).end(); ++it2) {
                     DeviceAudio *audio_2 = dynamic_cast<DeviceAudio *>(*it2);
                     if (audio_2->name() == audio_1->name())
                         if (audio_2->enable())
-                            m_ListDeviceAudio.removeOne(audio_2);
+                            deviceList(DT_Audio).removeOne(audio_2);
                 }
             }
         }
 
+        rebuildIndex(DT_Audio);
     }
 }
 
 DeviceBaseInfo *DeviceManager::getAudioDevice(const QString &path)
 {
     qCDebug(appLog) << "Getting audio device with path:" << path;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin(); it != m_ListDeviceAudio.end(); ++it) {
-        DeviceAudio *audio = dynamic_cast<DeviceAudio *>(*it);
-        QString tpath = audio->uniqueID();
-        // 判断该设备是否已经存在，1.1:1.1 -> 1.1:1.0
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-        if (audio && path == tpath.replace(QRegExp("[1-9]$"), "0")) {
-#else
-        if (audio && path == tpath.replace(QRegularExpression("[1-9]$"), "0")) {
-#endif
-            return *it;
-        }
-        QString syspath = audio->sysPath();   //remove dumplicate syspath
-        if (audio && path == syspath) {
-            return *it;
-        }
-        //remove dumplicate by toml Modalias
-        QString Modalias =  audio->getModalias();
-        if (audio && path == Modalias) {
-            return *it;
-        }
-        QString vidpid =  audio->getVIDAndPID();
-        if (audio && path == vidpid) {
-            return *it;
-        }
-    }
+    // 索引中包含 uniqueID(1.1:1.1 -> 1.1:1.0)、sysPath、Modalias 与 VID_PID，见 indexDevice
+    DeviceBaseInfo *device = deviceIndex(DT_Audio).value(path, nullptr);
+    if (device)
+        return device;
     qCDebug(appLog) << "Audio device with path:" << path << "not found";
     return nullptr;
 }
@@ -1167,8 +1170,8 @@ void DeviceManager::setAudioInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting audio info from lshw";
     // 从lshw中获取音频适配器信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin();
-    for (; it != m_ListDeviceAudio.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Audio).begin();
+    for (; it != deviceList(DT_Audio).end(); ++it) {
         DeviceAudio *device = dynamic_cast<DeviceAudio *>(*it);
         if (!device)
             continue;
@@ -1182,8 +1185,8 @@ void DeviceManager::setAudioChipFromDmesg(const QString &info)
 {
     qCDebug(appLog) << "Setting audio chip from dmesg";
     // 从dmesg中获取声卡芯片型号
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin();
-    for (; it != m_ListDeviceAudio.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Audio).begin();
+    for (; it != deviceList(DT_Audio).end(); ++it) {
         DeviceAudio *device = dynamic_cast<DeviceAudio *>(*it);
         if (!device)
             continue;
@@ -1196,14 +1199,15 @@ void DeviceManager::addNetworkDevice(DeviceNetwork *const device)
 {
     // qCDebug(appLog) << "Adding network device";
     // 添加网络适配器
-    m_ListDeviceNetwork.append(device);
+    deviceList(DT_Network).append(device);
+    indexDevice(DT_Network, device);
 }
 
 bool DeviceManager::setNetworkInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting network info from wifi info";
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceNetwork.begin();
-    for (; it != m_ListDeviceNetwork.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Network).begin();
+    for (; it != deviceList(DT_Network).end(); ++it) {
 
         DeviceNetwork *device = dynamic_cast<DeviceNetwork *>(*it);
         if (!device)
@@ -1220,12 +1224,9 @@ bool DeviceManager::setNetworkInfoFromWifiInfo(const QMap<QString, QString> &map
 DeviceBaseInfo *DeviceManager::getNetworkDevice(const QString &unique_id)
 {
     qCDebug(appLog) << "Getting network device with unique ID:" << unique_id;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceNetwork.begin(); it != m_ListDeviceNetwork.end(); ++it) {
-        DeviceNetwork *net = dynamic_cast<DeviceNetwork *>(*it);
-        if (!unique_id.isEmpty() && net && net->uniqueID() == unique_id) {
-            return *it;
-        }
-    }
+    DeviceBaseInfo *device = unique_id.isEmpty() ? nullptr : deviceIndex(DT_Network).value(unique_id, nullptr);
+    if (device)
+        return device;
     qCDebug(appLog) << "Network device with unique ID:" << unique_id << "not found";
     return nullptr;
 }
@@ -1233,12 +1234,12 @@ DeviceBaseInfo *DeviceManager::getNetworkDevice(const QString &unique_id)
 void DeviceManager::correctNetworkLinkStatus(QString linkStatus, QString networkDriver)
 {
     qCDebug(appLog) << "Correcting network link status";
-    if (m_ListDeviceNetwork.size() == 0) {
+    if (deviceList(DT_Network).size() == 0) {
         qCDebug(appLog) << "Network device list is empty";
         return;
     }
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceNetwork.begin();
-    for (; it != m_ListDeviceNetwork.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Network).begin();
+    for (; it != deviceList(DT_Network).end(); ++it) {
         DeviceNetwork *device = dynamic_cast<DeviceNetwork *>(*it);
         if (!device)
             continue;
@@ -1251,8 +1252,8 @@ QStringList DeviceManager::networkDriver()
 {
     qCDebug(appLog) << "Getting network driver";
     m_networkDriver.clear();
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceNetwork.begin();
-    for (; it != m_ListDeviceNetwork.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Network).begin();
+    for (; it != deviceList(DT_Network).end(); ++it) {
         DeviceNetwork *device = dynamic_cast<DeviceNetwork *>(*it);
         if (!device)
             continue;
@@ -1266,12 +1267,12 @@ QStringList DeviceManager::networkDriver()
 void DeviceManager::correctPowerInfo(const QMap<QString, QMap<QString, QString>> &mapInfo)
 {
     qCDebug(appLog) << "Correcting power info";
-    if (m_ListDevicePower.size() == 0) {
+    if (deviceList(DT_Power).size() == 0) {
         qCDebug(appLog) << "Power device list is empty";
         return;
     }
-    QList<DeviceBaseInfo *>::iterator it = m_ListDevicePower.begin();
-    for (; it != m_ListDevicePower.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Power).begin();
+    for (; it != deviceList(DT_Power).end(); ++it) {
         DevicePower *device = dynamic_cast<DevicePower *>(*it);
         if (!device)
             continue;
@@ -1286,18 +1287,16 @@ void DeviceManager::addImageDevice(DeviceImage *const device)
 {
     // qCDebug(appLog) << "Adding image device";
     // 添加图像设备
-    m_ListDeviceImage.append(device);
+    deviceList(DT_Image).append(device);
+    indexDevice(DT_Image, device);
 }
 
 DeviceBaseInfo *DeviceManager::getImageDevice(const QString &unique_id)
 {
     qCDebug(appLog) << "Getting image device with unique ID:" << unique_id;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceImage.begin(); it != m_ListDeviceImage.end(); ++it) {
-        DeviceImage *image = dynamic_cast<DeviceImage *>(*it);
-        if (image && image->uniqueID() == unique_id) {
-            return *it;
-        }
-    }
+    DeviceBaseInfo *device = deviceIndex(DT_Image).value(unique_id, nullptr);
+    if (device)
+        return device;
     qCDebug(appLog) << "Image device with unique ID:" << unique_id << "not found";
     return nullptr;
 }
@@ -1306,8 +1305,8 @@ void DeviceManager::setCameraInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting camera info from lshw";
     // 从lshw获取图像设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceImage.begin();
-    for (; it != m_ListDeviceImage.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Image).begin();
+    for (; it != deviceList(DT_Image).end(); ++it) {
         DeviceImage *device = dynamic_cast<DeviceImage *>(*it);
         if (!device)
             continue;
@@ -1320,15 +1319,15 @@ void DeviceManager::addKeyboardDevice(DeviceInput *const device)
 {
     // qCDebug(appLog) << "Adding keyboard device";
     // 添加键盘
-    m_ListDeviceKeyboard.append(device);
+    deviceList(DT_Keyboard).append(device);
 }
 
 void DeviceManager::setKeyboardInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting keyboard info from lshw";
     // 从lshw获取键盘信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceKeyboard.begin();
-    for (; it != m_ListDeviceKeyboard.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Keyboard).begin();
+    for (; it != deviceList(DT_Keyboard).end(); ++it) {
         DeviceInput *device = dynamic_cast<DeviceInput *>(*it);
         if (!device)
             continue;
@@ -1343,7 +1342,7 @@ void DeviceManager::addOthersDevice(DeviceOthers *const device)
     qCDebug(appLog) << "Adding others device";
     // 添加其他设备
     bool isOtherDevice = true;
-    foreach (auto disk, m_ListDeviceStorage) {
+    foreach (auto disk, deviceList(DT_Storage)) {
         DeviceStorage *deviceDisk = dynamic_cast<DeviceStorage *>(disk);
         if (!deviceDisk)
             continue;
@@ -1356,8 +1355,10 @@ void DeviceManager::addOthersDevice(DeviceOthers *const device)
     }
 
     // 添加其他设备
-    if (isOtherDevice)
-        m_ListDeviceOthers.append(device);
+    if (isOtherDevice) {
+        deviceList(DT_Others).append(device);
+        indexDevice(DT_Others, device);
+    }
 }
 
 DeviceBaseInfo *DeviceManager::getOthersDevice(const QString &unique_id)
@@ -1366,12 +1367,9 @@ DeviceBaseInfo *DeviceManager::getOthersDevice(const QString &unique_id)
     if (unique_id.isEmpty()) {
         return nullptr;
     }
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceOthers.begin(); it != m_ListDeviceOthers.end(); ++it) {
-        DeviceOthers *other = dynamic_cast<DeviceOthers *>(*it);
-        if (other && other->uniqueID() == unique_id) {
-            return *it;
-        }
-    }
+    DeviceBaseInfo *device = deviceIndex(DT_Others).value(unique_id, nullptr);
+    if (device)
+        return device;
     qCDebug(appLog) << "Others device with unique ID:" << unique_id << "not found";
     return nullptr;
 }
@@ -1380,7 +1378,7 @@ void DeviceManager::addOthersDeviceFromHwinfo(DeviceOthers *const device)
 {
     qCDebug(appLog) << "Adding others device from hwinfo";
     // 从hwinfo中获取其他设备信息
-    foreach (auto cur, m_ListDeviceOthers) {
+    foreach (auto cur, deviceList(DT_Others)) {
         DeviceOthers *deviceOthers = dynamic_cast<DeviceOthers *>(cur);
         if (!deviceOthers)
             continue;
@@ -1389,15 +1387,16 @@ void DeviceManager::addOthersDeviceFromHwinfo(DeviceOthers *const device)
             return;
     }
     qCDebug(appLog) << "Adding others device from hwinfo";
-    m_ListDeviceOthers.append(device);
+    deviceList(DT_Others).append(device);
+    indexDevice(DT_Others, device);
 }
 
 void DeviceManager::setOthersDeviceInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting others device info from lshw";
     //从lshw中获取其他设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceOthers.begin();
-    for (; it != m_ListDeviceOthers.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Others).begin();
+    for (; it != deviceList(DT_Others).end(); ++it) {
         DeviceOthers *device = dynamic_cast<DeviceOthers *>(*it);
         if (!device)
             continue;
@@ -1409,8 +1408,8 @@ void DeviceManager::setOthersDeviceInfoFromLshw(const QMap<QString, QString> &ma
 void DeviceManager::setCpuRefreshInfoFromlscpu(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting CPU refresh info from lscpu";
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceCPU.begin();
-    for (; it != m_ListDeviceCPU.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Cpu).begin();
+    for (; it != deviceList(DT_Cpu).end(); ++it) {
         DeviceCpu *device = dynamic_cast<DeviceCpu *>(*it);
         if (!device)
             continue;
@@ -1423,43 +1422,43 @@ void DeviceManager::addPowerDevice(DevicePower *const device)
 {
     // qCDebug(appLog) << "Adding power device";
     // 添加电池设备
-    m_ListDevicePower.append(device);
+    deviceList(DT_Power).append(device);
 }
 
 void DeviceManager::addPrintDevice(DevicePrint *const device)
 {
     // qCDebug(appLog) << "Adding print device";
     // 添加打印机信息
-    m_ListDevicePrint.append(device);
+    deviceList(DT_Print).append(device);
 }
 
 void DeviceManager::addOtherPCIDevice(DeviceOtherPCI *const device)
 {
     // qCDebug(appLog) << "Adding other PCI device";
     // 添加其他PCI设备
-    m_ListDeviceOtherPCI.append(device);
+    deviceList(DT_OtherPCI).append(device);
 }
 
 void DeviceManager::addComputerDevice(DeviceComputer *const device)
 {
     // qCDebug(appLog) << "Adding computer device";
     // 添加计算机设备
-    m_ListDeviceComputer.append(device);
+    deviceList(DT_Computer).append(device);
 }
 
 void DeviceManager::addCdromDevice(DeviceCdrom *const device)
 {
     // qCDebug(appLog) << "Adding CDROM device";
     // 添加CDROM
-    m_ListDeviceCdrom.append(device);
+    deviceList(DT_Cdrom).append(device);
 }
 
 void DeviceManager::addLshwinfoIntoCdromDevice(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Adding CDROM info from lshw";
     // 从lshw中添加CDROM信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceCdrom.begin();
-    for (; it != m_ListDeviceCdrom.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Cdrom).begin();
+    for (; it != deviceList(DT_Cdrom).end(); ++it) {
         DeviceCdrom *device = dynamic_cast<DeviceCdrom *>(*it);
         if (!device)
             continue;
@@ -1484,7 +1483,15 @@ const QStringList &DeviceManager::getBusId()
 void DeviceManager::addCmdInfo(const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo)
 {
     // qCDebug(appLog) << "Adding command info";
+    QElapsedTimer timer;
+    timer.start();
     QMutexLocker locker(&addCmdMutex);
+    m_AddCmdWaitTime += timer.nsecsElapsed();
+    Q_ASSERT_X(!m_CmdInfoFrozen, "DeviceManager::addCmdInfo", "cmd info is frozen");
+    if (m_CmdInfoFrozen) {
+        qCWarning(appLog) << "Command info is frozen, ignore" << cmdInfo.keys();
+        return;
+    }
     // 添加命令信息
     foreach (const QString &key, cmdInfo.keys()) {
         if (m_cmdInfo.find(key) == m_cmdInfo.end())
@@ -1494,316 +1501,284 @@ void DeviceManager::addCmdInfo(const QMap<QString, QList<QMap<QString, QString>
     }
 }
 
-const QList<QMap<QString, QString>> &DeviceManager::cmdInfo(const QString &key)
+void DeviceManager::addCmdInfo(QMap<QString, QList<QMap<QString, QString> > > &&cmdInfo)
 {
-    // qCDebug(appLog) << "Getting command info";
+    QElapsedTimer timer;
+    timer.start();
     QMutexLocker locker(&addCmdMutex);
-    return m_cmdInfo[key];
+    m_AddCmdWaitTime += timer.nsecsElapsed();
+    Q_ASSERT_X(!m_CmdInfoFrozen, "DeviceManager::addCmdInfo", "cmd info is frozen");
+    if (m_CmdInfoFrozen) {
+        qCWarning(appLog) << "Command info is frozen, ignore" << cmdInfo.keys();
+        return;
+    }
+    // 各命令加载后立即发布，以便依赖它的设备类型开始生成(见GenerateDevicePool::slotCmdLoaded)，
+    // 因此不再等全部命令结束后合并；锁内只移动，不复制
+    // 第一次添加直接接管
+    if (m_cmdInfo.isEmpty()) {
+        m_cmdInfo.swap(cmdInfo);
+        return;
+    }
+    for (QMap<QString, QList<QMap<QString, QString> > >::iterator it = cmdInfo.begin(); it != cmdInfo.end(); ++it) {
+        QMap<QString, QList<QMap<QString, QString> > >::iterator dst = m_cmdInfo.find(it.key());
+        if (dst == m_cmdInfo.end())
+            m_cmdInfo.insert(it.key(), std::move(it.value()));
+        else
+            dst.value().append(std::move(it.value()));
+    }
+    cmdInfo.clear();
 }
 
-bool DeviceManager::exportToTxt(const QString &filePath)
+qint64 DeviceManager::addCmdWaitTime() const
 {
-    qCDebug(appLog) << "Exporting to txt file";
-    // 导出设备信息到txt文件
-    QFile txtFile(filePath);
-    if (false == txtFile.open(QIODevice::WriteOnly))
-        return false;
+    return m_AddCmdWaitTime;
+}
 
-    QTextStream out(&txtFile);
-    overviewToTxt(out);
-    EXPORT_TO_TXT(out, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_TXT(out, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_TXT(out, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_TXT(out, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_TXT(out, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_TXT(out, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_TXT(out, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_TXT(out, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_TXT(out, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_TXT(out, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_TXT(out, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_TXT(out, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_TXT(out, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_TXT(out, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_TXT(out, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_TXT(out, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_TXT(out, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-    txtFile.close();
+const QList<QMap<QString, QString>> &DeviceManager::cmdInfo(const QString &key)
+{
+    // qCDebug(appLog) << "Getting command info";
+    static const QList<QMap<QString, QString>> empty;
+    // 冻结后只读，生成设备的多个线程同时查询时不加锁
+    if (m_CmdInfoFrozen.load(std::memory_order_acquire)) {
+        QHash<QString, QList<QMap<QString, QString> > >::const_iterator it = m_FrozenCmdInfo.constFind(key);
+        return it == m_FrozenCmdInfo.constEnd() ? empty : it.value();
+    }
 
-    return true;
+    QElapsedTimer timer;
+    timer.start();
+    QMutexLocker locker(&addCmdMutex);
+    m_AddCmdWaitTime += timer.nsecsElapsed();
+    QMap<QString, QList<QMap<QString, QString> > >::const_iterator it = m_cmdInfo.constFind(key);
+    return it == m_cmdInfo.constEnd() ? empty : it.value();
 }
 
-bool DeviceManager::exportToXlsx(const QString &filePath)
+void DeviceManager::freezeCmdInfo()
 {
-    qCDebug(appLog) << "Exporting to xlsx file";
-    // 导出设备信息到xlsx表格
-    QXlsx::Document xlsx;
-    QXlsx::Format boldFont;
-    overviewToXlsx(xlsx, boldFont);
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-    m_CurrentXlsRow = 1;
-    xlsx.saveAs(filePath);
+    QMutexLocker locker(&addCmdMutex);
+    if (m_CmdInfoFrozen)
+        return;
+    m_FrozenCmdInfo.clear();
+    m_FrozenCmdInfo.reserve(m_cmdInfo.size());
+    for (QMap<QString, QList<QMap<QString, QString> > >::const_iterator it = m_cmdInfo.constBegin(); it != m_cmdInfo.constEnd(); ++it)
+        m_FrozenCmdInfo.insert(it.key(), it.value());
+    m_CmdInfoFrozen.store(true, std::memory_order_release);
+    qCDebug(appLog) << "Command info frozen, keys:" << m_FrozenCmdInfo.size();
+}
 
-    return true;
+bool DeviceManager::isCmdInfoFrozen() const
+{
+    return m_CmdInfoFrozen;
 }
 
-bool DeviceManager::exportToDoc(const QString &filePath)
+void DeviceManager::setTypeGenerating(DeviceType deviceType, bool generating)
 {
-    qCDebug(appLog) << "Exporting to doc file";
-    // 导出设备信息到doc文件
-    Docx::Document doc(":/template.docx");
-    overviewToDoc(doc);
-    EXPORT_TO_DOC(doc, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_DOC(doc, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_DOC(doc, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-
-    doc.save(filePath);
+    qCDebug(appLog) << "Set device type generating, type:" << deviceType << generating;
+    if (generating)
+        m_GeneratingTypes.fetch_or(1u << deviceType);
+    else
+        m_GeneratingTypes.fetch_and(~(1u << deviceType));
+}
 
-    return true;
+bool DeviceManager::isTypeGenerating(DeviceType deviceType) const
+{
+    return m_GeneratingTypes.load() & (1u << deviceType);
 }
 
-bool DeviceManager::exportToHtml(const QString &filePath)
+bool DeviceManager::hasDevice(DeviceType deviceType)
 {
-    qCDebug(appLog) << "Exporting to html file";
-    // 导出设备信息到html文件
-    QFile html(filePath);
-    if (false == html.open(QIODevice::WriteOnly))
-        return false;
+    return !isTypeGenerating(deviceType) && convertDeviceListAddr(deviceType)->size() > 0;
+}
 
-    html.write("<!DOCTYPE html>\n");
-    html.write("<html>\n");
-    html.write("<body>\n");
-
-    overviewToHtml(html);
-
-    EXPORT_TO_HTML(html, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_HTML(html, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_HTML(html, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_HTML(html, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_HTML(html, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_HTML(html, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_HTML(html, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_HTML(html, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_HTML(html, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_HTML(html, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_HTML(html, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_HTML(html, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_HTML(html, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_HTML(html, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_HTML(html, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_HTML(html, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_HTML(html, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-
-    html.write("</body>\n");                                                \
-    html.write("</html>\n");
-
-    html.close();
+QList<DeviceBaseInfo *> &DeviceManager::deviceList(DeviceType deviceType)
+{
+    if (stagingDevices.type != DT_Null && stagingDevices.type == deviceType)
+        return stagingDevices.list;
 
-    return true;
+    if (deviceType == DT_Computer)  {return m_ListDeviceComputer;}
+    if (deviceType == DT_Cpu)       {return m_ListDeviceCPU;}
+    if (deviceType == DT_Bios)      {return m_ListDeviceBios;}
+    if (deviceType == DT_Memory)    {return m_ListDeviceMemory;}
+    if (deviceType == DT_Gpu)       {return m_ListDeviceGPU;}
+    if (deviceType == DT_Audio)     {return m_ListDeviceAudio;}
+    if (deviceType == DT_Storage)   {return m_ListDeviceStorage;}
+    if (deviceType == DT_OtherPCI)  {return m_ListDeviceOtherPCI;}
+    if (deviceType == DT_Power)     {return m_ListDevicePower;}
+    if (deviceType == DT_Bluetoorh) {return m_ListDeviceBluetooth;}
+    if (deviceType == DT_Network)   {return m_ListDeviceNetwork;}
+    if (deviceType == DT_Mouse)     {return m_ListDeviceMouse;}
+    if (deviceType == DT_Keyboard)  {return m_ListDeviceKeyboard;}
+    if (deviceType == DT_Monitor)   {return m_ListDeviceMonitor;}
+    if (deviceType == DT_Cdrom)     {return m_ListDeviceCdrom;}
+    if (deviceType == DT_Print)     {return m_ListDevicePrint;}
+    if (deviceType == DT_Image)     {return m_ListDeviceImage;}
+    return m_ListDeviceOthers;
 }
 
-int DeviceManager::currentXlsRow()
+QHash<QString, DeviceBaseInfo *> &DeviceManager::deviceIndex(DeviceType deviceType)
 {
-    // qCDebug(appLog) << "Getting current XLS row";
-    return m_CurrentXlsRow++;
+    if (stagingDevices.type != DT_Null && stagingDevices.type == deviceType)
+        return stagingDevices.index;
+    return m_DeviceIndex[deviceType];
 }
 
-void DeviceManager::overviewToTxt(QTextStream &out)
+void DeviceManager::indexDevice(DeviceType deviceType, DeviceBaseInfo *device)
 {
-    qCDebug(appLog) << "Exporting overview to txt";
-    // 概况信息导出到txt
-    out << "[" << tr("Overview") << "]\n-------------------------------------------------";
-    out << "\n";
-
-    // 导出设备信息
-    out.setFieldWidth(21);
-    out.setFieldAlignment(QTextStream::FieldAlignment::AlignLeft);
-    out << tr("Device") + ": ";
-    out.setFieldWidth(0);
-    out << m_OveriewMap["Overview"];
-    out << "\n";
-
-    // 导出操作系统信息
-    out.setFieldWidth(21);
-    out.setFieldAlignment(QTextStream::FieldAlignment::AlignLeft);
-    out << tr("OS") + ": ";
-    out.setFieldWidth(0);
-    out << m_OveriewMap["OS"];
-    out << "\n";
+    if (!device)
+        return;
 
-    foreach (auto iter, m_ListDeviceType) {
-        if (iter.first == tr("Overview"))
-            continue;
+    QStringList keys;
+    if (deviceType == DT_Audio) {
+        DeviceAudio *audio = dynamic_cast<DeviceAudio *>(device);
+        if (!audio)
+            return;
+        // 与原有的匹配顺序一致，1.1:1.1 -> 1.1:1.0，再依次是 sysPath、Modalias、VID_PID
+        QString tpath = audio->uniqueID();
+        keys << tpath.replace(QRegularExpression("[1-9]$"), "0") << audio->sysPath()
+             << audio->getModalias() << audio->getVIDAndPID();
+    } else if (deviceType == DT_Mouse || deviceType == DT_Network || deviceType == DT_Image
+               || deviceType == DT_Bluetoorh || deviceType == DT_Others) {
+        keys << device->uniqueID();
+    } else {
+        return;
+    }
 
-        // 导出设备的概况信息
-        if (m_OveriewMap.find(iter.first) != m_OveriewMap.end()) {
-            out.setFieldWidth(21);
-            out.setFieldAlignment(QTextStream::FieldAlignment::AlignLeft);
-            out << iter.first + ": ";
-            out.setFieldWidth(0);
-            out << m_OveriewMap[iter.first];
-            out << "\n";
-        }
+    // 列表靠前的设备先被找到
+    QHash<QString, DeviceBaseInfo *> &index = deviceIndex(deviceType);
+    foreach (const QString &key, keys) {
+        if (!index.contains(key))
+            index.insert(key, device);
     }
-    out << "\n";
 }
 
+void DeviceManager::rebuildIndex(DeviceType deviceType)
+{
+    deviceIndex(deviceType).clear();
+    foreach (DeviceBaseInfo *device, deviceList(deviceType))
+        indexDevice(deviceType, device);
+}
 
-
-void DeviceManager::overviewToHtml(QFile &html)
+void DeviceManager::beginStaging(DeviceType deviceType)
 {
-    qCDebug(appLog) << "Exporting overview to html";
-    // 导出概况信息到html
-    html.write((QString("<h2>") + "[" + tr("Overview") + "]" + "</h2>").toUtf8());
-    QDomDocument doc;
+    qCDebug(appLog) << "Begin staging device type:" << deviceType;
+    stagingDevices.type = deviceType;
+    stagingDevices.list.clear();
+    stagingDevices.index.clear();
+}
 
-    // 导出设备信息到html
-    infoToHtml(doc, "Device", m_OveriewMap["Overview"]);
+void DeviceManager::commitStaging()
+{
+    if (stagingDevices.type == DT_Null)
+        return;
 
-    // 导出操作系统信息到html
-    infoToHtml(doc, "OS", m_OveriewMap["OS"]);
+    // 先结束暂存，之后 deviceList 返回的是发布的列表
+    DeviceType deviceType = stagingDevices.type;
+    stagingDevices.type = DT_Null;
+    qCDebug(appLog) << "Commit staging device type:" << deviceType << "count:" << stagingDevices.list.size();
 
-    // 导出设备概况信息到html
-    foreach (auto iter, m_ListDeviceType) {
-        if (iter.first == tr("Overview"))
-            continue;
-
-        if (m_OveriewMap.find(iter.first) != m_OveriewMap.end())
-            infoToHtml(doc, iter.first, m_OveriewMap[iter.first]);
+    // 每类设备只由一个任务生成，发布的列表在提交前为空，直接交换即可
+    QList<DeviceBaseInfo *> &lst = deviceList(deviceType);
+    if (lst.isEmpty()) {
+        lst.swap(stagingDevices.list);
+        m_DeviceIndex[deviceType].swap(stagingDevices.index);
+    } else {
+        lst.append(stagingDevices.list);
+        rebuildIndex(deviceType);
     }
-
-    doc.appendChild(doc.createElement("br"));
-    html.write(doc.toString().toStdString().data());
+    stagingDevices.list.clear();
+    stagingDevices.index.clear();
 }
 
-void DeviceManager::overviewToDoc(Docx::Document &doc)
+bool DeviceManager::exportToTxt(const QString &filePath)
 {
-    qCDebug(appLog) << "Exporting overview to doc";
-    // 导出概况信息到doc文件
-    doc.addHeading("[" + tr("Overview") + "]");
-    doc.addParagraph("-------------------------------------------------");
-
-    // 导出设备信息到doc
-    QString line = tr("Device") + ":  " + m_OveriewMap["Overview"];
-    doc.addParagraph(line);
+    qCDebug(appLog) << "Exporting to txt file";
+    // 导出设备信息到txt文件
+    TxtExportWriter writer;
+    if (false == writer.open(filePath))
+        return false;
 
-    // 导出操作系统信息到doc
-    line = tr("OS") + ":  " + m_OveriewMap["OS"];
-    doc.addParagraph(line);
+    return exportDevices(writer);
+}
 
-    // 导出设备概况信息到doc
-    foreach (auto iter, m_ListDeviceType) {
-        if (iter.first == tr("Overview"))
-            continue;
+bool DeviceManager::exportToXlsx(const QString &filePath)
+{
+    qCDebug(appLog) << "Exporting to xlsx file";
+    // 导出设备信息到xlsx表格
+    XlsxExportWriter writer;
+    if (false == writer.open(filePath))
+        return false;
 
-        if (m_OveriewMap.find(iter.first) != m_OveriewMap.end()) {
-            line = iter.first + ":  " + m_OveriewMap[iter.first];
-            doc.addParagraph(line);
-        }
-    }
-    doc.addParagraph("\n");
+    return exportDevices(writer);
 }
 
-void DeviceManager::overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont)
+bool DeviceManager::exportToDoc(const QString &filePath)
 {
-    qCDebug(appLog) << "Exporting overview to xlsx";
-    // 导出概况信息到xlsx文件
-    boldFont.setFontBold(true);
-    xlsx.write(m_CurrentXlsRow++, 1, "[" + tr("Overview") + "]", boldFont);
+    qCDebug(appLog) << "Exporting to doc file";
+    // 导出设备信息到doc文件
+    DocExportWriter writer;
+    if (false == writer.open(filePath))
+        return false;
 
-    // 设置字体格式
-    boldFont.setFontBold(false);
-    boldFont.setFontSize(10);
+    return exportDevices(writer);
+}
 
-    // 导出设备信息到xlsx文件
-    xlsx.write(m_CurrentXlsRow, 1, tr("Device"), boldFont);
-    xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap["Overview"], boldFont);
+bool DeviceManager::exportToHtml(const QString &filePath)
+{
+    qCDebug(appLog) << "Exporting to html file";
+    // 导出设备信息到html文件
+    HtmlExportWriter writer;
+    if (false == writer.open(filePath))
+        return false;
 
-    // 导出操作系统信息到xlsx文件
-    xlsx.write(m_CurrentXlsRow, 1, tr("OS"), boldFont);
-    xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap["OS"], boldFont);
+    return exportDevices(writer);
+}
 
-    // 导出设备概况信息到xlsx文件
+bool DeviceManager::exportDevices(ExportWriter &writer)
+{
+    qCDebug(appLog) << "Exporting devices";
+    // 导出概况信息
+    QList<QPair<QString, QString>> overviewInfo;
+    overviewInfo.append(qMakePair(tr("Device"), m_OveriewMap.value("Overview")));
+    overviewInfo.append(qMakePair(tr("OS"), m_OveriewMap.value("OS")));
     foreach (auto iter, m_ListDeviceType) {
         if (iter.first == tr("Overview"))
             continue;
 
-        if (m_OveriewMap.find(iter.first) != m_OveriewMap.end()) {
-
-            xlsx.write(m_CurrentXlsRow, 1, iter.first, boldFont);
-            xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap[iter.first], boldFont);
-        }
+        if (m_OveriewMap.contains(iter.first))
+            overviewInfo.append(qMakePair(iter.first, m_OveriewMap.value(iter.first)));
     }
-    m_CurrentXlsRow++;
-}
-
-void DeviceManager::infoToHtml(QDomDocument &doc, const QString &key, const QString &value)
-{
-    qCDebug(appLog) << "Exporting info to html";
-    // 导出设备信息到html
-    // 创建表格,设置表格属性
-    QDomElement table = doc.createElement("table");
-    table.setAttribute("border", "0");
-    table.setAttribute("width", "100%");
-    table.setAttribute("cellpadding", "3");
+    writer.overview(tr("Overview"), overviewInfo);
 
-    QDomElement tr = doc.createElement("tr");
+    // 按设备类型导出，每个设备只读取一次属性列表
+    for (size_t i = 0; i < sizeof(EXPORT_SECTIONS) / sizeof(EXPORT_SECTIONS[0]); ++i) {
+        const QList<DeviceBaseInfo *> &deviceLst = deviceList(EXPORT_SECTIONS[i].type);
+        writer.beginSection(QObject::tr(EXPORT_SECTIONS[i].title));
 
-    // 创建单元格,设置单元格属性
-    QDomElement td = doc.createElement("td");
-    td.setAttribute("width", "15%");
-    td.setAttribute("style", "text-align:left;");
+        // 无设备添加提示信息
+        if (deviceLst.isEmpty())
+            writer.emptySection(QObject::tr(EXPORT_SECTIONS[i].msg));
 
-    // 设置单元格内容
-    QDomText nameText = doc.createTextNode(QObject::tr(key.toStdString().c_str()) + ": ");
-    td.appendChild(nameText);
-    tr.appendChild(td);
-
-    // 创建单元格,设置单元格属性
-    QDomElement td2 = doc.createElement("td");
-    td2.setAttribute("width", "85%");
-
-    // 设置单元格内容
-    QDomText valueText;
-    valueText = doc.createTextNode(value);
-    td2.appendChild(valueText);
+        // 设备数目大于1，添加表格信息，表头最后一项是能否禁用的标记，不导出
+        if (deviceLst.size() > 1) {
+            QStringList header = deviceLst[0]->getTableHeader();
+            header.removeLast();
+            writer.beginTable(header);
+            foreach (DeviceBaseInfo *device, deviceLst)
+                writer.tableRow(device->getTableData());
+            writer.endTable();
+        }
 
-    tr.appendChild(td2);
+        // 添加每个设备的信息，设备数目大于1时添加子标题
+        foreach (DeviceBaseInfo *device, deviceLst) {
+            writer.beginDevice(deviceLst.size() > 1 ? device->subTitle() : QString());
+            writer.deviceInfo(validAttribs(device, device->getBaseAttribs()));
+            writer.deviceInfo(validAttribs(device, device->getOtherAttribs()));
+            writer.endDevice();
+        }
 
-    // 插入表格
-    table.appendChild(tr);
+        writer.endSection();
+    }
 
-    doc.appendChild(table);
+    return writer.close();
 }
 
 const QMap<QString, QString>  &DeviceManager::getDeviceOverview()
@@ -1835,15 +1810,15 @@ const QMap<QString, QString>  &DeviceManager::getDeviceOverview()
     }
 
     // 设备名称 and 操作系统
-    if (m_ListDeviceComputer.size() > 0) {
-        m_OveriewMap["Overview"] = m_ListDeviceComputer[0]->getOverviewInfo();
-        m_OveriewMap["OS"] = dynamic_cast<DeviceComputer *>(m_ListDeviceComputer[0])->getOSInfo();
+    if (deviceList(DT_Computer).size() > 0) {
+        m_OveriewMap["Overview"] = deviceList(DT_Computer)[0]->getOverviewInfo();
+        m_OveriewMap["OS"] = dynamic_cast<DeviceComputer *>(deviceList(DT_Computer)[0])->getOSInfo();
     }
 
 
     // CPU 概况显示 样式"Intel(R) Core(TM) i3-9100F CPU @ 3.60GHz (四核 / 四逻辑处理器)"
-    if (!m_ListDeviceCPU.isEmpty())
-        m_OveriewMap[tr("CPU")] = m_ListDeviceCPU[0] ->getOverviewInfo();
+    if (!deviceList(DT_Cpu).isEmpty())
+        m_OveriewMap[tr("CPU")] = deviceList(DT_Cpu)[0] ->getOverviewInfo();
 
     if (m_CpuNum > 1)
         m_OveriewMap[tr("CPU quantity")] = QString::number(m_CpuNum);
@@ -1912,8 +1887,8 @@ void DeviceManager::setCpuNum(int num)
 void DeviceManager::setCpuFrequencyIsCur(const bool &flag)
 {
     qCDebug(appLog) << "Setting CPU frequency is current";
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceCPU.begin();
-    for (; it != m_ListDeviceCPU.end(); ++it) {
+    QList<DeviceBaseInfo *>::iterator it = deviceList(DT_Cpu).begin();
+    for (; it != deviceList(DT_Cpu).end(); ++it) {
         DeviceCpu *device = dynamic_cast<DeviceCpu *>(*it);
         if (!device)
             continue;
@@ -12,11 +12,14 @@
 
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QMutex>
 #include <QDomDocument>
 #include <QObject>
 #include <QFile>
 
+#include <atomic>
+
 //class DeviceMouse;
 class DeviceCpu;
 class DeviceStorage;
@@ -37,6 +40,7 @@ class DeviceComputer;
 class DeviceCdrom;
 class DeviceInput;
 class DeviceBaseInfo;
+class ExportWriter;
 
 /**
  * @brief The TomlFixMethod enum
@@ -537,12 +541,60 @@ public:
     void addCmdInfo(const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
 
     /**
-     * @brief cmdInfo:获取命令key对相应的信息map组成的List
+     * @brief addCmdInfo:移交命令解析结果，不复制
+     * @param cmdInfo:命令以及由命令获取的信息解析出的map list，调用后为空
+     */
+    void addCmdInfo(QMap<QString, QList<QMap<QString, QString> > > &&cmdInfo);
+
+    /**
+     * @brief addCmdWaitTime:等待命令信息锁的累计时间，clear时清零
+     * @return 纳秒
+     */
+    qint64 addCmdWaitTime() const;
+
+    /**
+     * @brief cmdInfo:获取命令key对相应的信息map组成的List，冻结后不加锁
      * @param key:命令值
-     * @return 信息map组成的信息List
+     * @return 信息map组成的信息List，不存在时返回空List，不会插入
      */
     const QList<QMap<QString, QString>> &cmdInfo(const QString &key);
 
+    /**
+     * @brief freezeCmdInfo:信息加载完成后冻结，生成只读的哈希索引，之后不能再添加，clear时解除
+     */
+    void freezeCmdInfo();
+
+    /**
+     * @brief isCmdInfoFrozen:命令信息是否已冻结
+     * @return
+     */
+    bool isCmdInfoFrozen() const;
+
+    /**
+     * @brief setTypeGenerating:设置该类设备是否正在生成，生成中的类型不出现在设备类型列表中
+     * @param deviceType:设备类型
+     * @param generating:是否正在生成
+     */
+    void setTypeGenerating(DeviceType deviceType, bool generating);
+
+    /**
+     * @brief isTypeGenerating:该类设备是否正在生成
+     * @param deviceType:设备类型
+     * @return
+     */
+    bool isTypeGenerating(DeviceType deviceType) const;
+
+    /**
+     * @brief beginStaging:当前线程开始生成该类设备，之后该类设备先加入线程内的暂存列表
+     * @param deviceType:设备类型
+     */
+    void beginStaging(DeviceType deviceType);
+
+    /**
+     * @brief commitStaging:将当前线程暂存的设备及其索引一次性发布到设备列表
+     */
+    void commitStaging();
+
     /**
      * @brief exportToTxt:导出到txt
      * @param filePath:文件路径
@@ -572,43 +624,11 @@ public:
     bool exportToHtml(const QString &filePath);
 
     /**
-     * @brief currentXlsRow:获取xlsx当前行
-     * @return xlsx当前行
-     */
-    static int currentXlsRow();
-
-    /**
-     * @brief overviewToTxt:概况信息写到txt
-     * @param out:txt文件流
-     */
-    void overviewToTxt(QTextStream &out);
-
-    /**
-     * @brief overviewToHtml:概况信息写到html
-     * @param html:html文件
-     */
-    void overviewToHtml(QFile &html);
-
-    /**
-     * @brief overviewToDoc:概况信息写到doc
-     * @param doc:doc文件
-     */
-    void overviewToDoc(Docx::Document &doc);
-
-    /**
-     * @brief overviewToXlsx:概况信息写到表格
-     * @param xlsx:xlsx文件
-     * @param boldFont:字体格式
-     */
-    void overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont);
-
-    /**
-     * @brief infoToHtml:将信息写到html中
-     * @param doc:文本
-     * @param key:关键字
-     * @param value:值
+     * @brief exportDevices:遍历一次设备，将概况与各类设备信息依次写入导出格式
+     * @param writer:已打开的导出格式
+     * @return true:导出成功，false:导出失败
      */
-    void infoToHtml(QDomDocument &doc, const QString &key, const QString &value);
+    bool exportDevices(ExportWriter &writer);
 
     /**
      * @brief getDeviceOverview:获取所有设备设备概况信息
@@ -650,6 +670,40 @@ protected:
     ~DeviceManager();
 
 private:
+    /**
+     * @brief hasDevice:该类设备已生成且不为空，生成中的类型不读取其列表
+     * @param deviceType:设备类型
+     * @return
+     */
+    bool hasDevice(DeviceType deviceType);
+
+    /**
+     * @brief deviceList:该类设备的列表，当前线程正在暂存该类设备时返回暂存列表
+     * @param deviceType:设备类型
+     * @return
+     */
+    QList<DeviceBaseInfo *> &deviceList(DeviceType deviceType);
+
+    /**
+     * @brief deviceIndex:该类设备按唯一标识(音频为路径)的索引，与 deviceList 对应
+     * @param deviceType:设备类型
+     * @return
+     */
+    QHash<QString, DeviceBaseInfo *> &deviceIndex(DeviceType deviceType);
+
+    /**
+     * @brief indexDevice:设备加入列表后建立索引，同一个标识只保留列表中靠前的设备
+     * @param deviceType:设备类型
+     * @param device:设备
+     */
+    void indexDevice(DeviceType deviceType, DeviceBaseInfo *device);
+
+    /**
+     * @brief rebuildIndex:设备移出列表后重建索引
+     * @param deviceType:设备类型
+     */
+    void rebuildIndex(DeviceType deviceType);
+
     static DeviceManager    *sInstance;
 
     QList<DeviceBaseInfo *>              m_ListDeviceMouse;                //<! 鼠标设备
@@ -671,17 +725,22 @@ private:
     QList<DeviceBaseInfo *>              m_ListDeviceComputer;             //<! 计算机基本信息
     QList<DeviceBaseInfo *>              m_ListDeviceCdrom;                //<! cdrom设备
 
+    QHash<QString, DeviceBaseInfo *>     m_DeviceIndex[DT_Others + 1];     //<! 按唯一标识(音频为路径)查找设备的索引
+
     QList<QPair<QString, QString>>       m_ListDeviceType;                 //<! 所有的设备类型及其对应的图标
     QStringList                                    m_BusIdList;            //<! 所有的设备总线ID
     QMap<QString, QList<QMap<QString, QString> > > m_cmdInfo;              //<! 所有设备信息获取命令
+    QHash<QString, QList<QMap<QString, QString> > > m_FrozenCmdInfo;       //<! 冻结后的只读索引
+    std::atomic<bool>                              m_CmdInfoFrozen;        //<! 命令信息是否已冻结
     QMap<QString, QString>                         m_OveriewMap;           //<! 所有的设备与其对应概况信息
     QMap<QString, QList<DeviceBaseInfo *>>         m_DeviceClassMap;       //<! 所有的设备类型与其对应设备列表
     QMap<QString, QMap<QString, QStringList>>      m_DeviceDriverPool;     //<! 所有的设备驱动与与其对应的设备类型，设备名称列表
     QMap<QString, QMap<QString, QString> >         m_InputDeviceInfo;
 
     int                                            m_CpuNum;               //<! 物理cpu个数
+    std::atomic<qint64>                            m_AddCmdWaitTime;       //<! 等待addCmdMutex的累计时间(ns)
+    std::atomic<quint32>                           m_GeneratingTypes;      //<! 正在生成的设备类型，按 DeviceType 位记录
 
-    static int m_CurrentXlsRow;       //<! xlsx表格当前行
     QStringList m_networkDriver; //网络驱动
 };
 
@@ -21,6 +21,7 @@ DeviceMemory::DeviceMemory()
 
 void DeviceMemory::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting memory info from lshw data";
     // 由lshw设置基本信息
     setAttribute(mapInfo, "product", m_Name, false);
@@ -63,6 +64,7 @@ void DeviceMemory::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceMemory::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting memory info from TOML one by one";
     TomlFixMethod ret = TOML_None;
         // 添加基本信息
@@ -86,6 +88,7 @@ TomlFixMethod DeviceMemory::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 bool DeviceMemory::setInfoFromDmidecode(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting memory info from dmidecode data";
     // 由 locator属性判断是否为同一内存条
     if (mapInfo["Locator"] != m_Locator || m_MatchedFromDmi == true) {
@@ -12,6 +12,8 @@
 
 // Qt库文件
 #include <QLoggingCategory>
+#include <QCoreApplication>
+#include <QProcessEnvironment>
 #include <QDate>
 #include <QSize>
 #include <QRegularExpression>
@@ -126,6 +128,7 @@ QString DeviceMonitor::parseMonitorSize(const QString &sizeDescription, double &
 
 void DeviceMonitor::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting monitor info from hwinfo data";
     //设置由hwinfo --monitor获取信息
     setAttribute(mapInfo, "Model", m_Name);
@@ -174,6 +177,7 @@ void DeviceMonitor::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceMonitor::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting monitor info from TOML configuration";
     m_IsTomlSet = true;
     TomlFixMethod ret = TOML_None;
@@ -203,6 +207,7 @@ TomlFixMethod DeviceMonitor::setInfoFromTomlOneByOne(const QMap<QString, QString
 
 void DeviceMonitor::setInfoFromSelfDefine(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting monitor info from self-defined map";
     setAttribute(mapInfo, "Name", m_Name);
     setAttribute(mapInfo, "Vendor", m_Vendor);
@@ -217,6 +222,7 @@ void DeviceMonitor::setInfoFromSelfDefine(const QMap<QString, QString> &mapInfo)
 
 void DeviceMonitor::setInfoFromEdid(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting monitor info from EDID data";
     m_Name = "Monitor " + mapInfo["Vendor"];
     setAttribute(mapInfo, "Size", m_ScreenSize);
@@ -231,6 +237,7 @@ void DeviceMonitor::setInfoFromEdid(const QMap<QString, QString> &mapInfo)
 
 void DeviceMonitor::setInfoFromDbus(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting monitor info from D-Bus data";
     if (mapInfo["Name"].toLower().contains(m_DisplayInput.toLower(), Qt::CaseInsensitive)) {
         qCDebug(appLog) << "Monitor name contains display input, setting current resolution";
@@ -251,6 +258,7 @@ QString DeviceMonitor::transWeekToDate(const QString &year, const QString &week)
 
 bool DeviceMonitor::setInfoFromXradr(const QString &main, const QString &edid, const QString &rate)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting monitor info from xrandr";
     if(m_IsTomlSet) {
         qCDebug(appLog) << "Monitor info already set from TOML, skipping xrandr";
@@ -292,7 +300,7 @@ bool DeviceMonitor::setInfoFromXradr(const QString &main, const QString &edid, c
     }
 
     // wayland xrandr --verbose无法获取edid信息
-    if (qApp->isDXcbPlatform()) {
+    if (isXcbPlatform()) {
         // 根据edid计算屏幕大小
         if (edid.isEmpty()) {
             qCDebug(appLog) << "EDID is empty, returning false";
@@ -400,6 +408,7 @@ void DeviceMonitor::loadTableData()
 
 bool DeviceMonitor::setMainInfoFromXrandr(const QString &info, const QString &rate)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Setting main info from xrandr";
     //  bug89456：显示设备接口类型DP，VGA，HDMI，eDP，DisplayPort
     //  还可能会有其它接口类型，为了避免每一次遇到新的接口类型就要修改代码
@@ -413,7 +422,7 @@ bool DeviceMonitor::setMainInfoFromXrandr(const QString &info, const QString &ra
     }
 
     // wayland xrandr --verbose无primary信息
-    if (qApp->isDXcbPlatform()) {
+    if (isXcbPlatform()) {
         qCDebug(appLog) << "Running on XCB platform, checking for primary display";
         // 设置是否是主显示器
         if (info.contains("primary")) {
@@ -556,3 +565,17 @@ bool DeviceMonitor::caculateScreenSize(const QString &edid)
     m_ScreenSize = QString("%1 %2(%3mm X %4mm)").arg(QString::number(inch, '0', 1)).arg(QObject::tr("inch")).arg(width).arg(height);
     return true;
 }
+
+bool DeviceMonitor::isXcbPlatform()
+{
+    DApplication *app = qobject_cast<DApplication *>(QCoreApplication::instance());
+    if (app)
+        return app->isDXcbPlatform();
+
+    // 无界面导出没有平台插件，与界面启动时的 wayland 判断一致
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    bool waylandMode = env.value("XDG_SESSION_TYPE") == QLatin1String("wayland")
+                       || env.value("WAYLAND_DISPLAY").contains(QLatin1String("wayland"), Qt::CaseInsensitive);
+    qCDebug(appLog) << "No DApplication, wayland mode:" << waylandMode;
+    return !waylandMode;
+}
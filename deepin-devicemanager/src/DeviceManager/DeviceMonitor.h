@@ -184,6 +184,12 @@ private:
      */
     bool caculateScreenSize(const QString &edid);
 
+    /**
+     * @brief isXcbPlatform:是否运行在xcb平台，wayland下xrandr无法获取edid与主显示器信息
+     * 无界面导出时只有QCoreApplication，根据会话类型判断
+     * @return 布尔值，true:xcb平台；false:其它平台
+     */
+    static bool isXcbPlatform();
 
 
 private:
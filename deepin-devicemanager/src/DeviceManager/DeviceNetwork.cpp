@@ -50,6 +50,7 @@ DeviceNetwork::DeviceNetwork()
 
 void DeviceNetwork::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceNetwork::setInfoFromLshw";
     if (!matchToLshw(mapInfo)
         && Common::boardVendorType() != "KLVV" && Common::boardVendorType() != "KLVU"
@@ -128,6 +129,7 @@ void DeviceNetwork::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceNetwork::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceNetwork::setInfoFromTomlOneByOne";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息
@@ -160,6 +162,7 @@ TomlFixMethod DeviceNetwork::setInfoFromTomlOneByOne(const QMap<QString, QString
 
 bool DeviceNetwork::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceNetwork::setInfoFromHwinfo";
     if (mapInfo.find("path") != mapInfo.end()) {
         qCDebug(appLog) << "DeviceNetwork::setInfoFromHwinfo, mapInfo contains path";
@@ -206,6 +209,7 @@ bool DeviceNetwork::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceNetwork::setInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceNetwork::setInfoFromWifiInfo";
     // 机器自身蓝牙
     if (m_Name.contains("Huawei", Qt::CaseInsensitive)) {
@@ -223,6 +227,7 @@ bool DeviceNetwork::setInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceNetwork::setIsWireless(const QString &sysfs)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceNetwork::setIsWireless";
     // 路径下包含 phy80211 或 wireless 是无线网卡
     QFileInfo fileInfo(QString("/sys") + sysfs);
@@ -270,6 +275,7 @@ const QString DeviceNetwork::getOverviewInfo()
 
 EnableDeviceStatus DeviceNetwork::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceNetwork::setEnable, enable:" << e;
     m_HardwareClass = "network interface";
     // 设置设备状态
@@ -299,6 +305,7 @@ bool DeviceNetwork::enable()
 
 void DeviceNetwork::correctCurrentLinkStatus(QString linkStatus)
 {
+    setAttribsDirty();
     // qCDebug(appLog) << "DeviceNetwork::correctCurrentLinkStatus";
     if (m_Link != linkStatus)
         m_Link = linkStatus;
@@ -25,6 +25,7 @@ DeviceOtherPCI::DeviceOtherPCI()
 
 TomlFixMethod DeviceOtherPCI::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceOtherPCI::setInfoFromTomlOneByOne";
     TomlFixMethod ret = TOML_None;
    // 添加基本信息
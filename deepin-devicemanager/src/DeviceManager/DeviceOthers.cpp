@@ -27,6 +27,7 @@ DeviceOthers::DeviceOthers()
 
 void DeviceOthers::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceOthers::setInfoFromLshw";
     if (!matchToLshw(mapInfo)) {
         qCDebug(appLog) << "DeviceOthers::setInfoFromLshw, not match to lshw";
@@ -61,6 +62,7 @@ void DeviceOthers::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
 
 TomlFixMethod DeviceOthers::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceOthers::setInfoFromTomlOneByOne";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息
@@ -78,6 +80,7 @@ TomlFixMethod DeviceOthers::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 void DeviceOthers::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceOthers::setInfoFromHwinfo";
     // 设置设备基本属性
     setAttribute(mapInfo, "Device", m_Name);
@@ -133,6 +136,7 @@ void DeviceOthers::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 EnableDeviceStatus DeviceOthers::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceOthers::setEnable, enable:" << e;
     if (m_SerialID.isEmpty()) {
         qCDebug(appLog) << "DeviceOthers::setEnable, serial id is empty";
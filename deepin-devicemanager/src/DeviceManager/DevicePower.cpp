@@ -44,6 +44,7 @@ DevicePower::DevicePower()
 
 TomlFixMethod DevicePower::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DevicePower::setInfoFromTomlOneByOne";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息    
@@ -68,6 +69,7 @@ TomlFixMethod DevicePower::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 bool DevicePower::setInfoFromUpower(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DevicePower::setInfoFromUpower";
     // 设置upower中获取的信息
     if (mapInfo["Device"].contains("line_power", Qt::CaseInsensitive)) {
@@ -113,6 +115,7 @@ bool DevicePower::setInfoFromUpower(const QMap<QString, QString> &mapInfo)
 
 void DevicePower::setDaemonInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DevicePower::setDaemonInfo";
     // 设置守护进程信息
     if (m_Name == QObject::tr("battery"))
@@ -33,6 +33,7 @@ DevicePrint::DevicePrint()
 
 TomlFixMethod DevicePrint::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DevicePrint::setInfoFromTomlOneByOne";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息
@@ -51,6 +52,7 @@ TomlFixMethod DevicePrint::setInfoFromTomlOneByOne(const QMap<QString, QString>
 
 void DevicePrint::setInfo(const QMap<QString, QString> &info)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DevicePrint::setInfo";
     // 获取打印机类型和型号
     QString vt;
@@ -125,6 +127,7 @@ const QString DevicePrint::getOverviewInfo()
 
 EnableDeviceStatus DevicePrint::setEnable(bool e)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DevicePrint::setEnable, enable:" << e;
     bool res  = DBusEnableInterface::getInstance()->enablePrinter("printer", m_Name, m_URI, e);
     if (res) {
@@ -5,6 +5,7 @@
 // 项目自身文件
 #include "DeviceStorage.h"
 #include "commonfunction.h"
+#include "commondefine.h"
 #include <cmath>
 
 // Qt库文件
@@ -39,6 +40,7 @@ DeviceStorage::DeviceStorage()
 
 TomlFixMethod DeviceStorage::setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::setInfoFromTomlOneByOne";
     TomlFixMethod ret = TOML_None;
     // 添加基本信息
@@ -137,6 +139,7 @@ static quint64 convertToBytes(const QString& size, double scale)
 
 void DeviceStorage::unitConvertByDecimal()
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::unitConvertByDecimal";
     if(m_SizeBytes > 0)
         m_Size = decimalkilos(m_SizeBytes);
@@ -156,6 +159,7 @@ void DeviceStorage::unitConvertByDecimal()
 
 bool DeviceStorage::setHwinfoInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Set hwinfo info for storage device";
     // 龙芯机器中 hwinfo --disk会列出所有的分区信息
     // 存储设备不应包含分区，根据SysFS BusID 来确定是否是分区信息
@@ -340,6 +344,7 @@ QString DeviceStorage::getSerialID(QString &strDeviceLink)
 
 bool DeviceStorage::setKLUHwinfoInfo(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::setKLUHwinfoInfo";
     // 龙芯机器中 hwinfo --disk会列出所有的分区信息
     // 存储设备不应包含分区，根据SysFS BusID 来确定是否是分区信息
@@ -402,6 +407,7 @@ bool DeviceStorage::setKLUHwinfoInfo(const QMap<QString, QString> &mapInfo)
 
 bool DeviceStorage::addInfoFromlshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "Add lshw info for storage device";
     // 先获取需要进行匹配的关键字
     QStringList keys = mapInfo["bus info"].split("@");
@@ -440,6 +446,7 @@ bool DeviceStorage::addInfoFromlshw(const QMap<QString, QString> &mapInfo)
 
 bool DeviceStorage::addNVMEInfoFromlshw(const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::addNVMEInfoFromlshw";
     QStringList keys = mapInfo["bus info"].split("@");
     if (keys.size() != 2)
@@ -463,18 +470,23 @@ bool DeviceStorage::addNVMEInfoFromlshw(const QMap<QString, QString> &mapInfo)
 
 bool DeviceStorage::addInfoFromSmartctl(const QString &name, const QMap<QString, QString> &mapInfo)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::addInfoFromSmartctl";
     // 查看传入的设备信息与当前的设备信息是不是同一个设备信息
     if (!m_DeviceFile.contains(name, Qt::CaseInsensitive))
         return false;
 
-    // 获取基本信息
-    getInfoFromsmartctl(mapInfo);
+    // 获取基本信息，后台通过ioctl读取的记录字段固定，直接使用
+    if (mapInfo.contains(DISK_KEY_INTERFACE))
+        getInfoFromDiskIdentify(mapInfo);
+    else
+        getInfoFromsmartctl(mapInfo);
     return true;
 }
 
 bool DeviceStorage::setMediaType(const QString &name, const QString &value)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::setMediaType";
     if (!m_DeviceFile.contains(name)) {
         qCDebug(appLog) << "DeviceStorage::setMediaType, device file does not contain name";
@@ -497,6 +509,7 @@ bool DeviceStorage::setMediaType(const QString &name, const QString &value)
 
 bool DeviceStorage::setKLUMediaType(const QString &name, const QString &value)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::setKLUMediaType";
     if (!m_DeviceFile.contains(name)) {
         qCDebug(appLog) << "DeviceStorage::setKLUMediaType, device file does not contain name";
@@ -536,6 +549,7 @@ bool DeviceStorage::isValid()
 
 void DeviceStorage::setDiskSerialID(const QString &deviceFiles)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::setDiskSerialID";
     // Serial ID 与 device Files 中信息一致
     if (!m_SerialNumber.isEmpty() && deviceFiles.contains(m_SerialNumber))
@@ -573,6 +587,7 @@ QString DeviceStorage::getDiskSerialID()
 
 void DeviceStorage::appendDisk(DeviceStorage *device)
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::appendDisk";
     QList<QPair<QString, QString> > allAttribs = device->getBaseAttribs();
     QMap<QString, QString> allAttribMaps;
@@ -621,6 +636,7 @@ void DeviceStorage::appendDisk(DeviceStorage *device)
 
 void DeviceStorage::checkDiskSize()
 {
+    setAttribsDirty();
     qCDebug(appLog) << "DeviceStorage::checkDiskSize";
     QRegularExpression reg("[0-9]*.?[0-9]*");
     int index = reg.match(m_Size).capturedStart();
@@ -831,6 +847,58 @@ void DeviceStorage::getInfoFromLshw(const QMap<QString, QString> &mapInfo)
         m_SerialNumber = "";
 }
 
+void DeviceStorage::getInfoFromDiskIdentify(const QMap<QString, QString> &mapInfo)
+{
+    setAttribsDirty();
+    qCDebug(appLog) << "DeviceStorage::getInfoFromDiskIdentify";
+    // 记录中的标识字段总是存在，不需要像smartctl文本那样按字段数量判断是否有效
+    // 没有读到型号时与smartctl信息不足一致：USB硬盘按固态硬盘处理
+    if (mapInfo.value(DISK_KEY_MODEL).isEmpty()) {
+        if (m_Interface.contains("USB", Qt::CaseInsensitive)) {
+            qCDebug(appLog) << "DeviceStorage::getInfoFromDiskIdentify, model is empty and interface contains USB";
+            m_MediaType = QObject::tr("SSD");
+        }
+        return;
+    }
+    setAttribute(mapInfo, DISK_KEY_MODEL, m_Name);
+    setAttribute(mapInfo, DISK_KEY_SERIAL, m_SerialNumber, true);
+    setAttribute(mapInfo, DISK_KEY_FIRMWARE, m_FirmwareVersion);
+
+    // 速度，格式与smartctl一致：SATA 3.2, 6.0 Gb/s (current: 6.0 Gb/s)
+    QStringList strList = mapInfo.value(DISK_KEY_SATA_VERSION).split(",");
+    if (strList.size() == 2)
+        m_Speed = strList[1];
+
+    // 转速
+    QString rotation = mapInfo.value(DISK_KEY_ROTATION_RATE);
+    if (rotation == "1") {
+        m_RotationRate = "Solid State Device";
+        m_MediaType = QObject::tr("SSD");
+    } else if (rotation == "HW_SSD") {
+        // 按照HW的需求，如果是固态硬盘就不显示转速
+        m_RotationRate = "";
+        m_MediaType = QObject::tr("SSD");
+    } else if (rotation.toInt() > 1) {
+        m_RotationRate = QString("%1 rpm").arg(rotation);
+    }
+
+    // 容量
+    bool isValue = false;
+    quint64 bytes = mapInfo.value(DISK_KEY_CAPACITY).toULongLong(&isValue);
+    if (isValue && bytes > 0) {
+        m_SizeBytes = bytes;
+        setAttribute(mapInfo, DISK_KEY_CAPACITY_TEXT, m_Size);
+    }
+
+    // 修正数值
+    if(Common::boardVendorType() != "KLVV" && Common::boardVendorType() != "KLVU" \
+        && Common::boardVendorType() != "PGUW" && Common::boardVendorType() != "PGUV")
+            m_Size.replace(QRegularExpression("\\.0[1-9]"), ".00");
+    //根据产品PN中的固定前两位 RS来匹配厂商 为Longsys
+    if (m_Name.startsWith("RS") && m_Vendor.isEmpty())
+        m_Vendor = "Longsys";
+}
+
 void DeviceStorage::getInfoFromsmartctl(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "DeviceStorage::getInfoFromsmartctl";
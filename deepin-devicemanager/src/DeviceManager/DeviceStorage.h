@@ -95,6 +95,12 @@ public:
      */
     void getInfoFromsmartctl(const QMap<QString, QString> &mapInfo);
 
+    /**
+     * @brief getInfoFromDiskIdentify:设置由后台ioctl读取的硬盘标识记录，字段见 DISK_KEY_*
+     * @param mapInfo:硬盘标识记录map
+     */
+    void getInfoFromDiskIdentify(const QMap<QString, QString> &mapInfo);
+
     /**
      * @brief isValid:判断设备信息是否有效
      * @return 布尔值:true-设备信息有效；false--设备信息无效
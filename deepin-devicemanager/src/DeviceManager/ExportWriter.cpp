@@ -0,0 +1,610 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ExportWriter.h"
+#include "ZipStreamWriter.h"
+#include "DDLog.h"
+
+#include <QLoggingCategory>
+
+#include <private/qzipreader_p.h>
+
+using namespace DDLog;
+
+#define EXPORT_FLUSH_SIZE   (64 * 1024)     // 缓冲的 xml 超过该大小后压缩写入
+#define EXPORT_SEPARATOR    "-------------------------------------------------"
+#define TXT_KEY_WIDTH       21              // txt 中属性名称的宽度
+
+static const char DOCX_DOCUMENT[] = "word/document.xml";
+static const char XML_HEADER[] = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+
+/**
+ * @brief xmlEscaped:转义 xml 文本，去掉 xml 中不允许出现的控制字符
+ */
+static QString xmlEscaped(const QString &text)
+{
+    QString value = text;
+    for (int i = value.size() - 1; i >= 0; --i) {
+        ushort ch = value.at(i).unicode();
+        if (ch < 0x20 && ch != '\t' && ch != '\n' && ch != '\r')
+            value.remove(i, 1);
+    }
+    return value.toHtmlEscaped();
+}
+
+ExportWriter::~ExportWriter()
+{
+}
+
+bool TxtExportWriter::open(const QString &filePath)
+{
+    m_File.setFileName(filePath);
+    if (false == m_File.open(QIODevice::WriteOnly))
+        return false;
+
+    m_Out.setDevice(&m_File);
+    return true;
+}
+
+bool TxtExportWriter::close()
+{
+    m_Out.flush();
+    bool ok = m_Out.status() == QTextStream::Ok && m_File.error() == QFileDevice::NoError;
+    m_File.close();
+    return ok;
+}
+
+void TxtExportWriter::overview(const QString &title, const QList<QPair<QString, QString>> &info)
+{
+    m_Out << "[" << title << "]\n" EXPORT_SEPARATOR;
+    m_Out << "\n";
+    writeInfo(info);
+    m_Out << "\n";
+}
+
+void TxtExportWriter::beginSection(const QString &title)
+{
+    m_Out << "[" << title << "]\n" EXPORT_SEPARATOR;
+}
+
+void TxtExportWriter::emptySection(const QString &msg)
+{
+    m_Out << "\n";
+    m_Out << msg;
+}
+
+void TxtExportWriter::beginTable(const QStringList &header)
+{
+    if (header.isEmpty())
+        return;
+
+    // 设置占位宽度
+    m_Out.setFieldWidth(int(header[0].size() * 1.5));
+    m_Out.setFieldAlignment(QTextStream::AlignLeft);
+    m_Out << "\n";
+    foreach (const QString &item, header) {
+        m_Out.setFieldWidth(30);
+        m_Out << item;
+    }
+    m_Out.setFieldWidth(0);
+    m_Out << "\n";
+}
+
+void TxtExportWriter::tableRow(const QStringList &data)
+{
+    if (data.isEmpty())
+        return;
+
+    m_Out.setFieldAlignment(QTextStream::AlignRight);
+    foreach (const QString &item, data) {
+        m_Out.setFieldWidth(28);
+        m_Out << item;
+    }
+    m_Out.setFieldWidth(0);
+    m_Out << "\n";
+}
+
+void TxtExportWriter::endTable()
+{
+}
+
+void TxtExportWriter::beginDevice(const QString &subTitle)
+{
+    m_Out << "\n";
+    if (!subTitle.isEmpty()) {
+        m_Out << subTitle;
+        m_Out << "\n";
+    }
+}
+
+void TxtExportWriter::deviceInfo(const QList<QPair<QString, QString>> &info)
+{
+    writeInfo(info);
+}
+
+void TxtExportWriter::endDevice()
+{
+}
+
+void TxtExportWriter::endSection()
+{
+    m_Out << "\n";
+}
+
+void TxtExportWriter::writeInfo(const QList<QPair<QString, QString>> &info)
+{
+    for (const QPair<QString, QString> &item : info) {
+        // 设置第一列占21个字符
+        m_Out.setFieldWidth(TXT_KEY_WIDTH);
+        m_Out.setFieldAlignment(QTextStream::AlignLeft);
+        m_Out << item.first + ": ";
+        m_Out.setFieldWidth(0);
+        m_Out << item.second;
+        m_Out << "\n";
+    }
+}
+
+bool HtmlExportWriter::open(const QString &filePath)
+{
+    m_File.setFileName(filePath);
+    if (false == m_File.open(QIODevice::WriteOnly))
+        return false;
+
+    m_Error = false;
+    write("<!DOCTYPE html>\n<html>\n<body>\n");
+    return !m_Error;
+}
+
+bool HtmlExportWriter::close()
+{
+    write("</body>\n</html>\n");
+    m_File.close();
+    return !m_Error;
+}
+
+void HtmlExportWriter::overview(const QString &title, const QList<QPair<QString, QString>> &info)
+{
+    beginSection(title);
+    deviceInfo(info);
+    write("<br/>\n");
+}
+
+void HtmlExportWriter::beginSection(const QString &title)
+{
+    write("<h2>[" + xmlEscaped(title) + "]</h2>\n");
+}
+
+void HtmlExportWriter::emptySection(const QString &msg)
+{
+    write("<h2>" + xmlEscaped(msg) + "</h2>\n");
+}
+
+void HtmlExportWriter::beginTable(const QStringList &header)
+{
+    QString html = "<table border=\"0\" style=\"white-space:pre;\">\n<thead><tr>\n";
+    foreach (const QString &item, header)
+        html += "<th style=\"width:200px;text-align:left;\">" + xmlEscaped(item) + "</th>";
+    html += "</tr></thead>\n";
+    write(html);
+}
+
+void HtmlExportWriter::tableRow(const QStringList &data)
+{
+    QString html = "<tr>";
+    foreach (const QString &item, data)
+        html += "<td style=\"width:200px;text-align:left;\">" + xmlEscaped(item) + "</td>";
+    html += "</tr>\n";
+    write(html);
+}
+
+void HtmlExportWriter::endTable()
+{
+    write("</table>\n");
+}
+
+void HtmlExportWriter::beginDevice(const QString &subTitle)
+{
+    if (!subTitle.isEmpty())
+        write("<h3>" + xmlEscaped(subTitle) + "</h3>\n");
+}
+
+void HtmlExportWriter::deviceInfo(const QList<QPair<QString, QString>> &info)
+{
+    if (info.isEmpty())
+        return;
+
+    QString html = "<table border=\"0\" width=\"100%\" cellpadding=\"3\">\n";
+    for (const QPair<QString, QString> &item : info) {
+        html += " <tr>\n";
+        html += "  <td width=\"15%\" style=\"text-align:left;\">" + xmlEscaped(item.first) + ": </td>\n";
+        html += "  <td width=\"85%\">" + xmlEscaped(item.second) + "</td>\n";
+        html += " </tr>\n";
+    }
+    html += "</table>\n";
+    write(html);
+}
+
+void HtmlExportWriter::endDevice()
+{
+    write("<br/>\n");
+}
+
+void HtmlExportWriter::endSection()
+{
+}
+
+void HtmlExportWriter::write(const QString &html)
+{
+    QByteArray data = html.toUtf8();
+    if (m_File.write(data) != data.size())
+        m_Error = true;
+}
+
+DocExportWriter::DocExportWriter(const QString &templatePath)
+    : m_TemplatePath(templatePath)
+{
+}
+
+DocExportWriter::~DocExportWriter()
+{
+}
+
+bool DocExportWriter::open(const QString &filePath)
+{
+    m_File.setFileName(filePath);
+    if (false == m_File.open(QIODevice::WriteOnly))
+        return false;
+
+    mp_Zip.reset(new ZipStreamWriter(&m_File));
+    if (!copyTemplate())
+        return false;
+
+    // document.xml 模板中 sectPr 之前的内容先写入，之后的段落与表格都插在 sectPr 之前
+    flush(true);
+    return !mp_Zip->error();
+}
+
+bool DocExportWriter::close()
+{
+    if (mp_Zip.isNull())
+        return false;
+
+    m_Buffer.append(m_DocumentEnd);
+    flush(true);
+    bool ok = mp_Zip->close();
+    m_File.close();
+    return ok && m_File.error() == QFileDevice::NoError;
+}
+
+void DocExportWriter::overview(const QString &title, const QList<QPair<QString, QString>> &info)
+{
+    paragraph("[" + title + "]", "1");
+    paragraph(EXPORT_SEPARATOR);
+    deviceInfo(info);
+    paragraph(QString());
+}
+
+void DocExportWriter::beginSection(const QString &title)
+{
+    paragraph("[" + title + "]", "2");
+    paragraph(EXPORT_SEPARATOR);
+}
+
+void DocExportWriter::emptySection(const QString &msg)
+{
+    paragraph(msg);
+}
+
+void DocExportWriter::beginTable(const QStringList &header)
+{
+    // 没有列的表格不是有效的 docx，整个表格都不写
+    m_Columns = header.size();
+    if (m_Columns < 1)
+        return;
+
+    // 与 Docx::Document::addTable 生成的表格样式相同
+    m_Buffer.append("<w:tbl><w:tblPr><w:tblBorders>");
+    const char *const borders[] = {"top", "left", "bottom", "right", "insideH", "insideV"};
+    for (size_t i = 0; i < sizeof(borders) / sizeof(borders[0]); ++i)
+        m_Buffer.append(QString("<w:%1 w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>").arg(borders[i]).toUtf8());
+    m_Buffer.append("</w:tblBorders><w:tblStyle w:val=\"TableGrid\"/></w:tblPr><w:tblGrid>");
+    for (int col = 0; col < m_Columns; ++col)
+        m_Buffer.append("<w:gridCol w:w=\"1600\"/>");
+    m_Buffer.append("</w:tblGrid>");
+    row(header);
+}
+
+void DocExportWriter::tableRow(const QStringList &data)
+{
+    if (m_Columns > 0)
+        row(data);
+}
+
+void DocExportWriter::endTable()
+{
+    if (m_Columns > 0)
+        m_Buffer.append("</w:tbl>");
+    m_Columns = 0;
+    flush();
+}
+
+void DocExportWriter::beginDevice(const QString &subTitle)
+{
+    if (!subTitle.isEmpty())
+        paragraph(subTitle);
+}
+
+void DocExportWriter::deviceInfo(const QList<QPair<QString, QString>> &info)
+{
+    for (const QPair<QString, QString> &item : info)
+        paragraph(item.first + ":  " + item.second);
+}
+
+void DocExportWriter::endDevice()
+{
+    paragraph(QString());
+    flush();
+}
+
+void DocExportWriter::endSection()
+{
+}
+
+bool DocExportWriter::copyTemplate()
+{
+    m_Buffer.clear();
+    m_DocumentEnd.clear();
+
+    // 模板中除 document.xml 以外的部件原样复制
+    QZipReader reader(m_TemplatePath);
+    if (reader.status() == QZipReader::NoError) {
+        foreach (const QZipReader::FileInfo &info, reader.fileInfoList()) {
+            if (!info.isFile)
+                continue;
+
+            QByteArray data = reader.fileData(info.filePath);
+            if (info.filePath == DOCX_DOCUMENT) {
+                int sectPr = data.lastIndexOf("<w:sectPr");
+                if (sectPr < 0)
+                    sectPr = data.lastIndexOf("</w:body>");
+                if (sectPr >= 0) {
+                    m_Buffer = data.left(sectPr);
+                    m_DocumentEnd = data.mid(sectPr);
+                }
+            } else if (!mp_Zip->addFile(info.filePath, data)) {
+                return false;
+            }
+        }
+    }
+
+    if (m_DocumentEnd.isEmpty()) {
+        if (!reader.fileInfoList().isEmpty()) {
+            qCWarning(appLog) << "Invalid docx template:" << m_TemplatePath;
+            return false;
+        }
+
+        qCWarning(appLog) << "Failed to read docx template:" << m_TemplatePath << ", use the minimal package";
+        mp_Zip->addFile("[Content_Types].xml", QByteArray(XML_HEADER) +
+                        "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+                        "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+                        "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+                        "<Override PartName=\"/word/document.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.wordprocessingml.document.main+xml\"/>"
+                        "</Types>");
+        mp_Zip->addFile("_rels/.rels", QByteArray(XML_HEADER) +
+                        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                        "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"word/document.xml\"/>"
+                        "</Relationships>");
+        m_Buffer = QByteArray(XML_HEADER) +
+                   "<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"><w:body>";
+        m_DocumentEnd = "<w:sectPr/></w:body></w:document>";
+    }
+
+    return mp_Zip->beginFile(DOCX_DOCUMENT);
+}
+
+void DocExportWriter::paragraph(const QString &text, const QString &style)
+{
+    m_Buffer.append("<w:p>");
+    if (!style.isEmpty())
+        m_Buffer.append("<w:pPr><w:pStyle w:val=\"" + style.toUtf8() + "\"/></w:pPr>");
+    if (!text.isEmpty())
+        m_Buffer.append("<w:r><w:t xml:space=\"preserve\">" + xmlEscaped(text).toUtf8() + "</w:t></w:r>");
+    m_Buffer.append("</w:p>");
+}
+
+void DocExportWriter::row(const QStringList &cells)
+{
+    // 与 Docx::Table::addRow 生成的单元格相同，单元格中至少有一个段落
+    m_Buffer.append("<w:tr>");
+    for (int col = 0; col < m_Columns; ++col) {
+        m_Buffer.append("<w:tc><w:tcPr><w:tcW w:w=\"2000\" w:type=\"dxa\"/>"
+                        "<w:tcBorders><w:tl2br w:val=\"nil\"/><w:tr2bl w:val=\"nil\"/></w:tcBorders></w:tcPr>");
+        QString text = col < cells.size() ? cells[col] : QString();
+        if (text.isEmpty())
+            m_Buffer.append("<w:p/>");
+        else
+            m_Buffer.append("<w:p><w:r><w:t xml:space=\"preserve\">" + xmlEscaped(text).toUtf8() + "</w:t></w:r></w:p>");
+        m_Buffer.append("</w:tc>");
+    }
+    m_Buffer.append("</w:tr>");
+}
+
+void DocExportWriter::flush(bool force)
+{
+    if (mp_Zip.isNull() || (!force && m_Buffer.size() < EXPORT_FLUSH_SIZE))
+        return;
+
+    mp_Zip->write(m_Buffer);
+    m_Buffer.clear();
+}
+
+XlsxExportWriter::XlsxExportWriter()
+    : m_Row(1)
+{
+}
+
+XlsxExportWriter::~XlsxExportWriter()
+{
+}
+
+bool XlsxExportWriter::open(const QString &filePath)
+{
+    m_File.setFileName(filePath);
+    if (false == m_File.open(QIODevice::WriteOnly))
+        return false;
+
+    m_Row = 1;
+    m_Buffer.clear();
+    mp_Zip.reset(new ZipStreamWriter(&m_File));
+
+    // 只有一个工作表，样式固定为 CellStyle 中的四种
+    mp_Zip->addFile("[Content_Types].xml", QByteArray(XML_HEADER) +
+                    "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+                    "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+                    "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+                    "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+                    "<Override PartName=\"/xl/worksheets/sheet1.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>"
+                    "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+                    "</Types>");
+    mp_Zip->addFile("_rels/.rels", QByteArray(XML_HEADER) +
+                    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                    "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+                    "</Relationships>");
+    mp_Zip->addFile("xl/workbook.xml", QByteArray(XML_HEADER) +
+                    "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+                    "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+                    "<sheets><sheet name=\"Sheet1\" sheetId=\"1\" r:id=\"rId1\"/></sheets>"
+                    "</workbook>");
+    mp_Zip->addFile("xl/_rels/workbook.xml.rels", QByteArray(XML_HEADER) +
+                    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                    "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" Target=\"worksheets/sheet1.xml\"/>"
+                    "<Relationship Id=\"rId2\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" Target=\"styles.xml\"/>"
+                    "</Relationships>");
+    mp_Zip->addFile("xl/styles.xml", QByteArray(XML_HEADER) +
+                    "<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+                    "<fonts count=\"4\">"
+                    "<font><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+                    "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+                    "<font><b/><sz val=\"10\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+                    "<font><sz val=\"10\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+                    "</fonts>"
+                    "<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+                    "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+                    "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+                    "<cellXfs count=\"4\">"
+                    "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/>"
+                    "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+                    "<xf numFmtId=\"0\" fontId=\"2\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+                    "<xf numFmtId=\"0\" fontId=\"3\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+                    "</cellXfs>"
+                    "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+                    "</styleSheet>");
+
+    // sheet1.xml 最后写入，结束前一直处于打开状态
+    mp_Zip->beginFile("xl/worksheets/sheet1.xml");
+    m_Buffer.append(XML_HEADER);
+    m_Buffer.append("<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>");
+    return !mp_Zip->error();
+}
+
+bool XlsxExportWriter::close()
+{
+    if (mp_Zip.isNull())
+        return false;
+
+    m_Buffer.append("</sheetData></worksheet>");
+    flush(true);
+    bool ok = mp_Zip->close();
+    m_File.close();
+    return ok && m_File.error() == QFileDevice::NoError;
+}
+
+void XlsxExportWriter::overview(const QString &title, const QList<QPair<QString, QString>> &info)
+{
+    beginSection(title);
+    for (const QPair<QString, QString> &item : info)
+        row(QStringList() << item.first << item.second, CS_Info);
+    m_Row++;
+}
+
+void XlsxExportWriter::beginSection(const QString &title)
+{
+    row(QStringList() << "[" + title + "]", CS_Title);
+}
+
+void XlsxExportWriter::emptySection(const QString &msg)
+{
+    row(QStringList() << msg, CS_Title);
+}
+
+void XlsxExportWriter::beginTable(const QStringList &header)
+{
+    row(header, CS_Header);
+}
+
+void XlsxExportWriter::tableRow(const QStringList &data)
+{
+    row(data, CS_Normal);
+}
+
+void XlsxExportWriter::endTable()
+{
+}
+
+void XlsxExportWriter::beginDevice(const QString &subTitle)
+{
+    if (!subTitle.isEmpty())
+        row(QStringList() << subTitle, CS_Header);
+}
+
+void XlsxExportWriter::deviceInfo(const QList<QPair<QString, QString>> &info)
+{
+    for (const QPair<QString, QString> &item : info)
+        row(QStringList() << item.first << item.second, CS_Info);
+}
+
+void XlsxExportWriter::endDevice()
+{
+    // 设备之间空一行
+    m_Row++;
+    flush();
+}
+
+void XlsxExportWriter::endSection()
+{
+}
+
+void XlsxExportWriter::row(const QStringList &cells, CellStyle style)
+{
+    int curRow = m_Row++;
+    if (cells.isEmpty())
+        return;
+
+    QByteArray xml = "<row r=\"" + QByteArray::number(curRow) + "\">";
+    for (int col = 0; col < cells.size(); ++col) {
+        if (cells[col].isEmpty())
+            continue;
+
+        // 列名 A..Z、AA..
+        QByteArray ref;
+        for (int n = col + 1; n > 0; n = (n - 1) / 26)
+            ref.prepend(char('A' + (n - 1) % 26));
+        ref += QByteArray::number(curRow);
+
+        xml += "<c r=\"" + ref + "\" s=\"" + QByteArray::number(int(style)) + "\" t=\"inlineStr\"><is><t xml:space=\"preserve\">";
+        xml += xmlEscaped(cells[col]).toUtf8();
+        xml += "</t></is></c>";
+    }
+    xml += "</row>";
+    m_Buffer.append(xml);
+}
+
+void XlsxExportWriter::flush(bool force)
+{
+    if (mp_Zip.isNull() || (!force && m_Buffer.size() < EXPORT_FLUSH_SIZE))
+        return;
+
+    mp_Zip->write(m_Buffer);
+    m_Buffer.clear();
+}
@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EXPORTWRITER_H
+#define EXPORTWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+class ZipStreamWriter;
+
+/**
+ * @brief The ExportWriter class
+ * 导出信息的写入接口，DeviceManager::exportDevices 遍历一次设备，按以下顺序产生事件：
+ * overview，然后每个设备类型 beginSection、emptySection 或 beginTable/tableRow/endTable、
+ * 每个设备 beginDevice/deviceInfo/endDevice、endSection，最后 close。
+ * 各格式边接收事件边写文件，不在内存中保留整个文档
+ */
+class ExportWriter
+{
+public:
+    virtual ~ExportWriter();
+
+    /**
+     * @brief open:创建导出文件
+     * @param filePath:文件路径
+     * @return true:成功，false:失败
+     */
+    virtual bool open(const QString &filePath) = 0;
+
+    /**
+     * @brief close:写入文档结尾并关闭文件
+     * @return true:整个文件写入成功，false:有写入失败
+     */
+    virtual bool close() = 0;
+
+    /**
+     * @brief overview:概况信息
+     * @param title:标题
+     * @param info:概况信息列表
+     */
+    virtual void overview(const QString &title, const QList<QPair<QString, QString>> &info) = 0;
+
+    /**
+     * @brief beginSection:开始一个设备类型
+     * @param title:设备类型
+     */
+    virtual void beginSection(const QString &title) = 0;
+
+    /**
+     * @brief emptySection:该设备类型没有设备
+     * @param msg:提示信息
+     */
+    virtual void emptySection(const QString &msg) = 0;
+
+    /**
+     * @brief beginTable:开始设备表格，设备多于一个时才有表格
+     * @param header:表头
+     */
+    virtual void beginTable(const QStringList &header) = 0;
+
+    /**
+     * @brief tableRow:设备表格中的一行
+     * @param data:表格内容
+     */
+    virtual void tableRow(const QStringList &data) = 0;
+
+    /**
+     * @brief endTable:结束设备表格
+     */
+    virtual void endTable() = 0;
+
+    /**
+     * @brief beginDevice:开始一个设备的详细信息
+     * @param subTitle:子标题，设备只有一个时为空
+     */
+    virtual void beginDevice(const QString &subTitle) = 0;
+
+    /**
+     * @brief deviceInfo:设备的一组信息，基本信息与其他信息各一组，只包含有效的属性值
+     * @param info:信息列表
+     */
+    virtual void deviceInfo(const QList<QPair<QString, QString>> &info) = 0;
+
+    /**
+     * @brief endDevice:结束一个设备的详细信息
+     */
+    virtual void endDevice() = 0;
+
+    /**
+     * @brief endSection:结束一个设备类型
+     */
+    virtual void endSection() = 0;
+};
+
+/**
+ * @brief The TxtExportWriter class
+ * 导出txt
+ */
+class TxtExportWriter : public ExportWriter
+{
+public:
+    bool open(const QString &filePath) override;
+    bool close() override;
+    void overview(const QString &title, const QList<QPair<QString, QString>> &info) override;
+    void beginSection(const QString &title) override;
+    void emptySection(const QString &msg) override;
+    void beginTable(const QStringList &header) override;
+    void tableRow(const QStringList &data) override;
+    void endTable() override;
+    void beginDevice(const QString &subTitle) override;
+    void deviceInfo(const QList<QPair<QString, QString>> &info) override;
+    void endDevice() override;
+    void endSection() override;
+
+private:
+    void writeInfo(const QList<QPair<QString, QString>> &info);
+
+    QFile           m_File;     //<! 导出文件
+    QTextStream     m_Out;      //<! 文件输出流
+};
+
+/**
+ * @brief The HtmlExportWriter class
+ * 导出html，直接写标签，不再为每个设备构造 QDomDocument
+ */
+class HtmlExportWriter : public ExportWriter
+{
+public:
+    bool open(const QString &filePath) override;
+    bool close() override;
+    void overview(const QString &title, const QList<QPair<QString, QString>> &info) override;
+    void beginSection(const QString &title) override;
+    void emptySection(const QString &msg) override;
+    void beginTable(const QStringList &header) override;
+    void tableRow(const QStringList &data) override;
+    void endTable() override;
+    void beginDevice(const QString &subTitle) override;
+    void deviceInfo(const QList<QPair<QString, QString>> &info) override;
+    void endDevice() override;
+    void endSection() override;
+
+private:
+    void write(const QString &html);
+
+    QFile       m_File;     //<! 导出文件
+    bool        m_Error = false;    //<! 是否有写入失败
+};
+
+/**
+ * @brief The DocExportWriter class
+ * 导出docx，复制模板中的其他部件，document.xml 边生成边压缩写入
+ */
+class DocExportWriter : public ExportWriter
+{
+public:
+    /**
+     * @brief DocExportWriter
+     * @param templatePath:docx 模板，读取失败时使用最简单的文档结构
+     */
+    explicit DocExportWriter(const QString &templatePath = QStringLiteral(":/template.docx"));
+    ~DocExportWriter() override;
+
+    bool open(const QString &filePath) override;
+    bool close() override;
+    void overview(const QString &title, const QList<QPair<QString, QString>> &info) override;
+    void beginSection(const QString &title) override;
+    void emptySection(const QString &msg) override;
+    void beginTable(const QStringList &header) override;
+    void tableRow(const QStringList &data) override;
+    void endTable() override;
+    void beginDevice(const QString &subTitle) override;
+    void deviceInfo(const QList<QPair<QString, QString>> &info) override;
+    void endDevice() override;
+    void endSection() override;
+
+private:
+    bool copyTemplate();
+    void paragraph(const QString &text, const QString &style = QString());
+    void row(const QStringList &cells);
+    void flush(bool force = false);
+
+    QString                         m_TemplatePath;     //<! docx 模板
+    QFile                           m_File;             //<! 导出文件
+    QScopedPointer<ZipStreamWriter> mp_Zip;             //<! 压缩写入
+    QByteArray                      m_DocumentEnd;      //<! document.xml 中 sectPr 及之后的内容
+    QByteArray                      m_Buffer;           //<! 待压缩的 document.xml 内容
+    int                             m_Columns = 0;      //<! 当前表格的列数
+};
+
+/**
+ * @brief The XlsxExportWriter class
+ * 导出xlsx，单元格使用内联字符串，sheet1.xml 按行边生成边压缩写入
+ */
+class XlsxExportWriter : public ExportWriter
+{
+public:
+    XlsxExportWriter();
+    ~XlsxExportWriter() override;
+
+    bool open(const QString &filePath) override;
+    bool close() override;
+    void overview(const QString &title, const QList<QPair<QString, QString>> &info) override;
+    void beginSection(const QString &title) override;
+    void emptySection(const QString &msg) override;
+    void beginTable(const QStringList &header) override;
+    void tableRow(const QStringList &data) override;
+    void endTable() override;
+    void beginDevice(const QString &subTitle) override;
+    void deviceInfo(const QList<QPair<QString, QString>> &info) override;
+    void endDevice() override;
+    void endSection() override;
+
+private:
+    /**
+     * @brief The CellStyle enum : styles.xml 中 cellXfs 的序号
+     */
+    enum CellStyle {
+        CS_Normal,      // 默认字体，表格内容
+        CS_Title,       // 加粗，设备类型与提示信息
+        CS_Header,      // 加粗10号，表头与子标题
+        CS_Info         // 10号，属性
+    };
+
+    void row(const QStringList &cells, CellStyle style);
+    void flush(bool force = false);
+
+    QFile                           m_File;     //<! 导出文件
+    QScopedPointer<ZipStreamWriter> mp_Zip;     //<! 压缩写入
+    QByteArray                      m_Buffer;   //<! 待压缩的 sheet1.xml 内容
+    int                             m_Row;      //<! 下一个写入的行号，从1开始
+};
+
+#endif // EXPORTWRITER_H
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "KernelModuleInfo.h"
+#include "DDLog.h"
+
+#include <QFile>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+
+#include <libkmod.h>
+
+using namespace DDLog;
+
+KernelModuleInfo *KernelModuleInfo::instance()
+{
+    // 局部静态变量的初始化是线程安全的，设备生成线程会同时查询
+    static KernelModuleInfo moduleInfo;
+    return &moduleInfo;
+}
+
+KernelModuleInfo::Info KernelModuleInfo::info(const QString &name)
+{
+    if (name.isEmpty())
+        return Info();
+
+    QMutexLocker locker(&m_Mutex);
+    QHash<QString, Info>::const_iterator it = m_Cache.constFind(name);
+    if (it != m_Cache.constEnd())
+        return it.value();
+
+    Info moduleInfo = lookup(name);
+    m_Cache.insert(name, moduleInfo);
+    return moduleInfo;
+}
+
+void KernelModuleInfo::invalidate()
+{
+    QMutexLocker locker(&m_Mutex);
+    qCDebug(appLog) << "KernelModuleInfo::invalidate, cached modules:" << m_Cache.size();
+    m_Cache.clear();
+    if (mp_Ctx) {
+        kmod_unref(mp_Ctx);
+        mp_Ctx = nullptr;
+    }
+}
+
+KernelModuleInfo::KernelModuleInfo()
+    : mp_Ctx(nullptr)
+{
+}
+
+KernelModuleInfo::~KernelModuleInfo()
+{
+    if (mp_Ctx)
+        kmod_unref(mp_Ctx);
+}
+
+KernelModuleInfo::Info KernelModuleInfo::lookup(const QString &name)
+{
+    Info moduleInfo;
+    if (!mp_Ctx) {
+        mp_Ctx = kmod_new(nullptr, nullptr);
+        if (!mp_Ctx) {
+            qCWarning(appLog) << "kmod_new() failed!";
+            return moduleInfo;
+        }
+        // 预先加载索引文件，之后的查询不再重复打开
+        kmod_load_resources(mp_Ctx);
+    }
+
+    // 与 modinfo 相同，参数为文件时按文件查询，否则按模块名称与别名查询
+    QByteArray modName = name.toUtf8();
+    if (QFile::exists(name)) {
+        struct kmod_module *mod = nullptr;
+        if (kmod_module_new_from_path(mp_Ctx, modName.constData(), &mod) >= 0 && mod) {
+            readModule(mod, moduleInfo);
+            kmod_module_unref(mod);
+        }
+    } else {
+        struct kmod_list *modList = nullptr;
+        if (kmod_module_new_from_lookup(mp_Ctx, modName.constData(), &modList) >= 0 && modList) {
+            struct kmod_list *item = nullptr;
+            kmod_list_foreach(item, modList) {
+                struct kmod_module *mod = kmod_module_get_module(item);
+                readModule(mod, moduleInfo);
+                kmod_module_unref(mod);
+            }
+            kmod_module_unref_list(modList);
+        }
+    }
+
+    qCDebug(appLog) << "Module:" << name << "found:" << moduleInfo.found << "builtin:" << moduleInfo.builtin
+                    << "filename:" << moduleInfo.filename << "version:" << moduleInfo.version;
+    return moduleInfo;
+}
+
+void KernelModuleInfo::readModule(kmod_module *mod, Info &moduleInfo)
+{
+    // 别名可能对应多个模块，与 modinfo 的输出一样取第一个模块的文件和第一个 version
+    if (!moduleInfo.found) {
+        const char *path = kmod_module_get_path(mod);
+        moduleInfo.found = true;
+        moduleInfo.builtin = !path;
+        moduleInfo.filename = QString::fromUtf8(path);
+    }
+
+    if (!moduleInfo.version.isEmpty())
+        return;
+
+    struct kmod_list *infoList = nullptr;
+    if (kmod_module_get_info(mod, &infoList) < 0)
+        return;
+
+    struct kmod_list *item = nullptr;
+    kmod_list_foreach(item, infoList) {
+        if (qstrcmp(kmod_module_info_get_key(item), "version") == 0) {
+            moduleInfo.version = QString::fromUtf8(kmod_module_info_get_value(item)).trimmed();
+            break;
+        }
+    }
+    kmod_module_info_free_list(infoList);
+}
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KERNELMODULEINFO_H
+#define KERNELMODULEINFO_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+struct kmod_ctx;
+struct kmod_module;
+
+/**
+ * @brief The KernelModuleInfo class
+ * 通过 libkmod 查询内核模块信息，代替执行 modinfo，结果按模块名缓存，驱动安装或卸载后清空
+ */
+class KernelModuleInfo
+{
+public:
+    /**
+     * @brief The Info struct : 模块信息，与 modinfo 的输出对应
+     */
+    struct Info {
+        bool    found = false;      //<! 模块是否存在，不存在时 modinfo 报错
+        bool    builtin = false;    //<! 是否为内建模块，此时 modinfo 显示 filename: (builtin)
+        QString filename;           //<! 模块文件路径，内建模块为空
+        QString version;            //<! 模块信息中的 version
+    };
+
+    static KernelModuleInfo *instance();
+
+    /**
+     * @brief info:获取模块信息，与 modinfo 相同，也可以是模块别名或模块文件路径
+     * @param name:模块名称
+     * @return 模块信息
+     */
+    Info info(const QString &name);
+
+    /**
+     * @brief invalidate:清空缓存，驱动安装或卸载后模块及索引文件可能变化
+     */
+    void invalidate();
+
+private:
+    KernelModuleInfo();
+    ~KernelModuleInfo();
+
+    Info lookup(const QString &name);
+    static void readModule(kmod_module *mod, Info &moduleInfo);
+
+    QMutex                  m_Mutex;    //<! kmod_ctx 不是线程安全的，查询与缓存都需要加锁
+    kmod_ctx               *mp_Ctx;     //<! 第一次查询时创建，清空缓存时释放
+    QHash<QString, Info>    m_Cache;    //<! 模块名称对应的模块信息
+};
+
+#endif // KERNELMODULEINFO_H
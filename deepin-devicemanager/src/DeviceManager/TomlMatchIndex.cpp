@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "TomlMatchIndex.h"
+#include "DeviceInfo.h"
+#include "DeviceBios.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+#define MAX_PART_LENGTH 32    // VIDAndPID 超过该长度时不建立子串索引
+
+TomlMatchIndex::TomlMatchIndex(DeviceType deviceType)
+    : m_Type(deviceType)
+    , m_NextOrder(0)
+{
+}
+
+void TomlMatchIndex::insert(DeviceBaseInfo *device)
+{
+    if (!device || m_Keys.contains(device))
+        return;
+
+    Keys &keys = m_Keys[device];
+    keys.order = m_NextOrder++;
+    indexKeys(device, keys);
+}
+
+void TomlMatchIndex::update(DeviceBaseInfo *device)
+{
+    QHash<DeviceBaseInfo *, Keys>::iterator it = m_Keys.find(device);
+    if (it == m_Keys.end()) {
+        insert(device);
+        return;
+    }
+
+    unindexKeys(device, it.value());
+    Keys keys;
+    keys.order = it.value().order;
+    indexKeys(device, keys);
+    m_Keys[device] = keys;
+}
+
+void TomlMatchIndex::remove(DeviceBaseInfo *device)
+{
+    QHash<DeviceBaseInfo *, Keys>::iterator it = m_Keys.find(device);
+    if (it == m_Keys.end())
+        return;
+
+    unindexKeys(device, it.value());
+    m_Keys.erase(it);
+}
+
+QList<DeviceBaseInfo *> TomlMatchIndex::match(const QString &modalias, const QString &vid, const QString &pid,
+                                              const QString &vendor, const QString &name) const
+{
+    QSet<DeviceBaseInfo *> found;
+
+    // findByModalias: modalias 相同，或自定义的 modalias 中包含设备 VIDAndPID 的前4位与第5到8位
+    if (!modalias.isEmpty()) {
+        foreach (DeviceBaseInfo *device, m_Modalias.values(modalias.toCaseFolded()))
+            found.insert(device);
+
+        if (!modalias.startsWith("pci") && !modalias.startsWith("usb")) {
+            QString lower = modalias.toLower();
+            for (int length = 0; length <= 4 && length <= lower.size(); ++length) {
+                QSet<QString> windows;
+                for (int i = 0; i + length <= lower.size(); ++i)
+                    windows.insert(lower.mid(i, length));
+                foreach (const QString &window, windows) {
+                    foreach (DeviceBaseInfo *device, m_ShortVid.values(window)) {
+                        if (lower.contains(m_Keys.constFind(device)->shortPid))
+                            found.insert(device);
+                    }
+                }
+            }
+        }
+    }
+
+    // findByVIDPID: VID 与 PID 相同，设备缺少 VID 或 PID 时 VIDAndPID 同时包含两者
+    if (!vid.isEmpty() && !pid.isEmpty()) {
+        QString refVid = stripHex(vid);
+        QString refPid = stripHex(pid);
+        foreach (DeviceBaseInfo *device, m_VidPid.values(qMakePair(refVid, refPid)))
+            found.insert(device);
+
+        const QList<DeviceBaseInfo *> &candidates = refVid.isEmpty() ? m_VidAndPidAll : m_VidAndPidPart.values(refVid) + m_VidAndPidLong;
+        foreach (DeviceBaseInfo *device, candidates) {
+            const QString &vidAndPid = m_Keys.constFind(device)->vidAndPid;
+            if (vidAndPid.contains(refVid) && vidAndPid.contains(refPid))
+                found.insert(device);
+        }
+    }
+
+    // findByVendorName: Vendor 与 Name 相同，BIOS 只比较 toml 名称，计算机信息只有一条，总是相同
+    if (!name.isEmpty()) {
+        if (m_Type == DT_Computer) {
+            for (QHash<DeviceBaseInfo *, Keys>::const_iterator it = m_Keys.constBegin(); it != m_Keys.constEnd(); ++it)
+                found.insert(it.key());
+        } else if (m_Type == DT_Bios) {
+            foreach (DeviceBaseInfo *device, m_VendorName.values(qMakePair(QString(), name.toCaseFolded())))
+                found.insert(device);
+        } else if (!vendor.isEmpty()) {
+            foreach (DeviceBaseInfo *device, m_VendorName.values(qMakePair(vendor.toCaseFolded(), name.toCaseFolded())))
+                found.insert(device);
+        }
+    }
+
+    QList<DeviceBaseInfo *> lst = found.values();
+    std::sort(lst.begin(), lst.end(), [this](DeviceBaseInfo *first, DeviceBaseInfo *second) {
+        return m_Keys.constFind(first)->order < m_Keys.constFind(second)->order;
+    });
+    return lst;
+}
+
+void TomlMatchIndex::indexKeys(DeviceBaseInfo *device, Keys &keys)
+{
+    keys.modalias = device->getModalias().toCaseFolded();
+    if (!keys.modalias.isEmpty())
+        m_Modalias.insert(keys.modalias, device);
+
+    QString vidAndPid = device->getVIDAndPID().toLower();
+    keys.hasShortId = !vidAndPid.isEmpty();
+    if (keys.hasShortId) {
+        QString shortId = stripHex(vidAndPid);
+        keys.shortVid = shortId.mid(0, 4);
+        keys.shortPid = shortId.mid(4, 4);
+        m_ShortVid.insert(keys.shortVid, device);
+    }
+
+    QString vid = stripHex(device->getVID());
+    QString pid = stripHex(device->getPID());
+    if (!vid.isEmpty() && !pid.isEmpty()) {
+        keys.vidPid = qMakePair(vid, pid);
+        m_VidPid.insert(keys.vidPid, device);
+    } else if (!vidAndPid.isEmpty()) {
+        keys.vidAndPid = vidAndPid;
+        m_VidAndPidAll.append(device);
+        if (vidAndPid.size() > MAX_PART_LENGTH) {
+            m_VidAndPidLong.append(device);
+        } else {
+            foreach (const QString &part, parts(vidAndPid))
+                m_VidAndPidPart.insert(part, device);
+        }
+    }
+
+    if (m_Type == DT_Bios) {
+        DeviceBios *bios = dynamic_cast<DeviceBios *>(device);
+        if (bios)
+            keys.vendorName = qMakePair(QString(), bios->tomlname().toCaseFolded());
+    } else if (m_Type != DT_Computer) {
+        keys.vendorName = qMakePair(device->vendor().toCaseFolded(), device->name().toCaseFolded());
+    }
+    if (!keys.vendorName.second.isEmpty())
+        m_VendorName.insert(keys.vendorName, device);
+}
+
+void TomlMatchIndex::unindexKeys(DeviceBaseInfo *device, const Keys &keys)
+{
+    if (!keys.modalias.isEmpty())
+        m_Modalias.remove(keys.modalias, device);
+    if (keys.hasShortId)
+        m_ShortVid.remove(keys.shortVid, device);
+    if (!keys.vidPid.first.isEmpty())
+        m_VidPid.remove(keys.vidPid, device);
+    if (!keys.vidAndPid.isEmpty()) {
+        m_VidAndPidAll.removeOne(device);
+        if (keys.vidAndPid.size() > MAX_PART_LENGTH) {
+            m_VidAndPidLong.removeOne(device);
+        } else {
+            foreach (const QString &part, parts(keys.vidAndPid))
+                m_VidAndPidPart.remove(part, device);
+        }
+    }
+    if (!keys.vendorName.second.isEmpty())
+        m_VendorName.remove(keys.vendorName, device);
+}
+
+QString TomlMatchIndex::stripHex(const QString &value)
+{
+    return value.toLower().remove("0x");
+}
+
+QStringList TomlMatchIndex::parts(const QString &value)
+{
+    // 所有不为空的子串，去重
+    QSet<QString> set;
+    for (int i = 0; i < value.size(); ++i) {
+        for (int length = 1; i + length <= value.size(); ++length)
+            set.insert(value.mid(i, length));
+    }
+    return set.values();
+}
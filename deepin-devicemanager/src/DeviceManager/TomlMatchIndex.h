@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TOMLMATCHINDEX_H
+#define TOMLMATCHINDEX_H
+
+#include "GenerateDevicePool.h"
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+class DeviceBaseInfo;
+
+/**
+ * @brief The TomlMatchIndex class
+ * toml 条目与已有设备的匹配索引，设备一侧的 Modalias、VID/PID、Vendor/Name 只归一化一次，
+ * 匹配规则与 DeviceManager::findByModalias、findByVIDPID、findByVendorName 相同
+ */
+class TomlMatchIndex
+{
+public:
+    explicit TomlMatchIndex(DeviceType deviceType);
+
+    /**
+     * @brief insert:加入设备，匹配结果按加入的先后排序
+     * @param device:设备
+     */
+    void insert(DeviceBaseInfo *device);
+
+    /**
+     * @brief update:设备的匹配信息变化后重新索引，保持原来的先后
+     * @param device:设备
+     */
+    void update(DeviceBaseInfo *device);
+
+    /**
+     * @brief remove:移除设备
+     * @param device:设备
+     */
+    void remove(DeviceBaseInfo *device);
+
+    /**
+     * @brief match:查找与 toml 条目相同的设备，参数为 DeviceManager::PhysID 的结果
+     * @param modalias:Modalias
+     * @param vid:Vendor_ID
+     * @param pid:Product_ID
+     * @param vendor:Vendor
+     * @param name:Name
+     * @return 相同的设备，按加入的先后排序
+     */
+    QList<DeviceBaseInfo *> match(const QString &modalias, const QString &vid, const QString &pid,
+                                  const QString &vendor, const QString &name) const;
+
+private:
+    /**
+     * @brief The Keys struct : 设备归一化后的匹配信息
+     */
+    struct Keys {
+        qint64                  order = 0;          //<! 加入的先后
+        QString                 modalias;           //<! Modalias，忽略大小写
+        bool                    hasShortId = false; //<! VIDAndPID 是否不为空
+        QString                 shortVid;           //<! VIDAndPID 去掉 0x 后的前4位
+        QString                 shortPid;           //<! VIDAndPID 去掉 0x 后的第5到8位
+        QPair<QString, QString> vidPid;             //<! 去掉 0x 的 VID 与 PID，两者都不为空时有效
+        QString                 vidAndPid;          //<! VID 或 PID 为空时按包含关系比较的 VIDAndPID
+        QPair<QString, QString> vendorName;         //<! Vendor 与 Name，忽略大小写
+    };
+
+    void indexKeys(DeviceBaseInfo *device, Keys &keys);
+    void unindexKeys(DeviceBaseInfo *device, const Keys &keys);
+
+    static QString stripHex(const QString &value);
+    static QStringList parts(const QString &value);
+
+    DeviceType                                                 m_Type;
+    qint64                                                     m_NextOrder;
+    QHash<DeviceBaseInfo *, Keys>                              m_Keys;          //<! 所有设备的匹配信息
+    QMultiHash<QString, DeviceBaseInfo *>                      m_Modalias;      //<! Modalias 相同
+    QMultiHash<QString, DeviceBaseInfo *>                      m_ShortVid;      //<! 自定义 Modalias 中包含 VID
+    QMultiHash<QPair<QString, QString>, DeviceBaseInfo *>      m_VidPid;        //<! VID 与 PID 相同
+    QMultiHash<QString, DeviceBaseInfo *>                      m_VidAndPidPart; //<! VIDAndPID 的子串
+    QList<DeviceBaseInfo *>                                    m_VidAndPidAll;  //<! 按包含关系比较 VIDAndPID 的设备
+    QList<DeviceBaseInfo *>                                    m_VidAndPidLong; //<! VIDAndPID 过长，不建立子串索引的设备
+    QMultiHash<QPair<QString, QString>, DeviceBaseInfo *>      m_VendorName;    //<! Vendor 与 Name 相同
+};
+
+#endif // TOMLMATCHINDEX_H
@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ZipStreamWriter.h"
+#include "DDLog.h"
+
+#include <QDateTime>
+#include <QIODevice>
+#include <QLoggingCategory>
+
+#include <cstring>
+
+using namespace DDLog;
+
+#define ZIP_OUT_BUFFER_SIZE     (64 * 1024)
+#define ZIP_VERSION             20          // 2.0，deflate 与数据描述符
+#define ZIP_FLAG_DESCRIPTOR     0x0008      // 大小与校验值在数据描述符中
+#define ZIP_FLAG_UTF8           0x0800      // 文件名为 UTF-8
+#define ZIP_METHOD_DEFLATE      8
+
+static void appendUInt16(QByteArray &buf, quint16 value)
+{
+    buf.append(char(value & 0xff));
+    buf.append(char((value >> 8) & 0xff));
+}
+
+static void appendUInt32(QByteArray &buf, quint32 value)
+{
+    appendUInt16(buf, quint16(value & 0xffff));
+    appendUInt16(buf, quint16(value >> 16));
+}
+
+ZipStreamWriter::ZipStreamWriter(QIODevice *device)
+    : mp_Device(device)
+    , m_OutBuffer(ZIP_OUT_BUFFER_SIZE, Qt::Uninitialized)
+    , m_InFile(false)
+    , m_Closed(false)
+    , m_Error(!device || !device->isWritable())
+    , m_Offset(0)
+{
+    memset(&m_Stream, 0, sizeof(m_Stream));
+
+    // 压缩包中的文件都使用创建时的时间
+    QDateTime now = QDateTime::currentDateTime();
+    QDate date = now.date();
+    QTime time = now.time();
+    m_DosDate = quint16(((qMax(date.year(), 1980) - 1980) << 9) | (date.month() << 5) | date.day());
+    m_DosTime = quint16((time.hour() << 11) | (time.minute() << 5) | (time.second() / 2));
+}
+
+ZipStreamWriter::~ZipStreamWriter()
+{
+    if (m_InFile)
+        deflateEnd(&m_Stream);
+}
+
+bool ZipStreamWriter::beginFile(const QString &fileName)
+{
+    if (m_Closed || m_Error)
+        return false;
+    if (m_InFile && !endFile())
+        return false;
+
+    if (deflateInit2(&m_Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        qCWarning(appLog) << "deflateInit2 failed:" << fileName;
+        m_Error = true;
+        return false;
+    }
+
+    m_InFile = true;
+    m_Current = Entry();
+    m_Current.name = fileName.toUtf8();
+    m_Current.crc = quint32(crc32(0, Z_NULL, 0));
+    m_Current.offset = m_Offset;
+
+    // 本地文件头，校验值与大小为0，实际值在数据描述符中
+    QByteArray header;
+    appendUInt32(header, 0x04034b50);
+    appendUInt16(header, ZIP_VERSION);
+    appendUInt16(header, ZIP_FLAG_DESCRIPTOR | ZIP_FLAG_UTF8);
+    appendUInt16(header, ZIP_METHOD_DEFLATE);
+    appendUInt16(header, m_DosTime);
+    appendUInt16(header, m_DosDate);
+    appendUInt32(header, 0);
+    appendUInt32(header, 0);
+    appendUInt32(header, 0);
+    appendUInt16(header, quint16(m_Current.name.size()));
+    appendUInt16(header, 0);
+    header.append(m_Current.name);
+    return writeRaw(header);
+}
+
+bool ZipStreamWriter::write(const QByteArray &data)
+{
+    if (!m_InFile || m_Error)
+        return false;
+    if (data.isEmpty())
+        return true;
+
+    m_Current.crc = quint32(crc32(m_Current.crc, reinterpret_cast<const Bytef *>(data.constData()), uInt(data.size())));
+    m_Current.size += quint32(data.size());
+    return deflateTo(data.constData(), uInt(data.size()), Z_NO_FLUSH);
+}
+
+bool ZipStreamWriter::endFile()
+{
+    if (!m_InFile)
+        return !m_Error;
+
+    bool ok = deflateTo(nullptr, 0, Z_FINISH);
+    deflateEnd(&m_Stream);
+    m_InFile = false;
+    if (!ok)
+        return false;
+
+    QByteArray descriptor;
+    appendUInt32(descriptor, 0x08074b50);
+    appendUInt32(descriptor, m_Current.crc);
+    appendUInt32(descriptor, m_Current.compressedSize);
+    appendUInt32(descriptor, m_Current.size);
+    if (!writeRaw(descriptor))
+        return false;
+
+    m_Entries.append(m_Current);
+    return true;
+}
+
+bool ZipStreamWriter::addFile(const QString &fileName, const QByteArray &data)
+{
+    return beginFile(fileName) && write(data) && endFile();
+}
+
+bool ZipStreamWriter::close()
+{
+    if (m_Closed)
+        return !m_Error;
+    if (m_InFile)
+        endFile();
+    m_Closed = true;
+    if (m_Error)
+        return false;
+
+    // 中央目录
+    quint32 directoryOffset = m_Offset;
+    QByteArray directory;
+    foreach (const Entry &entry, m_Entries) {
+        appendUInt32(directory, 0x02014b50);
+        appendUInt16(directory, ZIP_VERSION);
+        appendUInt16(directory, ZIP_VERSION);
+        appendUInt16(directory, ZIP_FLAG_DESCRIPTOR | ZIP_FLAG_UTF8);
+        appendUInt16(directory, ZIP_METHOD_DEFLATE);
+        appendUInt16(directory, m_DosTime);
+        appendUInt16(directory, m_DosDate);
+        appendUInt32(directory, entry.crc);
+        appendUInt32(directory, entry.compressedSize);
+        appendUInt32(directory, entry.size);
+        appendUInt16(directory, quint16(entry.name.size()));
+        appendUInt16(directory, 0);     // 扩展字段长度
+        appendUInt16(directory, 0);     // 注释长度
+        appendUInt16(directory, 0);     // 起始磁盘
+        appendUInt16(directory, 0);     // 内部属性
+        appendUInt32(directory, 0);     // 外部属性
+        appendUInt32(directory, entry.offset);
+        directory.append(entry.name);
+    }
+    if (!writeRaw(directory))
+        return false;
+
+    // 中央目录结束记录
+    QByteArray end;
+    appendUInt32(end, 0x06054b50);
+    appendUInt16(end, 0);
+    appendUInt16(end, 0);
+    appendUInt16(end, quint16(m_Entries.size()));
+    appendUInt16(end, quint16(m_Entries.size()));
+    appendUInt32(end, m_Offset - directoryOffset);
+    appendUInt32(end, directoryOffset);
+    appendUInt16(end, 0);
+    return writeRaw(end);
+}
+
+bool ZipStreamWriter::error() const
+{
+    return m_Error;
+}
+
+bool ZipStreamWriter::deflateTo(const char *data, uInt size, int flush)
+{
+    m_Stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    m_Stream.avail_in = size;
+
+    // 每次压缩输出到固定大小的缓冲区，满了就写入设备
+    int ret = Z_OK;
+    do {
+        m_Stream.next_out = reinterpret_cast<Bytef *>(m_OutBuffer.data());
+        m_Stream.avail_out = uInt(m_OutBuffer.size());
+        ret = deflate(&m_Stream, flush);
+        if (ret == Z_STREAM_ERROR) {
+            qCWarning(appLog) << "deflate failed:" << m_Current.name;
+            m_Error = true;
+            return false;
+        }
+
+        uInt produced = uInt(m_OutBuffer.size()) - m_Stream.avail_out;
+        if (produced > 0) {
+            m_Current.compressedSize += produced;
+            if (!writeRaw(QByteArray::fromRawData(m_OutBuffer.constData(), int(produced))))
+                return false;
+        }
+    } while (m_Stream.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+
+    return true;
+}
+
+bool ZipStreamWriter::writeRaw(const QByteArray &data)
+{
+    if (m_Error)
+        return false;
+
+    if (mp_Device->write(data) != data.size()) {
+        qCWarning(appLog) << "Failed to write zip data:" << mp_Device->errorString();
+        m_Error = true;
+        return false;
+    }
+    m_Offset += quint32(data.size());
+    return true;
+}
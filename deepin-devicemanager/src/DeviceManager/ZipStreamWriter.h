@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ZIPSTREAMWRITER_H
+#define ZIPSTREAMWRITER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include <zlib.h>
+
+class QIODevice;
+
+/**
+ * @brief The ZipStreamWriter class
+ * 边压缩边写入的 zip 写入器，文件内容分段写入设备，大小与校验值写在文件数据之后，
+ * 内存中只保留压缩缓冲区与目录项，用于流式生成 xlsx、docx
+ */
+class ZipStreamWriter
+{
+public:
+    explicit ZipStreamWriter(QIODevice *device);
+    ~ZipStreamWriter();
+
+    /**
+     * @brief beginFile:开始写入压缩包中的文件，上一个文件未结束时先结束
+     * @param fileName:压缩包中的文件路径
+     * @return true:成功，false:失败
+     */
+    bool beginFile(const QString &fileName);
+
+    /**
+     * @brief write:压缩并写入当前文件的一段内容
+     * @param data:文件内容
+     * @return true:成功，false:失败
+     */
+    bool write(const QByteArray &data);
+
+    /**
+     * @brief endFile:结束当前文件，写入数据描述符
+     * @return true:成功，false:失败
+     */
+    bool endFile();
+
+    /**
+     * @brief addFile:写入一个完整的文件
+     * @param fileName:压缩包中的文件路径
+     * @param data:文件内容
+     * @return true:成功，false:失败
+     */
+    bool addFile(const QString &fileName, const QByteArray &data);
+
+    /**
+     * @brief close:写入中央目录，之后不能再写入文件
+     * @return true:整个压缩包写入成功，false:有写入失败
+     */
+    bool close();
+
+    /**
+     * @brief error:是否有写入失败
+     * @return true:有写入失败
+     */
+    bool error() const;
+
+private:
+    /**
+     * @brief The Entry struct : 中央目录中的文件项
+     */
+    struct Entry {
+        QByteArray  name;                   //<! 文件路径，UTF-8
+        quint32     crc = 0;                //<! 未压缩内容的 CRC32
+        quint32     compressedSize = 0;     //<! 压缩后的大小
+        quint32     size = 0;               //<! 未压缩的大小
+        quint32     offset = 0;             //<! 本地文件头在压缩包中的位置
+    };
+
+    bool deflateTo(const char *data, uInt size, int flush);
+    bool writeRaw(const QByteArray &data);
+
+    QIODevice       *mp_Device;         //<! 输出设备，由调用者打开与关闭
+    z_stream         m_Stream;          //<! 当前文件的 deflate 状态
+    QByteArray       m_OutBuffer;       //<! 压缩输出缓冲区，大小固定
+    QList<Entry>     m_Entries;         //<! 已写入的文件
+    Entry            m_Current;         //<! 正在写入的文件
+    bool             m_InFile;          //<! 是否正在写入文件
+    bool             m_Closed;          //<! 是否已写入中央目录
+    bool             m_Error;           //<! 是否有写入失败
+    quint32          m_Offset;          //<! 已写入的字节数
+    quint16          m_DosTime;         //<! 文件修改时间，DOS 格式
+    quint16          m_DosDate;         //<! 文件修改日期，DOS 格式
+};
+
+#endif // ZIPSTREAMWRITER_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "DBusDriverInterface.h"
+#include "KernelModuleInfo.h"
 #include "DDLog.h"
 #include <unistd.h>
 
@@ -142,6 +143,8 @@ void DBusDriverInterface::slotProcessChange(qint32 value, QString detail)
 void DBusDriverInterface::slotProcessEnd(bool success, QString msg)
 {
     qCDebug(appLog) << "DBusDriverInterface::slotProcessEnd";
+    // 驱动安装或卸载结束，模块信息可能已经变化
+    KernelModuleInfo::instance()->invalidate();
     if (success) {
         qCDebug(appLog) << "DBusDriverInterface::slotProcessEnd, success";
         emit processChange(100, "");
@@ -172,6 +175,7 @@ void DBusDriverInterface::slotDownloadFinished()
 void DBusDriverInterface::slotInstallProgressFinished(bool bsuccess, int err)
 {
     qCDebug(appLog) << "DBusDriverInterface::slotInstallProgressFinished";
+    KernelModuleInfo::instance()->invalidate();
     emit installProgressFinished(bsuccess, err);
 }
 
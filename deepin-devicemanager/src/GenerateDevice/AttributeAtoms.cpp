@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "AttributeAtoms.h"
+
+#include <QVector>
+
+#include <algorithm>
+
+// hwinfo 与 lshw 输出中出现的属性名，以及解析时生成的属性名
+static const char *const ATTRIBUTE_NAMES[] = {
+    // hwinfo
+    "Attached to", "BIOS id", "Capacity", "Compatible to", "Config Status", "Device", "Device File",
+    "Device Files", "Device Number", "Driver", "Driver Activation Cmd", "Driver Info #0", "Driver Modules",
+    "Driver Status", "HW Address", "Hardware Class", "Hotplug", "I/O Ports", "IRQ", "Link detected",
+    "Memory Range", "Model", "Module Alias", "Parent ID", "Permanent HW Address", "Resolution", "Revision",
+    "Serial ID", "Size", "Speed", "SubDevice", "SubVendor", "SysFS BusID", "SysFS Device Link", "SysFS ID",
+    "Unique ID", "Vendor", "Year of Manufacture",
+    // 解析时生成
+    "PID", "PsubID", "VID", "VID_PID", "VsubID", "cfg_avail",
+    // lshw
+    "ansiversion", "autonegotiation", "broadcast", "bus info", "capabilities", "capacity", "clock",
+    "configuration", "description", "driver", "driverversion", "duplex", "firmware", "ioport", "ip", "irq",
+    "latency", "link", "logical name", "memory", "multicast", "physical id", "port", "product", "resources",
+    "serial", "size", "slot", "speed", "vendor", "version", "width",
+};
+
+static const QVector<QString> &atoms()
+{
+    // 局部静态变量的初始化是线程安全的
+    static const QVector<QString> table = []() {
+        QVector<QString> names;
+        for (size_t i = 0; i < sizeof(ATTRIBUTE_NAMES) / sizeof(ATTRIBUTE_NAMES[0]); ++i)
+            names.append(QString::fromLatin1(ATTRIBUTE_NAMES[i]));
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        return names;
+    }();
+    return table;
+}
+
+int AttributeAtoms::indexOf(QStringView key)
+{
+    const QVector<QString> &table = atoms();
+    QVector<QString>::const_iterator it = std::lower_bound(table.constBegin(), table.constEnd(), key,
+    [](const QString &atom, QStringView value) {
+        return QStringView(atom).compare(value) < 0;
+    });
+    if (it == table.constEnd() || QStringView(*it) != key)
+        return -1;
+    return static_cast<int>(it - table.constBegin());
+}
+
+QString AttributeAtoms::intern(QStringView key)
+{
+    int index = indexOf(key);
+    return index < 0 ? key.toString() : atoms().at(index);
+}
+
+int AttributeAtoms::count()
+{
+    return atoms().size();
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATTRIBUTEATOMS_H
+#define ATTRIBUTEATOMS_H
+
+#include <QString>
+#include <QStringView>
+
+/**
+ * @brief The AttributeAtoms class
+ * 设备属性名的驻留表，hwinfo/lshw 中常见的属性名只保存一份，
+ * 解析出的 map 中相同的属性名共享同一份字符串数据
+ */
+class AttributeAtoms
+{
+public:
+    /**
+     * @brief indexOf:在驻留表中查找属性名，不分配内存
+     * @param key:属性名
+     * @return 在表中的位置，不存在返回-1
+     */
+    static int indexOf(QStringView key);
+
+    /**
+     * @brief intern:获取属性名的共享字符串
+     * @param key:属性名
+     * @return 表中存在时返回共享的字符串，否则返回key的拷贝
+     */
+    static QString intern(QStringView key);
+
+    /**
+     * @brief count:驻留表中属性名的个数
+     * @return
+     */
+    static int count();
+};
+
+#endif // ATTRIBUTEATOMS_H
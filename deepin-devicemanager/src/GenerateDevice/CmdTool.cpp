@@ -17,6 +17,8 @@
 
 // 其它头文件
 #include "../commondefine.h"
+#include "HwinfoTokenizer.h"
+#include "AttributeAtoms.h"
 #include "EDIDParser.h"
 #include "DeviceManager.h"
 #include "DBusInterface.h"
@@ -321,10 +323,18 @@ void CmdTool::loadLshwInfo(const QString &debugFile)
     QString deviceInfo;
     getDeviceInfo(deviceInfo, debugFile);
 
-    // 根据设备类型解析lshw信息
-    QStringList items = deviceInfo.split("*-");
+    // 根据设备类型解析lshw信息，按"*-"逐段遍历，每段都是原文的视图
+    QList<QStringView> memoryItems;
+    QStringView text(deviceInfo);
+    qsizetype begin = 0;
     bool isFirst = true;
-    foreach (const QString &item, items) {
+    while (begin <= text.size()) {
+        qsizetype end = text.indexOf(u"*-", begin);
+        if (end < 0)
+            end = text.size();
+        QStringView item = text.mid(begin, end - begin);
+        begin = end + 2;
+
         QMap<QString, QString> mapInfo;
         if (isFirst) {
             qCDebug(appLog) << "Parsing lshw system info.";
@@ -335,61 +345,58 @@ void CmdTool::loadLshwInfo(const QString &debugFile)
             continue;
         }
 
-        // CPU 信息
-        if (item.startsWith("cpu")) {
-            qCDebug(appLog) << "Parsing lshw cpu info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_cpu", mapInfo);
-        } else if (item.startsWith("disk")) {         // 存储设备信息
-            qCDebug(appLog) << "Parsing lshw disk info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_disk", mapInfo);
-        } else if (item.startsWith("storage")) {
-            qCDebug(appLog) << "Parsing lshw storage info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_storage", mapInfo);
-#ifdef __sw_64__
-        } else if ((item.startsWith("memory") && !item.startsWith("memory UNCLAIMED")) || item.startsWith("bank")) {      // 内存信息
-#else
-        } else if (item.startsWith("bank")) {      // 内存信息
-#endif
-            qCDebug(appLog) << "Parsing lshw memory info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_memory", mapInfo);
-        } else if (item.startsWith("display")) {      // 显卡信息
-            qCDebug(appLog) << "Parsing lshw display info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_display", mapInfo);
-        } else if (item.startsWith("multimedia")) {   // 音频信息
-            qCDebug(appLog) << "Parsing lshw multimedia info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_multimedia", mapInfo);
-        } else if (item.startsWith("network")) {      // 网卡信息
-            qCDebug(appLog) << "Parsing lshw network info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_network", mapInfo);
-        } else if (item.startsWith("usb")) {          // USB 设备信息
-            qCDebug(appLog) << "Parsing lshw usb info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_usb", mapInfo);
-        } else if (item.startsWith("cdrom")) {        // 光盘信息
-            qCDebug(appLog) << "Parsing lshw cdrom info.";
-            getMapInfoFromLshw(item, mapInfo);
-            addMapInfo("lshw_cdrom", mapInfo);
-        }
+        // 没有bank信息时使用memory信息，记录下来避免再遍历一次
+        if (item.startsWith(u"memory"))
+            memoryItems.append(item);
+
+        const char *key = lshwItemKey(item);
+        if (!key)
+            continue;
+        qCDebug(appLog) << "Parsing lshw info:" << key;
+        getMapInfoFromLshw(item, mapInfo);
+        addMapInfo(key, mapInfo);
     }
     if (!m_cmdInfo.contains("lshw_memory")) {     // 内存信息
         qCDebug(appLog) << "Parsing lshw memory info (fallback).";
-        foreach (const QString &item, items) {
-            if (item.startsWith("memory")) {
-                QMap<QString, QString> mapInfo;
-                getMapInfoFromLshw(item, mapInfo);
-                addMapInfo("lshw_memory", mapInfo);
-            }
+        foreach (const QStringView &item, memoryItems) {
+            QMap<QString, QString> mapInfo;
+            getMapInfoFromLshw(item, mapInfo);
+            addMapInfo("lshw_memory", mapInfo);
         }
     }
 }
 
+const char *CmdTool::lshwItemKey(QStringView item)
+{
+    // lshw 段的类别前缀 -> 缓存关键字
+    static const struct {
+        const char *prefix;
+        const char *exclude;
+        const char *key;
+    } table[] = {
+        { "cpu", nullptr, "lshw_cpu" },
+        { "disk", nullptr, "lshw_disk" },                      // 存储设备信息
+        { "storage", nullptr, "lshw_storage" },
+#ifdef __sw_64__
+        { "memory", "memory UNCLAIMED", "lshw_memory" },       // 内存信息
+#endif
+        { "bank", nullptr, "lshw_memory" },                    // 内存信息
+        { "display", nullptr, "lshw_display" },                // 显卡信息
+        { "multimedia", nullptr, "lshw_multimedia" },          // 音频信息
+        { "network", nullptr, "lshw_network" },                // 网卡信息
+        { "usb", nullptr, "lshw_usb" },                        // USB 设备信息
+        { "cdrom", nullptr, "lshw_cdrom" },                    // 光盘信息
+    };
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); ++i) {
+        if (!item.startsWith(QLatin1String(table[i].prefix)))
+            continue;
+        if (table[i].exclude && item.startsWith(QLatin1String(table[i].exclude)))
+            continue;
+        return table[i].key;
+    }
+    return nullptr;
+}
+
 void CmdTool::loadLsblkInfo(const QString &debugfile)
 {
     qCDebug(appLog) << "Loading lsblk info from" << debugfile;
@@ -464,7 +471,11 @@ void CmdTool::loadSmartCtlInfo(const QString &logicalName, const QString &debugf
     // 硬盘逻辑名称
     mapInfo["ln"] = logicalName;
 
-    getMapInfoFromSmartctl(mapInfo, deviceInfo);
+    // 后台通过ioctl读取的是固定字段的记录，不经过smartctl文本解析
+    if (deviceInfo.startsWith(DISK_RECORD_MAGIC))
+        getMapInfoFromDiskRecord(mapInfo, deviceInfo);
+    else
+        getMapInfoFromSmartctl(mapInfo, deviceInfo);
     addMapInfo("smart", mapInfo);
 }
 
@@ -1202,55 +1213,41 @@ void CmdTool::getMapInfoFromInput(const QString &info, QMap<QString, QString> &m
     }
 }
 
-void CmdTool::getMapInfoFromLshw(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch)
+void CmdTool::getMapInfoFromLshw(QStringView info, QMap<QString, QString> &mapInfo, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from lshw output.";
-    QStringList infoList = info.split("\n");
-    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
-        QStringList words = (*it).split(ch);
-        if (words.size() != 2)
+    const bool isNetwork = info.startsWith(u"network");
+    HwinfoTokenizer tokenizer(info, ch);
+    HwinfoToken token;
+    while (tokenizer.next(token)) {
+        if (!token.valid)
             continue;
 
-        // && words[0].contains("configuration") == false && words[0].contains("resources") == false
-        // 将configuration的内容进行拆分
-        QString keyStr = words[0].trimmed();
-        QString valueStr = words[1].trimmed();
-        if (keyStr.contains("configuration")) {
+        // 将configuration和resources的内容在原文上拆分
+        if (token.key.contains(u"configuration")) {
             qCDebug(appLog) << "Parsing lshw configuration.";
-            QStringList keyValues = valueStr.split(" ");
-
-            for (QStringList::iterator itKV = keyValues.begin(); itKV != keyValues.end(); ++itKV) {
-                QStringList attr = (*itKV).split("=");
-                if (attr.size() != 2)
-                    continue;
-
-                mapInfo.insert(attr[0].trimmed(), attr[1].trimmed());
-            }
-        } else if (keyStr.contains("resources")) {
+            QStringView name, value;
+            for (qsizetype pos = 0; nextLshwAttr(token.value, pos, QLatin1Char('='), name, value);)
+                mapInfo.insert(AttributeAtoms::intern(name), value.toString());
+        } else if (token.key.contains(u"resources")) {
             qCDebug(appLog) << "Parsing lshw resources.";
-            QStringList keyValues = valueStr.split(" ");
-
-            for (QStringList::iterator itKV = keyValues.begin(); itKV != keyValues.end(); ++itKV) {
-                QStringList attr = (*itKV).split(":");
-                if (attr.size() != 2)
-                    continue;
-
-                if (mapInfo.find(attr[0].trimmed()) != mapInfo.end())
-                    mapInfo[attr[0].trimmed()] += QString("  ");
-
-                mapInfo[attr[0].trimmed()] += attr[1].trimmed();
+            QStringView name, value;
+            for (qsizetype pos = 0; nextLshwAttr(token.value, pos, QLatin1Char(':'), name, value);) {
+                QString resourceName = AttributeAtoms::intern(name);
+                QMap<QString, QString>::iterator it = mapInfo.find(resourceName);
+                if (it != mapInfo.end())
+                    it.value() += QString("  ");
+                else
+                    it = mapInfo.insert(resourceName, QString());
+                it.value() += value.toString();
             }
         } else {
+            QString keyStr = AttributeAtoms::intern(token.key);
+            QString valueStr = token.value.toString();
             // 过滤重复网卡逻辑名称数据
-            if (info.startsWith("network")) {
-                if (mapInfo.contains(keyStr) && keyStr == "logical name") {
-                    if (!valueStr.startsWith("/dev") && mapInfo["logical name"].startsWith("/dev")){
-                        mapInfo.remove(keyStr);
-                        mapInfo.insert(keyStr, valueStr);
-                    }
-                } else {
+            if (isNetwork && keyStr == "logical name" && mapInfo.contains(keyStr)) {
+                if (!valueStr.startsWith("/dev") && mapInfo["logical name"].startsWith("/dev"))
                     mapInfo.insert(keyStr, valueStr);
-                }
             } else {
                 mapInfo.insert(keyStr, valueStr);
             }
@@ -1258,6 +1255,26 @@ void CmdTool::getMapInfoFromLshw(const QString &info, QMap<QString, QString> &ma
     }
 }
 
+bool CmdTool::nextLshwAttr(QStringView text, qsizetype &pos, QChar sep, QStringView &name, QStringView &value)
+{
+    // 以空格分隔的 name<sep>value，只有一个分隔符的才有效
+    while (pos <= text.size()) {
+        qsizetype end = text.indexOf(QLatin1Char(' '), pos);
+        if (end < 0)
+            end = text.size();
+        QStringView attr = text.mid(pos, end - pos);
+        pos = end + 1;
+
+        qsizetype index = attr.indexOf(sep);
+        if (index < 0 || attr.indexOf(sep, index + 1) >= 0)
+            continue;
+        name = attr.left(index).trimmed();
+        value = attr.mid(index + 1).trimmed();
+        return true;
+    }
+    return false;
+}
+
 QString CmdTool::getCurNetworkLinkStatus(QString driverName)
 {
     qCDebug(appLog) << "Getting current network link status for:" << driverName;
@@ -1333,69 +1350,61 @@ void CmdTool::getMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &
 {
     qCDebug(appLog) << "Getting map info from hwinfo.";
     QString tmpkey;
-    QString tmpvalue;
     QString tmpvid;
-    tmpvid.clear();
-    QStringList infoList = info.split("\n");
-    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
-        QStringList words = (*it).split(ch);
-        if ((*it).contains("PS/2 Mouse")) {
+    // 单次遍历，键值及引号中的内容都是原文的视图，只有写入map时才复制
+    HwinfoTokenizer tokenizer(info, ch);
+    HwinfoToken token;
+    while (tokenizer.next(token)) {
+        if (token.line.contains(u"PS/2 Mouse")) {
             qCDebug(appLog) << "Found PS/2 Mouse, setting Hotplug to PS/2.";
-            words.clear();
-            words << "Hotplug" << "PS/2";
+            token.key = u"Hotplug";
+            token.value = u"PS/2";
+            token.hasQuoted = false;
+            token.valid = true;
         }
-        if ((*it).contains("SubDevice:")) {
+        if (token.line.contains(u"SubDevice:")) {
             tmpkey = "PsubID";
         }
-        if (words.size() != 2)
+        if (!token.valid)
             continue;
 
-        if (mapInfo.find(words[0].trimmed()) != mapInfo.end())
-            mapInfo[words[0].trimmed()] += QString(" ");
+        const QString key = AttributeAtoms::intern(token.key);
+        QMap<QString, QString>::iterator it = mapInfo.find(key);
+        if (it != mapInfo.end())
+            it.value() += QString(" ");
 
         /*pick PID VID*/
-        if (
-            ("SubDevice" ==  words[0].trimmed() || "SubVendor" == words[0].trimmed() ||
-             "Vendor" ==  words[0].trimmed() || "Device" == words[0].trimmed())
-            && !(words[1].trimmed().isEmpty() ||  words[1].trimmed().contains("unknown"))
-            && words[1].trimmed().contains("0x")
-        ) {
-            if ("SubDevice" ==  words[0].trimmed()) {
+        if (("SubDevice" == key || "SubVendor" == key || "Vendor" == key || "Device" == key)
+                && !(token.value.isEmpty() || token.value.contains(u"unknown"))
+                && token.value.contains(u"0x")) {
+            if ("SubDevice" == key) {
                 tmpkey = "PsubID";
-                tmpvalue = words[1].trimmed(); //re.cap(0);
-            } else if ("SubVendor" ==  words[0].trimmed()) {
+            } else if ("SubVendor" == key) {
                 tmpkey = "VsubID";
-                tmpvalue = words[1].trimmed();
-            } else if ("Vendor" ==  words[0].trimmed()) {
+            } else if ("Vendor" == key) {
                 tmpkey = "VID";
-                tmpvalue = words[1].trimmed();
-            } else if ("Device" ==  words[0].trimmed()) {
+            } else {
                 tmpkey = "PID";
-                tmpvalue = words[1].trimmed();
             }
 
-            QStringList tmpword = tmpvalue.split(" ");
-            if (tmpword.size() > 1) {
-                mapInfo[tmpkey] += tmpword[1].trimmed();
+            QStringView word;
+            if (HwinfoTokenizer::secondWord(token.value, word)) {
+                mapInfo[tmpkey] += word.toString();
 
                 if (tmpkey == "VID") {
-                    tmpvid = tmpword[1].trimmed();
+                    tmpvid = word.toString();
                 } else if (tmpkey == "PID") {
                     if (!tmpvid.isEmpty()) {
                         tmpkey = "VID_PID";
-                        tmpvalue.clear();
-                        tmpvalue = tmpvid + tmpword[1].remove("0x", Qt::CaseSensitive).trimmed();
+                        mapInfo[tmpkey] += tmpvid + word.toString().remove("0x", Qt::CaseSensitive).trimmed();
                         tmpvid.clear();
-                        mapInfo[tmpkey] += tmpvalue;
                     }
                 }
             }
         }
 
-        QRegularExpression re(".*\"(.*)\".*");
-        if (re.match(words[1].trimmed()).hasMatch()) {
-            QString key = words[0].trimmed();
-            QString value = re.match(words[1].trimmed()).captured(1);
+        if (token.hasQuoted) {
+            QString value = token.quoted.toString();
 
             //这里是为了防止  "usb-storage", "sr"  -》 usb-storage", "sr
             // bug112311 驱动模块显示异常
@@ -1406,24 +1415,14 @@ void CmdTool::getMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &
             if (!value.contains("unknown"))
                 mapInfo[key] += value;
 
-        } else {
-            // 此处如果subDevice,subVendor,Device没有值，则过滤
-//            if ("SubDevice" ==  words[0].trimmed() ||
-//                    "SubVendor" == words[0].trimmed() ||
-//                    "Device" == words[0].trimmed()) {
-//                continue;
-//            }
-            if ("Resolution" == words[0].trimmed()) {
-                mapInfo[words[0].trimmed()] += words[1].trimmed();
-            } else {
-                // 如果信息中有unknown 则过滤
-                if (!words[1].trimmed().contains("unknown"))
-                    mapInfo[words[0].trimmed()] = words[1].trimmed();
-            }
+        } else if ("Resolution" == key) {
+            mapInfo[key] += token.value.toString();
+        } else if (!token.value.contains(u"unknown")) {
+            // 如果信息中有unknown 则过滤
+            mapInfo[key] = token.value.toString();
         }
-        if ((*it).contains("Config Status")) {
-            //qCInfo(appLog) << "  Config Status"<< words[0]<<words[1];
-            if(words[1].contains("avail=yes"))
+        if (token.line.contains(u"Config Status")) {
+            if (token.value.contains(u"avail=yes"))
                 mapInfo["cfg_avail"] = "yes";
         }
     }
@@ -1482,6 +1481,19 @@ void CmdTool::getMapInfoFromDmidecode(const QString &info, QMap<QString, QString
     }
 }
 
+void CmdTool::getMapInfoFromDiskRecord(QMap<QString, QString> &mapInfo, const QString &info)
+{
+    qCDebug(appLog) << "Getting map info from disk identify record.";
+    // 第一行为 DISK_RECORD_MAGIC，之后每行一个 "key: value"，值可以为空
+    QStringList lines = info.split("\n");
+    for (int i = 1; i < lines.size(); ++i) {
+        int index = lines[i].indexOf(":");
+        if (index <= 0)
+            continue;
+        mapInfo.insert(lines[i].left(index).trimmed(), lines[i].mid(index + 1).trimmed());
+    }
+}
+
 void CmdTool::getMapInfoFromSmartctl(QMap<QString, QString> &mapInfo, const QString &info, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from smartctl.";
@@ -10,6 +10,7 @@
 #include <QMap>
 #include <QProcess>
 #include <QFile>
+#include <QStringView>
 #include <cups.h>
 
 #include <DWidget>
@@ -263,7 +264,25 @@ private:
      * @param mapInfo:解析字符串保存为map形式
      * @param ch:分隔符
      */
-    void getMapInfoFromLshw(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch = QString(": "));
+    void getMapInfoFromLshw(QStringView info, QMap<QString, QString> &mapInfo, const QString &ch = QString(": "));
+
+    /**
+     * @brief lshwItemKey:根据lshw段的类别前缀获取缓存关键字
+     * @param item:以类别开头的lshw段，如 "cpu:0 ..."
+     * @return 不需要的类别返回nullptr
+     */
+    static const char *lshwItemKey(QStringView item);
+
+    /**
+     * @brief nextLshwAttr:获取configuration/resources中的下一个属性
+     * @param text:如 "driver=e1000e latency=0"
+     * @param pos:当前位置，获取后后移
+     * @param sep:属性名与值的分隔符
+     * @param name:属性名
+     * @param value:属性值
+     * @return 是否还有属性
+     */
+    static bool nextLshwAttr(QStringView text, qsizetype &pos, QChar sep, QStringView &name, QStringView &value);
 
     /**
      * @brief getMapInfoFromHwinfo:将通过命令获取的信息字符串，转化为map形式
@@ -281,6 +300,13 @@ private:
      */
     void getMapInfoFromDmidecode(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch = QString(": "));
 
+    /**
+     * @brief getMapInfoFromDiskRecord:将后台读取的硬盘标识记录转化为map形式，字段见 DISK_KEY_*
+     * @param mapInfo:保存信息的map
+     * @param info:记录文本
+     */
+    void getMapInfoFromDiskRecord(QMap<QString, QString> &mapInfo, const QString &info);
+
     /**
      * @brief getMapInfoFromSmartctl:将通过命令获取的信息字符串，转化为map形式
      * @param info:命令获取的信息字符串
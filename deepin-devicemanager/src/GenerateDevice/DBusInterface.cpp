@@ -8,9 +8,16 @@
 
 #include <QDBusConnection>
 #include <QDBusInterface>
+#include <QDBusMessage>
+#include <QDBusMetaType>
 #include <QDBusReply>
 #include <QLoggingCategory>
 #include <QProcess>
+#include <QDBusUnixFileDescriptor>
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace DDLog;
 
@@ -22,8 +29,16 @@ const QString SERVICE_NAME = "org.deepin.DeviceInfo";
 const QString DEVICE_SERVICE_PATH = "/org/deepin/DeviceInfo";
 const QString DEVICE_SERVICE_INTERFACE = "org.deepin.DeviceInfo";
 
+// 与后台 DeviceInfoManager::snapshot 的格式一致
+#define SNAPSHOT_MAGIC          "DISNAP01"
+#define SNAPSHOT_MAGIC_SIZE     8
+#define SNAPSHOT_HEADER_SIZE    (SNAPSHOT_MAGIC_SIZE + 8 + 4)
+
 DBusInterface::DBusInterface()
     : mp_Iface(nullptr)
+    , mp_Snapshot(nullptr)
+    , m_SnapshotSize(0)
+    , m_CacheGeneration(0)
 {
     qCDebug(appLog) << "DBusInterface constructor";
     // 初始化dbus
@@ -33,6 +48,23 @@ DBusInterface::DBusInterface()
 bool DBusInterface::getInfo(const QString &key, QString &info)
 {
     qCDebug(appLog) << "DBusInterface::getInfo start, key:" << key;
+    {
+        QMutexLocker locker(&m_CacheMutex);
+        QMap<QString, QString>::const_iterator it = m_MapCache.constFind(key);
+        if (it != m_MapCache.constEnd()) {
+            info = it.value();
+            qCDebug(appLog) << "DBusInterface::getInfo from cache, key:" << key << "info length:" << info.length();
+            return true;
+        }
+        // 快照中的信息只在使用时解码一次
+        QMap<QString, QByteArray>::const_iterator raw = m_MapRaw.constFind(key);
+        if (raw != m_MapRaw.constEnd()) {
+            info = QString::fromUtf8(raw.value().constData(), raw.value().size());
+            qCDebug(appLog) << "DBusInterface::getInfo from snapshot, key:" << key << "info length:" << info.length();
+            return true;
+        }
+    }
+
     // 调用dbus接口获取设备信息
     QDBusReply<QString> reply = mp_Iface->call("getInfo", key);
     if (reply.isValid()) {
@@ -52,10 +84,99 @@ bool DBusInterface::getInfo(const QString &key, QString &info)
     }
 }
 
+bool DBusInterface::getAllInfo()
+{
+    qCDebug(appLog) << "DBusInterface::getAllInfo start";
+    // 后台信息未变化时直接使用缓存
+    QDBusReply<qulonglong> generation = mp_Iface->call("generation");
+    if (generation.isValid()) {
+        QMutexLocker locker(&m_CacheMutex);
+        if (generation.value() == m_CacheGeneration) {
+            qCDebug(appLog) << "DBusInterface::getAllInfo generation unchanged:" << m_CacheGeneration;
+            return true;
+        }
+    }
+
+    if (loadSnapshot())
+        return true;
+
+    QDBusReply<QMap<QString, QString> > reply = mp_Iface->call("getAllInfo");
+    if (!reply.isValid()) {
+        qCInfo(appLog) << "unsucess in getting info from getAllInfo :" << reply.error().message();
+        return false;
+    }
+
+    QMutexLocker locker(&m_CacheMutex);
+    releaseSnapshot();
+    m_MapCache = reply.value();
+    m_CacheGeneration = generation.isValid() ? generation.value() : 0;
+    qCDebug(appLog) << "DBusInterface::getAllInfo end, key count:" << m_MapCache.size();
+    return true;
+}
+
+bool DBusInterface::getInfos(const QStringList &keys)
+{
+    qCDebug(appLog) << "DBusInterface::getInfos start, keys:" << keys;
+    QDBusReply<QMap<QString, QString> > reply = mp_Iface->call("getInfos", keys);
+    if (!reply.isValid()) {
+        qCInfo(appLog) << "unsucess in getting info from getInfos :" << reply.error().message();
+        return false;
+    }
+
+    const QMap<QString, QString> &infos = reply.value();
+    QMutexLocker locker(&m_CacheMutex);
+    for (QMap<QString, QString>::const_iterator it = infos.constBegin(); it != infos.constEnd(); ++it)
+        m_MapCache.insert(it.key(), it.value());
+    return true;
+}
+
+void DBusInterface::clearCache()
+{
+    qCDebug(appLog) << "DBusInterface::clearCache";
+    QMutexLocker locker(&m_CacheMutex);
+    m_MapCache.clear();
+    releaseSnapshot();
+    m_CacheGeneration = 0;
+}
+
+bool DBusInterface::waitReady(quint64 generation, int timeout, quint64 &ready)
+{
+    qCDebug(appLog) << "DBusInterface::waitReady start, generation:" << generation << "timeout:" << timeout;
+    // 单独的调用设置超时时间，不修改共用接口的超时
+    QDBusMessage message = QDBusMessage::createMethodCall(SERVICE_NAME, DEVICE_SERVICE_PATH, DEVICE_SERVICE_INTERFACE, "waitReady");
+    message << static_cast<qulonglong>(generation) << timeout;
+    QDBusReply<qulonglong> reply = QDBusConnection::systemBus().call(message, QDBus::Block, timeout + 1000);
+    if (!reply.isValid()) {
+        qCInfo(appLog) << "unsucess in waiting for collection :" << reply.error().message();
+        return false;
+    }
+    ready = reply.value();
+    qCDebug(appLog) << "DBusInterface::waitReady end, ready:" << ready;
+    return true;
+}
+
 void DBusInterface::refreshInfo()
 {
     qCDebug(appLog) << "DBusInterface::refreshInfo";
-    mp_Iface->asyncCall("refreshInfo");
+    clearCache();
+    QDBusPendingCall call = mp_Iface->asyncCall("refreshInfo");
+    QMutexLocker locker(&m_CacheMutex);
+    m_RefreshReply = call;
+}
+
+quint64 DBusInterface::refreshGeneration()
+{
+    m_CacheMutex.lock();
+    QDBusPendingReply<qulonglong> reply = m_RefreshReply;
+    m_CacheMutex.unlock();
+
+    reply.waitForFinished();
+    if (!reply.isValid()) {
+        qCDebug(appLog) << "DBusInterface::refreshGeneration no refresh generation";
+        return 0;
+    }
+    qCDebug(appLog) << "DBusInterface::refreshGeneration:" << reply.value();
+    return reply.value();
 }
 
 void DBusInterface::init()
@@ -70,6 +191,90 @@ void DBusInterface::init()
     }
 
     // 2. create interface
+    qDBusRegisterMetaType<QMap<QString, QString> >();
     mp_Iface = new QDBusInterface(SERVICE_NAME, DEVICE_SERVICE_PATH, DEVICE_SERVICE_INTERFACE, QDBusConnection::systemBus());
     qCDebug(appLog) << "DBusInterface::init end, iface created:" << (mp_Iface != nullptr);
 }
+
+bool DBusInterface::loadSnapshot()
+{
+    qCDebug(appLog) << "DBusInterface::loadSnapshot start";
+    QDBusReply<QDBusUnixFileDescriptor> reply = mp_Iface->call("getSnapshot");
+    if (!reply.isValid() || !reply.value().isValid()) {
+        qCInfo(appLog) << "unsucess in getting info from getSnapshot :" << reply.error().message();
+        return false;
+    }
+
+    int fd = reply.value().fileDescriptor();
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < SNAPSHOT_HEADER_SIZE) {
+        qCWarning(appLog) << "Invalid snapshot size";
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    // 快照已密封，映射后描述符可以关闭(由QDBusUnixFileDescriptor负责)
+    char *data = static_cast<char *>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+    if (MAP_FAILED == data) {
+        qCWarning(appLog) << "Failed to map snapshot";
+        return false;
+    }
+
+    QMap<QString, QByteArray> mapRaw;
+    bool valid = 0 == memcmp(data, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    const char *pos = data + SNAPSHOT_MAGIC_SIZE;
+    const char *end = data + size;
+    quint64 generation = 0;
+    quint32 count = 0;
+    if (valid) {
+        memcpy(&generation, pos, sizeof(quint64));
+        pos += sizeof(quint64);
+        memcpy(&count, pos, sizeof(quint32));
+        pos += sizeof(quint32);
+    }
+    for (quint32 i = 0; valid && i < count; ++i) {
+        QByteArray item[2];
+        for (int j = 0; j < 2; ++j) {
+            quint32 len = 0;
+            if (end - pos < static_cast<qptrdiff>(sizeof(quint32))) {
+                valid = false;
+                break;
+            }
+            memcpy(&len, pos, sizeof(quint32));
+            pos += sizeof(quint32);
+            if (static_cast<quint64>(end - pos) < len) {
+                valid = false;
+                break;
+            }
+            item[j] = QByteArray::fromRawData(pos, static_cast<int>(len));
+            pos += len;
+        }
+        if (valid)
+            mapRaw.insert(QString::fromUtf8(item[0]), item[1]);
+    }
+    if (!valid) {
+        qCWarning(appLog) << "Invalid snapshot data";
+        munmap(data, size);
+        return false;
+    }
+
+    QMutexLocker locker(&m_CacheMutex);
+    releaseSnapshot();
+    m_MapCache.clear();
+    m_MapRaw = mapRaw;
+    mp_Snapshot = data;
+    m_SnapshotSize = size;
+    m_CacheGeneration = generation;
+    qCDebug(appLog) << "DBusInterface::loadSnapshot end, key count:" << m_MapRaw.size() << "size:" << size;
+    return true;
+}
+
+void DBusInterface::releaseSnapshot()
+{
+    // m_MapRaw 中的数据指向映射内存，需先清空
+    m_MapRaw.clear();
+    if (mp_Snapshot) {
+        munmap(mp_Snapshot, m_SnapshotSize);
+        mp_Snapshot = nullptr;
+        m_SnapshotSize = 0;
+    }
+}
@@ -7,6 +7,10 @@
 #define DBUSINTERFACE_H
 
 #include <QObject>
+#include <QMap>
+#include <QByteArray>
+#include <QMutex>
+#include <QDBusPendingReply>
 
 #include <mutex>
 
@@ -43,10 +47,44 @@ public:
     bool getInfo(const QString &key, QString &info);
 
     /**
-     * @brief refreshInfo 用来通知后台刷新信息
+     * @brief getAllInfo：一次调用获取后台所有信息，之后的getInfo直接从缓存中读取
+     * 后台信息版本(generation)未变化时不重新获取
+     * @return 信息是否有效，后台不支持批量接口时返回false，getInfo仍逐个获取
+     */
+    bool getAllInfo();
+
+    /**
+     * @brief getInfos：一次调用获取多个关键字的信息并加入缓存
+     * @param keys：命令关键字列表
+     * @return 信息是否有效
+     */
+    bool getInfos(const QStringList &keys);
+
+    /**
+     * @brief clearCache：清空批量获取的信息缓存
+     */
+    void clearCache();
+
+    /**
+     * @brief waitReady：等待后台完成一次采集，采集期间阻塞调用线程
+     * @param generation：需要完成的采集次数，0表示任意一次
+     * @param timeout：超时时间(ms)
+     * @param ready：已完成的采集次数
+     * @return 是否已完成，超时或后台不支持时返回false
+     */
+    bool waitReady(quint64 generation, int timeout, quint64 &ready);
+
+    /**
+     * @brief refreshInfo 用来通知后台刷新信息，不等待后台回复
      */
     void refreshInfo();
 
+    /**
+     * @brief refreshGeneration：最近一次refreshInfo对应的采集次数，需要时等待后台回复，会阻塞调用线程
+     * @return 采集次数，可传给waitReady；没有刷新或后台不支持时返回0
+     */
+    quint64 refreshGeneration();
+
 protected:
     DBusInterface();
 
@@ -56,11 +94,29 @@ private:
      */
     void init();
 
+    /**
+     * @brief loadSnapshot：通过后台提供的memfd快照获取所有信息，信息保留在映射内存中，读取时再解码
+     * @return 快照是否有效
+     */
+    bool loadSnapshot();
+
+    /**
+     * @brief releaseSnapshot：释放快照映射，调用前需持有m_CacheMutex
+     */
+    void releaseSnapshot();
+
 private:
     static std::atomic<DBusInterface *> s_Instance;
     static std::mutex m_mutex;
 
     QDBusInterface       *mp_Iface;
+    QMutex                m_CacheMutex;
+    QMap<QString, QString> m_MapCache;      //<! 批量获取的信息缓存
+    QMap<QString, QByteArray> m_MapRaw;     //<! 快照中的UTF-8信息，直接指向映射内存
+    char                 *mp_Snapshot;      //<! 快照映射地址
+    size_t                m_SnapshotSize;   //<! 快照映射大小
+    quint64               m_CacheGeneration; //<! 缓存对应的后台信息版本，0表示无缓存
+    QDBusPendingReply<qulonglong> m_RefreshReply; //<! 最近一次refreshInfo的回复，受m_CacheMutex保护
 };
 
 #endif // DBUSINTERFACE_H
@@ -4,7 +4,8 @@
 
 #include "GenerateDevicePool.h"
 
-#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMap>
 #include <QLoggingCategory>
 
 #include "DeviceGenerator.h"
@@ -14,6 +15,9 @@
 
 using namespace DDLog;
 
+#define GENERATE_TIMEOUT 4000    // 超过该时间仍未生成完的设备类型记录警告(ms)
+#define GENERATE_MAX_WAIT 30000  // 等待设备生成的最长时间(ms)，超时后不再等待剩余类型
+
 GenerateTask::GenerateTask(DeviceType deviceType)
     : m_Type(deviceType)
 {
@@ -33,9 +37,13 @@ void GenerateTask::run()
 
     if (!generator) {
         qCWarning(appLog) << "GenerateTask::run get generator failed";
+        // 生成失败也要通知任务结束，否则调度方会一直等待该类型
+        emit finished(m_Type, QStringList());
         return;
     }
 
+    // 生成过程中的设备先暂存在本线程，结束后一次性发布
+    DeviceManager::instance()->beginStaging(m_Type);
     switch (m_Type) {
     case DT_Computer:
         qCDebug(appLog) << "GenerateTask::run generate computer device";
@@ -126,8 +134,9 @@ void GenerateTask::run()
         qCDebug(appLog) << "GenerateTask::run generate unknown device";
         break;
     }
+    DeviceManager::instance()->commitStaging();
 
-    emit finished(generator->getBusIDFromHwinfo());
+    emit finished(m_Type, generator->getBusIDFromHwinfo());
     delete generator;
     generator = nullptr;
 }
@@ -135,44 +144,145 @@ void GenerateTask::run()
 
 GenerateDevicePool::GenerateDevicePool()
     : QThreadPool()
+    , m_Prepared(false)
+    , m_FinishedGenerator(0)
 {
     qCDebug(appLog) << "GenerateDevicePool constructor";
+    qRegisterMetaType<DeviceType>("DeviceType");
     initType();
 }
 
+const QStringList &GenerateDevicePool::inputKeys(DeviceType deviceType)
+{
+    // 各类设备的生成函数(含各架构的派生类)读取的命令，toml 信息随 dmidecode1 加载
+    static const QMap<int, QStringList> inputs = {
+        { DT_Computer,  { "cat_os_release", "cat_version", "lshw", "dmidecode1", "dmidecode2", "dmidecode3" } },
+        { DT_Cpu,       { "lscpu", "lshw", "dmidecode1", "dmidecode4" } },
+        { DT_Bios,      { "dmidecode0", "dmidecode1", "dmidecode2", "dmidecode3", "dmidecode13", "dmidecode16" } },
+        { DT_Memory,    { "lshw", "dmidecode1", "dmidecode17" } },
+        { DT_Storage,   { "hwinfo", "lshw", "dmidecode1", "lsblk_d", "ls_sg" } },
+        { DT_Gpu,       { "hwinfo", "lshw", "dmidecode1", "xrandr", "dmesg", "nvidia" } },
+        { DT_Monitor,   { "hwinfo_monitor", "dmidecode1", "xrandr", "xrandr_verbose" } },
+        { DT_Network,   { "hwinfo", "lshw", "dmidecode1" } },
+        { DT_Audio,     { "hwinfo", "lshw", "dmidecode1", "dmesg", "cat_devices", "cat_audio" } },
+        { DT_Bluetoorh, { "hwinfo", "lshw", "dmidecode1", "hciconfig" } },
+        { DT_Keyboard,  { "hwinfo", "lshw", "dmidecode1", "bt_device" } },
+        { DT_Mouse,     { "hwinfo", "lshw", "dmidecode1", "bt_device" } },
+        { DT_Print,     { "printer", "dmidecode1" } },
+        { DT_Image,     { "hwinfo", "lshw", "dmidecode1" } },
+        { DT_Cdrom,     { "hwinfo", "lshw", "dmidecode1" } },
+        { DT_Power,     { "upower", "dmidecode1" } },
+        { DT_Others,    { "hwinfo", "lshw", "dmidecode1" } },
+    };
+    static const QStringList empty;
+    QMap<int, QStringList>::const_iterator it = inputs.constFind(deviceType);
+    return it == inputs.constEnd() ? empty : it.value();
+}
+
+void GenerateDevicePool::prepare()
+{
+    qCDebug(appLog) << "GenerateDevicePool::prepare";
+    QMutexLocker locker(&m_ScheduleMutex);
+    resetSchedule();
+}
+
+void GenerateDevicePool::resetSchedule()
+{
+    m_Prepared = true;
+    m_FinishedGenerator = 0;
+    m_LoadedCmd.clear();
+    m_RunningTypes.clear();
+    m_WaitingTypes = m_TypeList;
+    // 生成结束前界面不读取该类设备
+    foreach (DeviceType type, m_TypeList)
+        DeviceManager::instance()->setTypeGenerating(type, true);
+    DeviceManager::instance()->setTypeGenerating(DT_Others, true);
+}
+
+void GenerateDevicePool::slotCmdLoaded(const QString &key)
+{
+    qCDebug(appLog) << "GenerateDevicePool::slotCmdLoaded, key:" << key;
+    QMutexLocker locker(&m_ScheduleMutex);
+    m_LoadedCmd.insert(key);
+
+    QList<DeviceType>::iterator it = m_WaitingTypes.begin();
+    while (it != m_WaitingTypes.end()) {
+        bool ready = true;
+        foreach (const QString &input, inputKeys(*it)) {
+            if (!m_LoadedCmd.contains(input)) {
+                ready = false;
+                break;
+            }
+        }
+
+        if (ready) {
+            startTask(*it);
+            it = m_WaitingTypes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void GenerateDevicePool::startTask(DeviceType deviceType)
+{
+    qCDebug(appLog) << "GenerateDevicePool::startTask, type:" << deviceType;
+    GenerateTask *task = new GenerateTask(deviceType);
+    // 在任务线程中直接记录完成，不依赖任何线程的事件循环
+    connect(task, &GenerateTask::finished, this, &GenerateDevicePool::slotFinished, Qt::DirectConnection);
+    m_RunningTypes.append(deviceType);
+    start(task);
+}
+
 void GenerateDevicePool::generateDevice()
 {
     qCDebug(appLog) << "GenerateDevicePool::generateDevice start";
-    m_FinishedGenerator = 0;
+    QElapsedTimer timer;
+    timer.start();
 
-    QList<DeviceType>::iterator it = m_TypeList.begin();
-    for (; it != m_TypeList.end(); ++it) {
-        // qCDebug(appLog) << "GenerateDevicePool::generateDevice start task for type:" << (*it);
-        GenerateTask *task = new GenerateTask((*it));
-        connect(task, &GenerateTask::finished, this, &GenerateDevicePool::slotFinished);
-        QThreadPool::globalInstance()->start(task);
-//        task->setAutoDelete(true);
+    m_ScheduleMutex.lock();
+    if (!m_Prepared) {
+        qCWarning(appLog) << "GenerateDevicePool::generateDevice called without prepare, generate all types";
+        resetSchedule();
     }
+    m_Prepared = false;
 
-    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
-    // 这里是为了确保其它设备在最后一个生成
-    qint64 beginMSecond = QDateTime::currentMSecsSinceEpoch();
-    while (true) {
-        // qCDebug(appLog) << "GenerateDevicePool::generateDevice wait for tasks finished, finished count:" << m_FinishedGenerator;
-        qint64 curMSecond = QDateTime::currentMSecsSinceEpoch();
-        if (m_FinishedGenerator == m_TypeList.size()  || curMSecond - beginMSecond > 4000) {
-            // qCDebug(appLog) << "GenerateDevicePool::generateDevice all tasks finished or timeout, generate others device";
-            DeviceGenerator *generator = DeviceFactory::getDeviceGenerator();
-            generator->generatorOthersDevice();
-            generator->generatorInfoFromToml(DT_Others);
-
-            // 指针使用结束释放
-            delete generator;
-            generator = nullptr;
+    // 输入齐全的类型在加载过程中已经开始生成，这里只启动剩余的任务
+    foreach (DeviceType type, m_WaitingTypes)
+        startTask(type);
+    m_WaitingTypes.clear();
 
+    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
+    // 其它设备需要读取已生成的设备列表，必须等待所有任务提交后再生成
+    // 超过 GENERATE_TIMEOUT 记录警告，超过 GENERATE_MAX_WAIT 不再等待剩余类型
+    bool warned = false;
+    while (!m_RunningTypes.isEmpty()) {
+        qint64 elapsed = timer.elapsed();
+        if (elapsed >= GENERATE_MAX_WAIT) {
+            qCWarning(appLog) << "GenerateDevicePool::generateDevice give up waiting after" << GENERATE_MAX_WAIT << "ms, late types:" << m_RunningTypes;
             break;
         }
+        if (!warned && elapsed >= GENERATE_TIMEOUT) {
+            qCWarning(appLog) << "GenerateDevicePool::generateDevice still waiting after" << GENERATE_TIMEOUT << "ms, late types:" << m_RunningTypes;
+            warned = true;
+        }
+        qint64 limit = warned ? GENERATE_MAX_WAIT : GENERATE_TIMEOUT;
+        m_AllFinished.wait(&m_ScheduleMutex, static_cast<unsigned long>(limit - elapsed));
     }
+    m_ScheduleMutex.unlock();
+    qCDebug(appLog) << "GenerateDevicePool::generateDevice finished:" << m_FinishedGenerator.load() << "/" << m_TypeList.size()
+                    << "wait:" << timer.elapsed() << "ms";
+
+    DeviceGenerator *generator = DeviceFactory::getDeviceGenerator();
+    generator->generatorOthersDevice();
+    generator->generatorInfoFromToml(DT_Others);
+
+    // 指针使用结束释放
+    delete generator;
+    generator = nullptr;
+
+    DeviceManager::instance()->setTypeGenerating(DT_Others, false);
+    emit deviceReady(DT_Others);
 }
 
 void GenerateDevicePool::initType()
@@ -198,9 +308,17 @@ void GenerateDevicePool::initType()
     qCDebug(appLog) << "GenerateDevicePool::initType end, initialized" << m_TypeList.size() << "device types";
 }
 
-void GenerateDevicePool::slotFinished(const QStringList &lst)
+void GenerateDevicePool::slotFinished(DeviceType deviceType, const QStringList &lst)
 {
-    qCDebug(appLog) << "GenerateDevicePool::slotFinished, busIDs:" << lst << "finished:" << m_FinishedGenerator+1 << "/" << m_TypeList.size();
+    qCDebug(appLog) << "GenerateDevicePool::slotFinished, type:" << deviceType << "busIDs:" << lst << "finished:" << m_FinishedGenerator + 1 << "/" << m_TypeList.size();
+    m_ScheduleMutex.lock();
     DeviceManager::instance()->addBusId(lst);
+    DeviceManager::instance()->setTypeGenerating(deviceType, false);
     m_FinishedGenerator++;
+    m_RunningTypes.removeOne(deviceType);
+    if (m_RunningTypes.isEmpty())
+        m_AllFinished.wakeAll();
+    m_ScheduleMutex.unlock();
+
+    emit deviceReady(deviceType);
 }
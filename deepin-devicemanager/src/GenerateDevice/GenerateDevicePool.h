@@ -9,6 +9,11 @@
 #include <QObject>
 #include <QThreadPool>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QSet>
+#include <QStringList>
+
+#include <atomic>
 
 /**
  * @brief The DeviceType enum
@@ -48,7 +53,7 @@ public:
     GenerateTask(DeviceType deviceType);
     ~GenerateTask();
 signals:
-    void finished(const QStringList &lst);
+    void finished(DeviceType deviceType, const QStringList &lst);
 protected:
     void run();
 private:
@@ -64,26 +69,71 @@ public:
     GenerateDevicePool();
 
     /**
-     * @brief generateDevice
+     * @brief inputKeys : 生成该类设备需要的命令，这些命令的信息全部加载后即可开始生成
+     * @param deviceType : 设备类型
+     * @return 命令列表，与 GetInfoPool 中的命令 key 一致
+     */
+    static const QStringList &inputKeys(DeviceType deviceType);
+
+    /**
+     * @brief prepare : 开始新一轮加载，所有设备类型等待各自的输入
+     */
+    void prepare();
+
+    /**
+     * @brief generateDevice : 启动输入仍未齐全的任务，阻塞等待全部结束后生成其它设备
+     * 未调用 prepare 时所有设备类型在这里开始生成
      */
     void generateDevice();
 
+signals:
+    /**
+     * @brief deviceReady : 该类设备已生成
+     * @param deviceType : 设备类型
+     */
+    void deviceReady(DeviceType deviceType);
+
+public slots:
+    /**
+     * @brief slotCmdLoaded : 命令信息已加载，输入齐全的设备类型立即开始生成，在加载线程中直接调用
+     * @param key : 命令
+     */
+    void slotCmdLoaded(const QString &key);
+
 private:
     /**
      * @brief initType
      */
     void initType();
 
+    /**
+     * @brief resetSchedule : 重置调度状态，所有设备类型等待各自的输入，调用时持有 m_ScheduleMutex
+     */
+    void resetSchedule();
+
+    /**
+     * @brief startTask : 开始生成该类设备，调用时持有 m_ScheduleMutex
+     * @param deviceType : 设备类型
+     */
+    void startTask(DeviceType deviceType);
+
 private slots:
     /**
-     * @brief slotFinished : end operation
+     * @brief slotFinished : end operation，在任务线程中直接调用
+     * @param deviceType
      * @param lst
      */
-    void slotFinished(const QStringList &lst);
+    void slotFinished(DeviceType deviceType, const QStringList &lst);
 
 private:
     QList<DeviceType>            m_TypeList;
-    int                          m_FinishedGenerator;
+    QList<DeviceType>            m_WaitingTypes;       //<! 输入未齐全、尚未开始生成的设备类型
+    QList<DeviceType>            m_RunningTypes;       //<! 已开始、尚未结束的设备类型
+    QSet<QString>                m_LoadedCmd;          //<! 已加载的命令
+    bool                         m_Prepared;           //<! 已调用 prepare，尚未 generateDevice
+    QMutex                       m_ScheduleMutex;      //<! 保护以上调度状态
+    QWaitCondition               m_AllFinished;        //<! 所有已开始的任务结束
+    std::atomic<int>             m_FinishedGenerator;  //<! 已结束的任务个数
 };
 
 #endif // GENERATEDEVICEPOOL_H
@@ -9,6 +9,7 @@
 
 #include "CmdTool.h"
 #include "DeviceManager.h"
+#include "DBusInterface.h"
 #include "DDLog.h"
 
 using namespace DDLog;
@@ -36,8 +37,8 @@ void CmdTask::run()
 
     CmdTool tool;
     tool.loadCmdInfo(m_Key, m_File);
-    const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo = tool.cmdInfo();
-    mp_Parent->finishedCmd(m_Info, cmdInfo);
+    // 解析结果直接移交，不复制
+    mp_Parent->finishedCmd(m_Key, m_Info, std::move(tool.cmdInfo()));
 }
 
 GetInfoPool::GetInfoPool()
@@ -52,24 +53,31 @@ void GetInfoPool::getAllInfo()
 {
     qCDebug(appLog) << "GetInfoPool::getAllInfo start";
     DeviceManager::instance()->clear();
+    // 一次dbus调用获取所有信息，各任务从缓存中读取
+    DBusInterface::getInstance()->getAllInfo();
 
     QList<QStringList>::iterator it = m_CmdList.begin();
     for (; it != m_CmdList.end(); ++it) {
         qCDebug(appLog) << "GetInfoPool::getAllInfo start task for key:" << (*it)[0];
         CmdTask *task = new CmdTask((*it)[0], (*it)[1], (*it)[2], this);
+        // 任务默认autoDelete，执行完由线程池删除
         start(task);
-        task->deleteLater();
     }
 }
 
-void GetInfoPool::finishedCmd(const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo)
+void GetInfoPool::finishedCmd(const QString &key, const QString &info, QMap<QString, QList<QMap<QString, QString> > > &&cmdInfo)
 {
-    qCDebug(appLog) << "GetInfoPool::finishedCmd, info:" << info << "cmdInfo size:" << cmdInfo.size();
-    DeviceManager::instance()->addCmdInfo(cmdInfo);
+    qCDebug(appLog) << "GetInfoPool::finishedCmd, key:" << key << "info:" << info << "cmdInfo size:" << cmdInfo.size();
+    // 每个任务完成后立即移交，依赖该命令的设备可以开始生成
+    DeviceManager::instance()->addCmdInfo(std::move(cmdInfo));
+    emit cmdLoaded(key);
+
     QMutexLocker m_lock(&mutex);
     m_FinishedNum++;
     if (m_FinishedNum == m_CmdList.size()) {
         qCDebug(appLog) << "GetInfoPool::finishedCmd all tasks finished";
+        qCInfo(appLog) << "GetInfoPool::finishedCmd time blocked on addCmdMutex:"
+                       << DeviceManager::instance()->addCmdWaitTime() / 1000 << "us";
         emit finishedAll(info);
         m_FinishedNum = 0;
     }
@@ -8,6 +8,7 @@
 
 #include <QObject>
 #include <QThreadPool>
+#include <QMap>
 
 class GetInfoPool;
 
@@ -44,11 +45,12 @@ public:
     void getAllInfo();
 
     /**
-     * @brief finishedCmd
+     * @brief finishedCmd 任务的解析结果直接移交DeviceManager，随后通知该命令已加载
+     * @param key : 命令
      * @param info
-     * @param cmdInfo
+     * @param cmdInfo : 调用后为空
      */
-    void finishedCmd(const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
+    void finishedCmd(const QString &key, const QString &info, QMap<QString, QList<QMap<QString, QString> > > &&cmdInfo);
     /**
      * @brief setFramework：设置架构
      * @param arch:架构
@@ -56,6 +58,11 @@ public:
     void setFramework(const QString &arch);
 
 signals:
+    /**
+     * @brief cmdLoaded 该命令的信息已加载到DeviceManager，在任务线程中发出
+     * @param key : 命令
+     */
+    void cmdLoaded(const QString &key);
     void finishedAll(const QString &info);
 
 private:
@@ -20,6 +20,7 @@
 #include "DeviceManager/DeviceMonitor.h"
 #include "DeviceManager/DeviceOthers.h"
 #include "DeviceManager/DeviceStorage.h"
+#include "commondefine.h"
 #include "DeviceManager/DeviceAudio.h"
 #include "DeviceManager/DeviceComputer.h"
 #include "DeviceManager/DevicePower.h"
@@ -340,6 +341,8 @@ void HWGenerator::getDiskInfoFromSmartCtl()
         // 按照HW的需求，如果是固态硬盘就不显示转速
         if (tempMap["Rotation Rate"] == "Solid State Device")
             tempMap["Rotation Rate"] = "HW_SSD";
+        if (tempMap.value(DISK_KEY_ROTATION_RATE) == "1")
+            tempMap[DISK_KEY_ROTATION_RATE] = "HW_SSD";
 
         DeviceManager::instance()->setStorageInfoFromSmartctl(tempMap["ln"], tempMap);
     }
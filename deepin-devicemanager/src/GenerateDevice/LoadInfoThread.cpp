@@ -22,6 +22,8 @@ using namespace DDLog;
 DWIDGET_USE_NAMESPACE
 static bool firstLoadFlag = true;
 
+#define WAIT_READY_TIMEOUT 60000    // 等待后台采集完成的超时时间(ms)
+
 LoadInfoThread::LoadInfoThread()
     : mp_ReadFilePool()
     , mp_GenerateDevicePool()
@@ -31,6 +33,9 @@ LoadInfoThread::LoadInfoThread()
 {
     qCDebug(appLog) << "LoadInfoThread constructor";
     connect(&mp_ReadFilePool, &GetInfoPool::finishedAll, this, &LoadInfoThread::slotFinishedReadFilePool);
+    // 命令信息加载后在任务线程中直接调度生成任务
+    connect(&mp_ReadFilePool, &GetInfoPool::cmdLoaded, &mp_GenerateDevicePool, &GenerateDevicePool::slotCmdLoaded, Qt::DirectConnection);
+    connect(&mp_GenerateDevicePool, &GenerateDevicePool::deviceReady, this, &LoadInfoThread::deviceReady);
 }
 
 LoadInfoThread::~LoadInfoThread()
@@ -56,73 +61,26 @@ LoadInfoThread::~LoadInfoThread()
 void LoadInfoThread::run()
 {
     qCDebug(appLog) << "LoadInfoThread::run start";
-    // 判断后台是否正处理update状态
-    QString info;
-    DBusInterface::getInstance()->getInfo("is_server_running", info);
-    qCDebug(appLog) << "LoadInfoThread::run is_server_running:" << info;
-    // 请求后台更新信息
+    // 等待后台采集完成后只解析一次，不再轮询和重复读取
     m_Running = true;
-    if (!info.toInt()) {
-        qCDebug(appLog) << "LoadInfoThread::run server is not running, start to get info";
-        m_Start = false;
-        mp_ReadFilePool.getAllInfo();
-        mp_ReadFilePool.waitForDone(-1);
-
-        bool readDataFlag = false;
-        int readNum = 0;
-        while (!readDataFlag) {
-            // qCDebug(appLog) << "LoadInfoThread::run waiting for read data, readNum:" << readNum;
-            if (m_FinishedReadFilePool) {
-                // qCDebug(appLog) << "LoadInfoThread::run finished read file pool, get all info again";
-                mp_ReadFilePool.getAllInfo();
-                mp_ReadFilePool.waitForDone(-1);
-            }
-            // 为了保证上面那个线程池完全结束
-            long long begin = QDateTime::currentMSecsSinceEpoch();
-            while (true) {
-                readDataFlag = !DeviceManager::instance()->cmdInfo("dmidecode4").isEmpty();
-                if (readDataFlag && m_FinishedReadFilePool) {
-                    // qCDebug(appLog) << "LoadInfoThread::run read data finished";
-                    break;
-                }
-                long long end = QDateTime::currentMSecsSinceEpoch();
-                if (end - begin > 4000) {
-                    // qCWarning(appLog) << "LoadInfoThread::run read data timeout";
-                    break;
-                }
-                usleep(100);
-            }
-            if ((++readNum) > 3) {
-                // qCWarning(appLog) << "LoadInfoThread::run read data retry timeout";
-                if (m_FinishedReadFilePool && !readDataFlag) {
-                    // qCDebug(appLog) << "LoadInfoThread::run finished read file pool, but read data failed, get all info again";
-                    mp_ReadFilePool.getAllInfo();
-                    mp_ReadFilePool.waitForDone(-1);
-                    begin = QDateTime::currentMSecsSinceEpoch();
-                    while (true) {
-                        // qCDebug(appLog) << "LoadInfoThread::run waiting for read file pool finished";
-                        if (m_FinishedReadFilePool) {
-                            // qCDebug(appLog) << "LoadInfoThread::run read file pool finished";
-                            break;
-                        }
-                        long long end = QDateTime::currentMSecsSinceEpoch();
-                        if (end - begin > 4000) {
-                            // qCWarning(appLog) << "LoadInfoThread::run wait for read file pool finished timeout";
-                            break;
-                        }
-                        usleep(100);
-                    }
-                }
-                break;
-            }
-        }
+    m_Start = false;
+    // 刷新之后需要等待包含该刷新的采集，而不是已完成的上一次采集
+    quint64 generation = 0;
+    quint64 target = DBusInterface::getInstance()->refreshGeneration();
+    if (!DBusInterface::getInstance()->waitReady(target, WAIT_READY_TIMEOUT, generation))
+        qCWarning(appLog) << "LoadInfoThread::run collection is not ready, use the current cache";
+    qCDebug(appLog) << "LoadInfoThread::run collect generation:" << generation << "target:" << target;
 
-        m_FinishedReadFilePool = false;
-        mp_GenerateDevicePool.generateDevice();
-        mp_GenerateDevicePool.waitForDone(-1);
-    } else {
-        qCDebug(appLog) << "LoadInfoThread::run server is running, do nothing";
-    }
+    // 各类设备在所需命令加载后即开始生成，不必等待所有命令
+    mp_GenerateDevicePool.prepare();
+    mp_ReadFilePool.getAllInfo();
+    mp_ReadFilePool.waitForDone(-1);
+
+    m_FinishedReadFilePool = false;
+    // 信息加载完成，之后只读
+    DeviceManager::instance()->freezeCmdInfo();
+    mp_GenerateDevicePool.generateDevice();
+    mp_GenerateDevicePool.waitForDone(-1);
 
     emit finished("finish");
     m_Running = false;
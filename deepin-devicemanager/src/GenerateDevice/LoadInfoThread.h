@@ -28,6 +28,12 @@ signals:
     void finished(const QString &message);
     void finishedReadFilePool();
 
+    /**
+     * @brief deviceReady：该类设备已生成，可以先行显示
+     * @param deviceType:设备类型
+     */
+    void deviceReady(DeviceType deviceType);
+
 protected:
     void run() override;
 
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "HeadlessExport.h"
+#include "LoadInfoThread.h"
+#include "DeviceManager.h"
+#include "environments.h"
+#include "DDLog.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QLocale>
+#include <QLoggingCategory>
+#include <QStandardPaths>
+#include <QTranslator>
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+#include <polkit-qt5-1/PolkitQt1/Authority>
+#else
+#include <polkit-qt6-1/PolkitQt1/Authority>
+#endif
+
+#include <stdio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace DDLog;
+using namespace PolkitQt1;
+
+bool HeadlessExport::isRequested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg == "--export" || arg.startsWith("--export="))
+            return true;
+    }
+    return false;
+}
+
+int HeadlessExport::exec(int argc, char *argv[])
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // 只需要事件循环与翻译，不创建 DApplication
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("deepin");
+    app.setApplicationName("deepin-devicemanager");
+    app.setApplicationVersion(VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Export device information without starting the window.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption exportOption("export", "Export format: txt, html, docx or xlsx.", "format");
+    QCommandLineOption outputOption("output", "Path of the exported file.", "path");
+    parser.addOption(exportOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    QString format = normalizeFormat(parser.value(exportOption));
+    if (format.isEmpty()) {
+        fprintf(stderr, "Unsupported export format: %s\n", qPrintable(parser.value(exportOption)));
+        return EC_InvalidArgument;
+    }
+    if (parser.value(outputOption).isEmpty()) {
+        fprintf(stderr, "Missing --output=<path>\n");
+        return EC_InvalidArgument;
+    }
+    QString filePath = QFileInfo(parser.value(outputOption)).absoluteFilePath();
+
+    // 翻译在生成设备前加载，属性名称与界面导出一致
+    QTranslator translator;
+    const QStringList dirs = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, "deepin-devicemanager/translations", QStandardPaths::LocateDirectory);
+    for (const QString &dir : dirs) {
+        if (translator.load(QLocale::system(), "deepin-devicemanager", "_", dir)) {
+            app.installTranslator(&translator);
+            break;
+        }
+    }
+
+    // 与界面启动使用同一认证
+    Authority::Result result = Authority::instance()->checkAuthorizationSync("com.deepin.deepin-devicemanager.checkAuthentication",
+                                                                            UnixProcessSubject(getpid()),
+                                                                            Authority::AllowUserInteraction);
+    if (result != Authority::Yes) {
+        qCWarning(appLog) << "Headless export authorization failed:" << result;
+        fprintf(stderr, "Authorization failed\n");
+        return EC_Unauthorized;
+    }
+    qint64 startupTime = timer.elapsed();
+
+    // 加载设备信息，线程结束时所有设备已生成
+    LoadInfoThread thread;
+    thread.start();
+    thread.wait();
+
+    DeviceManager::instance()->setDeviceListClass();
+    DeviceManager::instance()->getDeviceTypes();
+    DeviceManager::instance()->getDeviceOverview();
+    qint64 loadTime = timer.elapsed() - startupTime;
+
+    bool ok = exportTo(format, filePath);
+    qint64 exportTime = timer.elapsed() - startupTime - loadTime;
+
+    QString report = QString("startup=%1ms load=%2ms export=%3ms total=%4ms peak_rss=%5KB")
+                     .arg(startupTime).arg(loadTime).arg(exportTime).arg(timer.elapsed()).arg(peakRss());
+    qCInfo(appLog) << "Headless export" << format << filePath << (ok ? "succeeded" : "failed") << report;
+    fprintf(stderr, "%s\n", qPrintable(report));
+
+    if (!ok) {
+        fprintf(stderr, "Failed to export to %s\n", qPrintable(filePath));
+        return EC_ExportFailed;
+    }
+    fprintf(stdout, "%s\n", qPrintable(filePath));
+    return EC_Success;
+}
+
+QString HeadlessExport::normalizeFormat(const QString &format)
+{
+    QString fmt = format.trimmed().toLower();
+    if (fmt.startsWith("."))
+        fmt.remove(0, 1);
+
+    if ("txt" == fmt || "html" == fmt)
+        return fmt;
+    if ("doc" == fmt || "docx" == fmt)
+        return "docx";
+    if ("xls" == fmt || "xlsx" == fmt)
+        return "xlsx";
+    return QString();
+}
+
+bool HeadlessExport::exportTo(const QString &format, const QString &filePath)
+{
+    qCDebug(appLog) << "HeadlessExport::exportTo" << format << filePath;
+    if ("txt" == format)
+        return DeviceManager::instance()->exportToTxt(filePath);
+
+    if ("html" == format)
+        return DeviceManager::instance()->exportToHtml(filePath);
+
+    if ("docx" == format)
+        return DeviceManager::instance()->exportToDoc(filePath);
+
+    if ("xlsx" == format)
+        return DeviceManager::instance()->exportToXlsx(filePath);
+
+    qCWarning(appLog) << "HeadlessExport::exportTo unsupported format:" << format;
+    return false;
+}
+
+long HeadlessExport::peakRss()
+{
+    // Linux 下 ru_maxrss 单位为 KB
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return usage.ru_maxrss;
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef HEADLESSEXPORT_H
+#define HEADLESSEXPORT_H
+
+#include <QString>
+
+/**
+ * @brief The HeadlessExport class
+ * 无界面导出：deepin-devicemanager --export=<fmt> --output=<path>
+ * 只创建 QCoreApplication，加载设备信息后直接导出，不初始化任何窗口控件，以退出码表示结果
+ */
+class HeadlessExport
+{
+public:
+    /**
+     * @brief The ExitCode enum : 进程退出码
+     */
+    enum ExitCode {
+        EC_Success = 0,             // 导出成功
+        EC_InvalidArgument = 1,     // 参数错误
+        EC_Unauthorized = 2,        // 认证失败
+        EC_ExportFailed = 3         // 导出失败
+    };
+
+    /**
+     * @brief isRequested:命令行中是否有 --export 参数
+     * @param argc:参数个数
+     * @param argv:参数列表
+     * @return true:无界面导出，false:启动界面
+     */
+    static bool isRequested(int argc, char *argv[]);
+
+    /**
+     * @brief exec:加载设备信息并导出，输出各阶段耗时与内存峰值
+     * @param argc:参数个数
+     * @param argv:参数列表
+     * @return 退出码，见 ExitCode
+     */
+    static int exec(int argc, char *argv[]);
+
+    /**
+     * @brief normalizeFormat:统一导出格式名称，doc 与 xls 分别作为 docx 与 xlsx
+     * @param format:命令行中的格式
+     * @return txt、html、docx、xlsx，不支持的格式返回空
+     */
+    static QString normalizeFormat(const QString &format);
+
+    /**
+     * @brief exportTo:按格式导出设备信息
+     * @param format:normalizeFormat 后的格式
+     * @param filePath:导出文件路径
+     * @return true:成功，false:失败
+     */
+    static bool exportTo(const QString &format, const QString &filePath);
+
+    /**
+     * @brief peakRss:进程的物理内存峰值
+     * @return 内存峰值(KB)
+     */
+    static long peakRss();
+};
+
+#endif // HEADLESSEXPORT_H
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef HWINFOTOKENIZER_H
+#define HWINFOTOKENIZER_H
+
+#include <QStringView>
+
+/**
+ * @brief The HwinfoToken struct : hwinfo 输出中的一行，所有字段都指向原始文本，不分配内存
+ */
+struct HwinfoToken {
+    QStringView line;       //<! 整行内容
+    QStringView key;        //<! 分隔符之前的内容，已去除首尾空白
+    QStringView value;      //<! 分隔符之后的内容，已去除首尾空白
+    QStringView quoted;     //<! value 中最后一对双引号之间的内容，等价于 .*"(.*)".* 的捕获
+    bool        valid;      //<! 行中是否恰好有一个分隔符，等价于 split(separator).size() == 2
+    bool        hasQuoted;  //<! value 中是否有一对双引号
+};
+
+/**
+ * @brief The HwinfoTokenizer class
+ * 单次遍历 hwinfo / lshw 等 "key: value" 格式的文本，逐行产生 HwinfoToken
+ * 客户端与服务端共用，文本需要在遍历期间保持有效
+ */
+class HwinfoTokenizer
+{
+public:
+    explicit HwinfoTokenizer(QStringView text, QStringView separator = QStringView(u": "))
+        : m_Text(text)
+        , m_Separator(separator)
+        , m_Pos(0)
+    {
+    }
+
+    /**
+     * @brief next 获取下一行，与 split("\n") 相同，文本以换行结尾时最后产生一个空行
+     * @param token : 当前行
+     * @return 是否还有行
+     */
+    bool next(HwinfoToken &token)
+    {
+        if (m_Pos > m_Text.size())
+            return false;
+
+        qsizetype end = m_Text.indexOf(QLatin1Char('\n'), m_Pos);
+        if (end < 0)
+            end = m_Text.size();
+        token.line = m_Text.mid(m_Pos, end - m_Pos);
+        m_Pos = end + 1;
+
+        token.key = QStringView();
+        token.value = QStringView();
+        token.quoted = QStringView();
+        token.hasQuoted = false;
+
+        qsizetype sep = token.line.indexOf(m_Separator);
+        token.valid = sep >= 0 && token.line.indexOf(m_Separator, sep + m_Separator.size()) < 0;
+        if (!token.valid)
+            return true;
+
+        token.key = token.line.left(sep).trimmed();
+        token.value = token.line.mid(sep + m_Separator.size()).trimmed();
+
+        qsizetype last = token.value.lastIndexOf(QLatin1Char('"'));
+        qsizetype first = last > 0 ? token.value.lastIndexOf(QLatin1Char('"'), last - 1) : -1;
+        if (first >= 0) {
+            token.quoted = token.value.mid(first + 1, last - first - 1);
+            token.hasQuoted = true;
+        }
+        return true;
+    }
+
+    /**
+     * @brief secondWord 以空格分隔的第二个词，等价于 split(" ")[1].trimmed()
+     * @param value : 如 "pci 0x8086 \"Intel Corporation\""
+     * @param word : 第二个词
+     * @return 是否至少有两个词
+     */
+    static bool secondWord(QStringView value, QStringView &word)
+    {
+        qsizetype begin = value.indexOf(QLatin1Char(' '));
+        if (begin < 0)
+            return false;
+        qsizetype end = value.indexOf(QLatin1Char(' '), begin + 1);
+        if (end < 0)
+            end = value.size();
+        word = value.mid(begin + 1, end - begin - 1).trimmed();
+        return true;
+    }
+
+private:
+    QStringView m_Text;         //<! 原始文本
+    QStringView m_Separator;    //<! 键值分隔符
+    qsizetype   m_Pos;          //<! 下一行的起始位置
+};
+
+#endif // HWINFOTOKENIZER_H
@@ -42,7 +42,7 @@
 #include <QProcess>
 #include <QDir>
 #include <QVBoxLayout>
-#include <QTimer>
+#include <QSignalBlocker>
 #include <QRegularExpression>
 
 DWIDGET_USE_NAMESPACE
@@ -91,6 +91,7 @@ MainWindow::MainWindow(QWidget *parent)
 
     // 关联信号槽
     connect(mp_WorkingThread, &LoadInfoThread::finished, this, &MainWindow::slotLoadingFinish);
+    connect(mp_WorkingThread, &LoadInfoThread::deviceReady, this, &MainWindow::slotDeviceReady);
     connect(mp_DeviceWidget, &DeviceWidget::itemClicked, this, &MainWindow::slotListItemClicked);
     connect(mp_DeviceWidget, &DeviceWidget::refreshInfo, this, &MainWindow::slotRefreshInfo);
     connect(mp_DeviceWidget, &DeviceWidget::exportInfo, this, &MainWindow::slotExportInfo);
@@ -147,11 +148,13 @@ void MainWindow::refreshDataBaseLater()
 {
     qCDebug(appLog) << "MainWindow::refreshDataBaseLater start";
     DBusInterface::getInstance()->refreshInfo();
-    QTimer::singleShot(2000, this, [ = ]() {  //test the x86 the fast desktop PC need 2s
-        qCDebug(appLog) << "MainWindow::refreshDataBaseLater timeout, refresh database";
-        // 加载设备信息
-        refreshDataBase();
-    });
+    // 加载线程等待包含本次刷新的采集完成后只解析一次，正在加载时结束后再加载
+    if (mp_WorkingThread->isRunning()) {
+        qCDebug(appLog) << "MainWindow::refreshDataBaseLater working thread running, load after it finishes";
+        m_RefreshPending = true;
+        return;
+    }
+    refreshDataBase();
     qCDebug(appLog) << "MainWindow::refreshDataBaseLater end";
 }
 
@@ -522,6 +525,7 @@ void MainWindow::refreshDataBase()
             DApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
             m_statusCursorIsWait = true;
         }
+        m_HasReadyDevice = false;
         mp_WorkingThread->start();
     }
 }
@@ -595,6 +599,14 @@ void MainWindow::slotLoadingFinish(const QString &message)
         if (m_IsFirstRefresh)
             m_IsFirstRefresh = false;
 
+        // 加载过程中请求的刷新
+        if (m_RefreshPending) {
+            qCDebug(appLog) << "MainWindow::slotLoadingFinish load the pending refresh";
+            m_RefreshPending = false;
+            mp_WorkingThread->wait();
+            refreshDataBase();
+        }
+
         // 是否切换到驱动界面
         if (m_ShowDriverPage) {
             m_ShowDriverPage = false;
@@ -610,6 +622,26 @@ void MainWindow::slotLoadingFinish(const QString &message)
     }
 }
 
+void MainWindow::slotDeviceReady(DeviceType deviceType)
+{
+    qCDebug(appLog) << "MainWindow::slotDeviceReady type:" << deviceType;
+    m_HasReadyDevice = true;
+    // 已生成的设备类型先显示，全部完成后在 slotLoadingFinish 中统一刷新
+    DeviceManager::instance()->setDeviceListClass();
+    {
+        // 列表更新时会触发当前项的点击，加载过程中不需要执行
+        const QSignalBlocker blocker(mp_DeviceWidget);
+        mp_DeviceWidget->updateListView(DeviceManager::instance()->getDeviceTypes());
+    }
+
+    if (mp_ButtonBox->checkedId() != 1)
+        mp_MainStackWidget->setCurrentWidget(mp_DeviceWidget);
+
+    QList<DeviceBaseInfo *> lst;
+    if (DeviceManager::instance()->getDeviceList(mp_DeviceWidget->currentIndex(), lst) && lst.size() > 0)
+        mp_DeviceWidget->updateDevice(mp_DeviceWidget->currentIndex(), lst);
+}
+
 void MainWindow::slotListItemClicked(const QString &itemStr)
 {
     qCDebug(appLog) << "MainWindow::slotListItemClicked itemStr:" << itemStr;
@@ -652,13 +684,15 @@ void MainWindow::slotListItemClicked(const QString &itemStr)
             monitorNumber = txgpu.getMonitorNumber();
         }
 
-    // 数据刷新时不处理界面刷新
+    QList<DeviceBaseInfo *> lst;
+    // 数据刷新时只显示已生成的设备
     if (m_refreshing || mp_WorkingThread->isRunning()) {
         qCDebug(appLog) << "MainWindow::slotListItemClicked refreshing or working thread running";
+        if (m_HasReadyDevice && DeviceManager::instance()->getDeviceList(itemStr, lst) && lst.size() > 0)
+            mp_DeviceWidget->updateDevice(itemStr, lst);
         return;
     }
 
-    QList<DeviceBaseInfo *> lst;
     bool ret = DeviceManager::instance()->getDeviceList(itemStr, lst);
 
     if (ret && lst.size() > 0) {//当设备大小为0时，显示概况信息
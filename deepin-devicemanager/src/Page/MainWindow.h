@@ -8,6 +8,7 @@
 
 #include "DBusInterface.h"
 #include "DBusDriverInterface.h"
+#include "GenerateDevicePool.h"
 
 #include <DMainWindow>
 #include <DStackedWidget>
@@ -126,7 +127,7 @@ private:
      */
     void refreshDataBase();
     /**
-     * @brief refreshDataBaseLater:刷新设备信息
+     * @brief refreshDataBaseLater:请求后台重新采集，采集完成后加载设备信息
      */
     void refreshDataBaseLater();
 private slots:
@@ -142,6 +143,12 @@ private slots:
      */
     void slotLoadingFinish(const QString &message);
 
+    /**
+     * @brief slotDeviceReady:某类设备生成完成，先行更新设备列表
+     * @param deviceType:设备类型
+     */
+    void slotDeviceReady(DeviceType deviceType);
+
     /**
      * @brief slotListItemClicked:ListView item点击槽函数
      * @param itemStr:item显示字符串
@@ -182,6 +189,8 @@ private:
     bool                  m_IsFirstRefresh = true;
     bool                  m_ShowDriverPage = false;
     bool                  m_statusCursorIsWait = false;
+    bool                  m_HasReadyDevice = false;    // 本次加载是否已有设备生成完成
+    bool                  m_RefreshPending = false;    // 加载过程中请求了刷新，结束后重新加载
 };
 
 #endif // MAINWINDOW_H
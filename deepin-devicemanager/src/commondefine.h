@@ -19,3 +19,15 @@ const int contextMenuWidth_ = 150;
 
 #define GenerateTsItem 0
 const QString DEVICEINFO_PATH = "/tmp/device-info";
+
+// 后台通过ioctl读取的硬盘标识记录，与 deepin-deviceinfo 中 diskidentify.h 的定义一致
+#define DISK_RECORD_MAGIC           "[disk-identify]"
+#define DISK_KEY_INTERFACE          "interface"         // ata 或 nvme
+#define DISK_KEY_MODEL              "model"             // 型号
+#define DISK_KEY_SERIAL             "serial"            // 序列号
+#define DISK_KEY_FIRMWARE           "firmware"          // 固件版本
+#define DISK_KEY_CAPACITY           "capacity"          // 容量(bytes)，0未知
+#define DISK_KEY_CAPACITY_TEXT      "capacity_text"     // 容量，如 1.00 TB
+#define DISK_KEY_SECTOR_SIZE        "sector_size"       // 逻辑扇区大小
+#define DISK_KEY_ROTATION_RATE      "rotation_rate"     // 转速：-1未知，1固态硬盘，其它为rpm
+#define DISK_KEY_SATA_VERSION       "sata_version"      // SATA版本及速度，NVMe为空
@@ -12,6 +12,7 @@
 #include "environments.h"
 #include "DebugTimeManager.h"
 #include "SingleDeviceManager.h"
+#include "HeadlessExport.h"
 #include "DDLog.h"
 #include <DApplication>
 #include <DWidgetUtil>
@@ -74,6 +75,12 @@ int main(int argc, char *argv[])
         Dtk::Core::DLogManager::registerConsoleAppender();
     #endif
 
+    // /usr/bin/deepin-devicemanager --export=<fmt> --output=<path>
+    if (HeadlessExport::isRequested(argc, argv)) {
+        qCDebug(appLog) << "Starting headless export";
+        return HeadlessExport::exec(argc, argv);
+    }
+
     if (!QString(qgetenv("XDG_CURRENT_DESKTOP")).toLower().startsWith("deepin")) {
         qCDebug(appLog) << "XDG_CURRENT_DESKTOP is not deepin, setting it to Deepin";
         setenv("XDG_CURRENT_DESKTOP", "Deepin", 1);
@@ -62,6 +62,40 @@ TEST_F(UT_DeviceInfo, UT_DeviceInfo_getTableData)
     EXPECT_EQ(2, m_deviceBaseInfo->m_TableData.size());
 }
 
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_attribsCache)
+{
+    audio->m_Name = "Audio A";
+    EXPECT_TRUE(audio->getTableData()[0].contains("Audio A"));
+
+    // 未通过设置函数修改时不重新加载
+    audio->m_Name = "Audio B";
+    EXPECT_TRUE(audio->getTableData()[0].contains("Audio A"));
+    EXPECT_FALSE(audio->m_TableDataDirty);
+
+    // 设置函数修改后重新加载
+    audio->setCanEnale(true);
+    EXPECT_TRUE(audio->m_BaseInfoDirty && audio->m_OtherInfoDirty && audio->m_TableDataDirty);
+    EXPECT_TRUE(audio->getTableData()[0].contains("Audio B"));
+
+    // 语言变化后重新加载
+    audio->getBaseAttribs();
+    audio->m_AttribsLocale = "xx_XX";
+    audio->m_Name = "Audio C";
+    EXPECT_TRUE(audio->getTableData()[0].contains("Audio C"));
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_getOtherMapInfo)
+{
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("Module Alias", "snd");
+    audio->addFilterKey("Module Alias");
+    audio->getOtherMapInfo(mapInfo);
+    // 第二次使用缓存的翻译
+    mapInfo.insert("Module Alias", "snd_hda");
+    audio->getOtherMapInfo(mapInfo);
+    EXPECT_EQ(audio->m_MapOtherInfo.value("Module Alias"), QString("snd_hda"));
+}
+
 TEST_F(UT_DeviceInfo, UT_DeviceInfo_subTitle)
 {
     m_deviceBaseInfo = dynamic_cast<DeviceBaseInfo *>(audio);
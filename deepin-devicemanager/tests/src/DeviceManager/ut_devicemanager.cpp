@@ -725,6 +725,78 @@ TEST_F(UT_DeviceManager, UT_DeviceManager_cmdInfo)
     EXPECT_EQ(2, lst.size());
 }
 
+TEST_F(UT_DeviceManager, UT_DeviceManager_freezeCmdInfo)
+{
+    QMap<QString, QList<QMap<QString, QString>>> cmdInfo;
+    cmdInfo["freeze"].append(QMap<QString, QString>());
+    DeviceManager::instance()->addCmdInfo(cmdInfo);
+    DeviceManager::instance()->freezeCmdInfo();
+    EXPECT_TRUE(DeviceManager::instance()->isCmdInfoFrozen());
+    EXPECT_EQ(1, DeviceManager::instance()->cmdInfo("freeze").size());
+
+    // 查询不存在的关键字不会插入
+    int size = DeviceManager::instance()->m_cmdInfo.size();
+    EXPECT_TRUE(DeviceManager::instance()->cmdInfo("not_exist").isEmpty());
+    EXPECT_EQ(size, DeviceManager::instance()->m_cmdInfo.size());
+
+    DeviceManager::instance()->clear();
+    EXPECT_FALSE(DeviceManager::instance()->isCmdInfoFrozen());
+    EXPECT_TRUE(DeviceManager::instance()->cmdInfo("freeze").isEmpty());
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_deviceIndex)
+{
+    DeviceManager::instance()->clear();
+    DeviceInput *mouse1 = new DeviceInput;
+    DeviceInput *mouse2 = new DeviceInput;
+    mouse1->m_UniqueID = "mouse";
+    mouse2->m_UniqueID = "mouse";
+    DeviceManager::instance()->addMouseDevice(mouse1);
+    DeviceManager::instance()->addMouseDevice(mouse2);
+    // 同一个标识返回列表中靠前的设备
+    EXPECT_EQ(mouse1, DeviceManager::instance()->getMouseDevice("mouse"));
+    EXPECT_EQ(nullptr, DeviceManager::instance()->getMouseDevice(""));
+
+    DeviceAudio *audio1 = new DeviceAudio;
+    DeviceAudio *audio2 = new DeviceAudio;
+    audio1->m_SysPath = "/devices/pci0000:00/0000:00:1f.3";
+    audio2->m_SysPath = "/devices/usb1/1-1:1.1";
+    audio2->m_VID_PID = "0x8086a348";
+    DeviceManager::instance()->addAudioDevice(audio1);
+    DeviceManager::instance()->addAudioDevice(audio2);
+    EXPECT_EQ(audio1, DeviceManager::instance()->getAudioDevice("/devices/pci0000:00/0000:00:1f.0"));
+    EXPECT_EQ(audio2, DeviceManager::instance()->getAudioDevice("/devices/usb1/1-1:1.0"));
+    EXPECT_EQ(audio2, DeviceManager::instance()->getAudioDevice("0x8086a348"));
+
+    DeviceManager::instance()->delAudioDevice(audio2);
+    EXPECT_EQ(nullptr, DeviceManager::instance()->getAudioDevice("0x8086a348"));
+    delete audio2;
+
+    DeviceManager::instance()->clear();
+    EXPECT_EQ(nullptr, DeviceManager::instance()->getMouseDevice("mouse"));
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_commitStaging)
+{
+    DeviceManager::instance()->clear();
+    DeviceImage *image = new DeviceImage;
+    image->m_UniqueID = "camera";
+
+    DeviceManager::instance()->beginStaging(DT_Image);
+    DeviceManager::instance()->addImageDevice(image);
+    // 暂存期间本线程可以查找，发布的列表不变
+    EXPECT_EQ(image, DeviceManager::instance()->getImageDevice("camera"));
+    EXPECT_EQ(1, DeviceManager::instance()->convertDeviceList(DT_Image).size());
+    EXPECT_EQ(0, DeviceManager::instance()->m_ListDeviceImage.size());
+    EXPECT_TRUE(DeviceManager::instance()->m_DeviceIndex[DT_Image].isEmpty());
+
+    DeviceManager::instance()->commitStaging();
+    EXPECT_EQ(1, DeviceManager::instance()->m_ListDeviceImage.size());
+    EXPECT_EQ(image, DeviceManager::instance()->getImageDevice("camera"));
+
+    DeviceManager::instance()->clear();
+}
+
 TEST_F(UT_DeviceManager, UT_DeviceManager_getDeviceOverview)
 {
     DeviceManager::instance()->getDeviceOverview();
@@ -152,11 +152,16 @@ TEST_F(UT_DeviceMonitor, UT_DeviceMonitor_setInfoFromXradr_002)
     EXPECT_FALSE(m_deviceMonitor->setInfoFromXradr("disconnected", "/", "/"));
 }
 
-bool ut_monitor_isDXcbPlatform()
+bool ut_monitor_isXcbPlatform()
 {
     return true;
 }
 
+bool ut_monitor_isNotXcbPlatform()
+{
+    return false;
+}
+
 TEST_F(UT_DeviceMonitor, UT_DeviceMonitor_setInfoFromXradr_003)
 {
     m_deviceMonitor->m_Interface = "";
@@ -164,7 +169,7 @@ TEST_F(UT_DeviceMonitor, UT_DeviceMonitor_setInfoFromXradr_003)
     QString edid = "";
 
     Stub stub;
-    stub.set(ADDR(DApplication, isDXcbPlatform), ut_monitor_isDXcbPlatform);
+    stub.set(ADDR(DeviceMonitor, isXcbPlatform), ut_monitor_isXcbPlatform);
 
     EXPECT_FALSE(m_deviceMonitor->setInfoFromXradr(main, edid, "/"));
 }
@@ -177,7 +182,7 @@ TEST_F(UT_DeviceMonitor, UT_DeviceMonitor_setInfoFromXradr_004)
     QString edid = "00ffffffffffff005a63384001010101\n0d1e010380351d782ece65a657519f27\n";
 
     Stub stub;
-    stub.set(ADDR(DApplication, isDXcbPlatform), ut_monitor_isDXcbPlatform);
+    stub.set(ADDR(DeviceMonitor, isXcbPlatform), ut_monitor_isXcbPlatform);
 
     EXPECT_FALSE(m_deviceMonitor->setInfoFromXradr(main, edid, "/"));
 }
@@ -189,6 +194,10 @@ TEST_F(UT_DeviceMonitor, UT_DeviceMonitor_setInfoFromXradr_005)
     QString main = "HDMI-1 connected primary 1920x1080+0+0 (normal left inverted right x axis y axis) 527mm x 296mm";
     QString edid = "00ffffffffffff005a63384001010101\n0d1e010380351d782ece65a657519f27\n";
     QString rate = "60.00Hz";
+
+    Stub stub;
+    stub.set(ADDR(DeviceMonitor, isXcbPlatform), ut_monitor_isNotXcbPlatform);
+
     EXPECT_TRUE(m_deviceMonitor->setInfoFromXradr(main, edid, rate));
 }
 
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "DeviceStorage.h"
+#include "commondefine.h"
 
 #include "ut_Head.h"
 #include "stub.h"
@@ -315,6 +316,18 @@ TEST_F(UT_DeviceStorage, UT_DeviceStorage_isValid_002)
     EXPECT_FALSE(m_deviceStorage->isValid());
 }
 
+TEST_F(UT_DeviceStorage, UT_DeviceStorage_unitConvertByDecimal)
+{
+    m_deviceStorage->getTableData();
+    EXPECT_FALSE(m_deviceStorage->m_TableDataDirty);
+
+    // 容量单位转换后重新加载
+    m_deviceStorage->m_SizeBytes = Q_UINT64_C(256000000000);
+    m_deviceStorage->unitConvertByDecimal();
+    EXPECT_TRUE(m_deviceStorage->m_BaseInfoDirty && m_deviceStorage->m_OtherInfoDirty && m_deviceStorage->m_TableDataDirty);
+    EXPECT_EQ("256 GB", m_deviceStorage->m_Size);
+}
+
 TEST_F(UT_DeviceStorage, UT_DeviceStorage_setDiskSerialID_001)
 {
     QString deviceFiles = "/dev/sda, /dev/disk/by-path/pci-0000:00:17.0-ata-3, /dev/disk/by-id/ata-CT240BX500SSD1_2002E3E0B393";
@@ -483,3 +496,48 @@ TEST_F(UT_DeviceStorage, UT_DeviceStorage_getInfoFromsmartctl_002)
     EXPECT_STREQ("CT240BX500SSD1", m_deviceStorage->m_Model.toStdString().c_str());
     EXPECT_STREQ("2002E3E0B393", m_deviceStorage->m_SerialNumber.toStdString().c_str());
 }
+
+TEST_F(UT_DeviceStorage, UT_DeviceStorage_getInfoFromDiskIdentify)
+{
+    // 记录中的标识字段必须全部设置
+    QMap<QString, QString> mapinfo;
+    mapinfo.insert("ln", "nvme0n1");
+    mapinfo.insert(DISK_KEY_INTERFACE, "nvme");
+    mapinfo.insert(DISK_KEY_MODEL, "Samsung SSD 970 EVO Plus 250GB");
+    mapinfo.insert(DISK_KEY_SERIAL, "S4EWNX0N123456");
+    mapinfo.insert(DISK_KEY_FIRMWARE, "2B2QEXM7");
+    mapinfo.insert(DISK_KEY_CAPACITY, "250059350016");
+    mapinfo.insert(DISK_KEY_CAPACITY_TEXT, "250 GB");
+    mapinfo.insert(DISK_KEY_SECTOR_SIZE, "512");
+    mapinfo.insert(DISK_KEY_ROTATION_RATE, "1");
+    mapinfo.insert(DISK_KEY_SATA_VERSION, "");
+
+    m_deviceStorage->m_DeviceFile = "/dev/nvme0n1";
+    EXPECT_TRUE(m_deviceStorage->addInfoFromSmartctl("nvme0n1", mapinfo));
+    EXPECT_STREQ("Samsung SSD 970 EVO Plus 250GB", m_deviceStorage->m_Name.toStdString().c_str());
+    EXPECT_STREQ("S4EWNX0N123456", m_deviceStorage->m_SerialNumber.toStdString().c_str());
+    EXPECT_STREQ("2B2QEXM7", m_deviceStorage->m_FirmwareVersion.toStdString().c_str());
+    EXPECT_STREQ("Solid State Device", m_deviceStorage->m_RotationRate.toStdString().c_str());
+    EXPECT_STREQ("250 GB", m_deviceStorage->m_Size.toStdString().c_str());
+    EXPECT_EQ(Q_UINT64_C(250059350016), m_deviceStorage->m_SizeBytes);
+}
+
+TEST_F(UT_DeviceStorage, UT_DeviceStorage_getInfoFromDiskIdentify_usb)
+{
+    // 没有读到型号的USB硬盘按固态硬盘处理，与smartctl信息不足时一致
+    QMap<QString, QString> mapinfo;
+    mapinfo.insert(DISK_KEY_INTERFACE, "ata");
+    mapinfo.insert(DISK_KEY_MODEL, "");
+    mapinfo.insert(DISK_KEY_SERIAL, "");
+    mapinfo.insert(DISK_KEY_CAPACITY, "0");
+
+    m_deviceStorage->m_Interface = "USB";
+    m_deviceStorage->getInfoFromDiskIdentify(mapinfo);
+    EXPECT_STREQ("SSD", m_deviceStorage->m_MediaType.toStdString().c_str());
+    EXPECT_TRUE(m_deviceStorage->m_Name.isEmpty());
+
+    m_deviceStorage->m_Interface = "SATA";
+    m_deviceStorage->m_MediaType = "";
+    m_deviceStorage->getInfoFromDiskIdentify(mapinfo);
+    EXPECT_TRUE(m_deviceStorage->m_MediaType.isEmpty());
+}
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ExportWriter.h"
+#include "DeviceManager.h"
+#include "DeviceAudio.h"
+#include "xlsxdocument.h"
+#include "ut_Head.h"
+#include "ut_heap.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QXmlStreamReader>
+
+#include <private/qzipreader_p.h>
+
+#include <gtest/gtest.h>
+
+#define BENCH_DEVICE_COUNT 5000
+
+// 压缩包中的 xml 都能完整解析
+static bool zipXmlValid(const QString &filePath, const QString &part, QByteArray *data = nullptr)
+{
+    QZipReader reader(filePath);
+    if (reader.status() != QZipReader::NoError)
+        return false;
+
+    foreach (const QZipReader::FileInfo &info, reader.fileInfoList()) {
+        if (!info.filePath.endsWith(".xml") && !info.filePath.endsWith(".rels"))
+            continue;
+
+        QXmlStreamReader xml(reader.fileData(info.filePath));
+        while (!xml.atEnd())
+            xml.readNext();
+        if (xml.hasError())
+            return false;
+    }
+
+    if (data)
+        *data = reader.fileData(part);
+    return reader.fileData(part).size() > 0;
+}
+
+/**
+ * @brief The PeakWriter class : 转发导出事件，每个设备结束后记录堆内存
+ */
+class PeakWriter : public ExportWriter
+{
+public:
+    explicit PeakWriter(ExportWriter *writer) : mp_Writer(writer), m_Base(heapUsed()), m_Peak(0) {}
+
+    bool open(const QString &filePath) override { return mp_Writer->open(filePath); }
+    bool close() override { return mp_Writer->close(); }
+    void overview(const QString &title, const QList<QPair<QString, QString>> &info) override { mp_Writer->overview(title, info); }
+    void beginSection(const QString &title) override { mp_Writer->beginSection(title); }
+    void emptySection(const QString &msg) override { mp_Writer->emptySection(msg); }
+    void beginTable(const QStringList &header) override { mp_Writer->beginTable(header); }
+    void tableRow(const QStringList &data) override { mp_Writer->tableRow(data); sample(); }
+    void endTable() override { mp_Writer->endTable(); }
+    void beginDevice(const QString &subTitle) override { mp_Writer->beginDevice(subTitle); }
+    void deviceInfo(const QList<QPair<QString, QString>> &info) override { mp_Writer->deviceInfo(info); }
+    void endDevice() override { mp_Writer->endDevice(); sample(); }
+    void endSection() override { mp_Writer->endSection(); }
+
+    size_t peak() const { return m_Peak > m_Base ? m_Peak - m_Base : 0; }
+
+private:
+    void sample() { m_Peak = qMax(m_Peak, heapUsed()); }
+
+    ExportWriter *mp_Writer;
+    size_t m_Base;
+    size_t m_Peak;
+};
+
+class UT_ExportWriter : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        DeviceManager::instance()->clear();
+        ASSERT_TRUE(m_Dir.isValid());
+    }
+    void TearDown()
+    {
+        DeviceManager::instance()->clear();
+    }
+
+    // 生成声卡设备，属性数量与真实设备相近
+    void addAudioDevices(int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            DeviceAudio *audio = new DeviceAudio;
+            audio->m_Name = QString("Audio <%1> & Co").arg(i);
+            audio->m_Vendor = "Intel Corporation";
+            audio->m_SysPath = QString("/devices/pci0000:00/0000:00:1f.%1").arg(i);
+            audio->m_Description = "Audio device";
+            audio->m_Version = "10";
+            audio->m_Driver = "snd_hda_intel";
+            audio->m_Modalias = QString("pci:v00008086d0000A0C8sv%1").arg(i, 8, 10, QChar('0'));
+            audio->m_PhysID = "1f.3";
+            audio->m_Chip = "Intel Corporation Tiger Lake-LP Smart Sound Technology Audio Controller";
+            audio->m_Capabilities = "pm msi pciexpress bus_master cap_list";
+            audio->m_Memory = "603f1a0000-603f1a3fff";
+            audio->m_Irq = QString::number(i % 256);
+            DeviceManager::instance()->m_ListDeviceAudio.append(audio);
+        }
+    }
+
+    QString filePath(const QString &name) const
+    {
+        return m_Dir.filePath(name);
+    }
+
+    QTemporaryDir m_Dir;
+};
+
+TEST_F(UT_ExportWriter, UT_ExportWriter_txt)
+{
+    addAudioDevices(2);
+    QString path = filePath("export.txt");
+    ASSERT_TRUE(DeviceManager::instance()->exportToTxt(path));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QString text = QString::fromUtf8(file.readAll());
+    EXPECT_TRUE(text.contains("[" + QObject::tr("Sound Adapter") + "]"));
+    EXPECT_TRUE(text.contains(QObject::tr("No CPU found")));
+    EXPECT_TRUE(text.contains("Audio <1> & Co\n"));
+    EXPECT_TRUE(text.contains("snd_hda_intel"));
+}
+
+TEST_F(UT_ExportWriter, UT_ExportWriter_html)
+{
+    addAudioDevices(2);
+    QString path = filePath("export.html");
+    ASSERT_TRUE(DeviceManager::instance()->exportToHtml(path));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QString html = QString::fromUtf8(file.readAll());
+    EXPECT_TRUE(html.startsWith("<!DOCTYPE html>"));
+    EXPECT_TRUE(html.endsWith("</html>\n"));
+    EXPECT_TRUE(html.contains("<h3>Audio &lt;0&gt; &amp; Co</h3>"));
+    EXPECT_FALSE(html.contains("Audio <0>"));
+}
+
+TEST_F(UT_ExportWriter, UT_ExportWriter_xlsx)
+{
+    addAudioDevices(3);
+    QString path = filePath("export.xlsx");
+    ASSERT_TRUE(DeviceManager::instance()->exportToXlsx(path));
+
+    QByteArray sheet;
+    ASSERT_TRUE(zipXmlValid(path, "xl/worksheets/sheet1.xml", &sheet));
+    EXPECT_TRUE(sheet.contains("Audio &lt;2&gt; &amp; Co"));
+    EXPECT_TRUE(sheet.contains("<row r=\"1\"><c r=\"A1\" s=\"1\" t=\"inlineStr\">"));
+
+    // QXlsx 能打开导出的表格
+    QXlsx::Document xlsx(path);
+    EXPECT_NE(xlsx.currentWorksheet(), nullptr);
+}
+
+TEST_F(UT_ExportWriter, UT_ExportWriter_doc)
+{
+    addAudioDevices(3);
+
+    // 模板不存在时使用最简单的文档结构
+    QString minimal = filePath("minimal.docx");
+    DocExportWriter minimalWriter(filePath("not_exist.docx"));
+    ASSERT_TRUE(minimalWriter.open(minimal));
+    ASSERT_TRUE(DeviceManager::instance()->exportDevices(minimalWriter));
+    ASSERT_TRUE(zipXmlValid(minimal, "word/document.xml"));
+
+    // 以导出的文件为模板，其他部件原样复制，内容插在 sectPr 之前
+    QString path = filePath("export.docx");
+    DocExportWriter writer(minimal);
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(DeviceManager::instance()->exportDevices(writer));
+
+    QByteArray document;
+    ASSERT_TRUE(zipXmlValid(path, "word/document.xml", &document));
+    EXPECT_EQ(document.count("<w:sectPr"), 1);
+    EXPECT_EQ(document.count("<w:tbl>"), 2);
+    EXPECT_TRUE(document.contains("Audio &lt;1&gt; &amp; Co"));
+    EXPECT_TRUE(QZipReader(path).fileData("_rels/.rels").size() > 0);
+}
+
+TEST_F(UT_ExportWriter, UT_ExportWriter_benchmark)
+{
+    addAudioDevices(BENCH_DEVICE_COUNT);
+
+    // 属性列表由设备缓存，先加载，只统计导出本身的内存
+    foreach (DeviceBaseInfo *device, DeviceManager::instance()->m_ListDeviceAudio) {
+        device->getBaseAttribs();
+        device->getOtherAttribs();
+        device->getTableData();
+    }
+
+    TxtExportWriter txt;
+    HtmlExportWriter html;
+    DocExportWriter doc(filePath("not_exist.docx"));
+    XlsxExportWriter xlsx;
+    QList<QPair<QString, ExportWriter *>> writers;
+    writers << qMakePair(QString("bench.txt"), static_cast<ExportWriter *>(&txt))
+            << qMakePair(QString("bench.html"), static_cast<ExportWriter *>(&html))
+            << qMakePair(QString("bench.docx"), static_cast<ExportWriter *>(&doc))
+            << qMakePair(QString("bench.xlsx"), static_cast<ExportWriter *>(&xlsx));
+
+    foreach (auto item, writers) {
+        PeakWriter writer(item.second);
+        QElapsedTimer timer;
+        timer.start();
+        ASSERT_TRUE(writer.open(filePath(item.first)));
+        ASSERT_TRUE(DeviceManager::instance()->exportDevices(writer));
+        qint64 elapsed = timer.elapsed();
+
+        // 内存占用与设备数量无关
+        EXPECT_LT(writer.peak(), size_t(4 * 1024 * 1024)) << item.first.toStdString();
+        qInfo() << item.first << "devices:" << BENCH_DEVICE_COUNT << "time:" << elapsed << "ms"
+                << "size:" << QFileInfo(filePath(item.first)).size() << "bytes" << "peak heap:" << writer.peak() << "bytes";
+    }
+
+    // 对比：同样的内容写入 QXlsx::Document，保存前整个表格都在内存中
+    size_t base = heapUsed();
+    QElapsedTimer timer;
+    timer.start();
+    {
+        QXlsx::Document document;
+        int row = 1;
+        foreach (DeviceBaseInfo *device, DeviceManager::instance()->m_ListDeviceAudio) {
+            for (const QPair<QString, QString> &item : device->getBaseAttribs() + device->getOtherAttribs()) {
+                document.write(row, 1, item.first);
+                document.write(row++, 2, item.second);
+            }
+            row++;
+        }
+        size_t domHeap = heapUsed() - base;
+        document.saveAs(filePath("dom.xlsx"));
+        qInfo() << "QXlsx::Document devices:" << BENCH_DEVICE_COUNT << "time:" << timer.elapsed() << "ms"
+                << "heap:" << domHeap << "bytes";
+    }
+}
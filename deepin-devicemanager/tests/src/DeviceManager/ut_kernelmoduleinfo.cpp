@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "KernelModuleInfo.h"
+#include "commonfunction.h"
+#include "ut_Head.h"
+
+#include <QElapsedTimer>
+#include <QStandardPaths>
+
+#include <gtest/gtest.h>
+
+#define BENCH_QUERY_COUNT 40
+
+// 设备生成时常见的驱动，不同机器上可能是模块、内建或不存在
+static const char *const DRIVERS[] = {
+    "usbhid", "snd_hda_intel", "xhci_hcd", "uvcvideo", "btusb", "e1000e", "not_a_module",
+};
+
+class UT_KernelModuleInfo : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        KernelModuleInfo::instance()->invalidate();
+    }
+    void TearDown()
+    {
+        KernelModuleInfo::instance()->invalidate();
+    }
+};
+
+TEST_F(UT_KernelModuleInfo, UT_KernelModuleInfo_info)
+{
+    KernelModuleInfo *moduleInfo = KernelModuleInfo::instance();
+    EXPECT_FALSE(moduleInfo->info("").found);
+    EXPECT_FALSE(moduleInfo->info("not_a_module").found);
+    EXPECT_TRUE(moduleInfo->m_Cache.contains("not_a_module"));
+
+    // 内建模块没有文件
+    KernelModuleInfo::Info info = moduleInfo->info("usbhid");
+    if (info.found)
+        EXPECT_EQ(info.builtin, info.filename.isEmpty());
+
+    moduleInfo->invalidate();
+    EXPECT_TRUE(moduleInfo->m_Cache.isEmpty());
+    EXPECT_EQ(moduleInfo->mp_Ctx, nullptr);
+}
+
+TEST_F(UT_KernelModuleInfo, UT_KernelModuleInfo_modinfo)
+{
+    // 与 modinfo 的输出一致，没有 modinfo 时不比较
+    if (QStandardPaths::findExecutable("modinfo").isEmpty())
+        return;
+
+    for (size_t i = 0; i < sizeof(DRIVERS) / sizeof(DRIVERS[0]); ++i) {
+        QString outInfo = Common::executeClientCmd("modinfo", QStringList() << DRIVERS[i], QString(), -1);
+        EXPECT_EQ(outInfo.contains("filename:"), KernelModuleInfo::instance()->info(DRIVERS[i]).found) << DRIVERS[i];
+    }
+}
+
+TEST_F(UT_KernelModuleInfo, UT_KernelModuleInfo_benchmark)
+{
+    // 40次查询，对比执行 modinfo 与缓存的耗时
+    size_t driverCount = sizeof(DRIVERS) / sizeof(DRIVERS[0]);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < BENCH_QUERY_COUNT; ++i)
+        Common::executeClientCmd("modinfo", QStringList() << DRIVERS[i % driverCount], QString(), -1);
+    qint64 modinfoTime = timer.nsecsElapsed();
+
+    timer.restart();
+    int found = 0;
+    for (int i = 0; i < BENCH_QUERY_COUNT; ++i)
+        found += KernelModuleInfo::instance()->info(DRIVERS[i % driverCount]).found;
+    qint64 cacheTime = timer.nsecsElapsed();
+
+    EXPECT_EQ(static_cast<int>(driverCount), KernelModuleInfo::instance()->m_Cache.size());
+    qInfo() << "queries:" << BENCH_QUERY_COUNT << "found:" << found
+            << "modinfo:" << modinfoTime / 1000 << "us" << "kmod:" << cacheTime / 1000 << "us";
+}
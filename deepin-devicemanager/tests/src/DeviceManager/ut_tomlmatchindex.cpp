@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "TomlMatchIndex.h"
+#include "DeviceManager.h"
+#include "DeviceInput.h"
+#include "ut_Head.h"
+
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+#define BENCH_DEVICE_COUNT 300
+#define BENCH_TOML_COUNT 500
+
+static QList<DeviceBaseInfo *> buildDevices()
+{
+    QList<DeviceBaseInfo *> devices;
+    for (int i = 0; i < BENCH_DEVICE_COUNT; ++i) {
+        DeviceInput *device = new DeviceInput;
+        QString vid = QString("%1").arg(0x1000 + i, 4, 16, QLatin1Char('0'));
+        QString pid = QString("%1").arg(0x2000 + i, 4, 16, QLatin1Char('0'));
+        device->m_Modalias = QString("usb:v%1p%2d0100dc00dsc00dp00ic03isc01ip02in00").arg(vid.toUpper()).arg(pid.toUpper());
+        // 一半的设备只有 VID_PID
+        if (i % 2 == 0) {
+            device->m_VID = "0x" + vid;
+            device->m_PID = "0x" + pid;
+        }
+        device->m_VID_PID = "0x" + vid + pid;
+        device->m_Vendor = QString("Vendor %1").arg(i);
+        device->m_Name = QString("Mouse %1").arg(i);
+        devices.append(device);
+    }
+    return devices;
+}
+
+// 与 oeminfo toml 中 [tomlMouse.xxx] 解析后的条目相同
+static QList<QMap<QString, QString> > buildToml()
+{
+    QList<QMap<QString, QString> > lstToml;
+    for (int i = 0; i < BENCH_TOML_COUNT; ++i) {
+        int index = (i * 7) % BENCH_DEVICE_COUNT;
+        QString vid = QString("%1").arg(0x1000 + index, 4, 16, QLatin1Char('0'));
+        QString pid = QString("%1").arg(0x2000 + index, 4, 16, QLatin1Char('0'));
+        QMap<QString, QString> mapInfo;
+        switch (i % 5) {
+        case 0:
+            mapInfo.insert("Modalias", QString("usb:v%1p%2d0100dc00dsc00dp00ic03isc01ip02in00").arg(vid.toUpper()).arg(pid.toUpper()));
+            break;
+        case 1:
+            mapInfo.insert("Vendor_ID", "0x" + vid.toUpper());
+            mapInfo.insert("Product_ID", "0x" + pid);
+            break;
+        case 2:
+            mapInfo.insert("Vendor", QString("VENDOR %1").arg(index));
+            mapInfo.insert("Name", QString("mouse %1").arg(index));
+            break;
+        case 3:
+            mapInfo.insert("Modalias", QString("mouse:v0000%1d0000%2").arg(vid).arg(pid));
+            break;
+        default:
+            mapInfo.insert("Modalias", QString("usb:v%1pFFFF").arg(i));
+            mapInfo.insert("Vendor", "Unknown");
+            mapInfo.insert("Name", QString("Unknown %1").arg(i));
+            break;
+        }
+        mapInfo.insert("Model", QString("toml %1").arg(i));
+        lstToml.append(mapInfo);
+    }
+    return lstToml;
+}
+
+static QList<DeviceBaseInfo *> naiveMatch(const QList<DeviceBaseInfo *> &devices, const QMap<QString, QString> &mapInfo)
+{
+    DeviceManager *manager = DeviceManager::instance();
+    QList<DeviceBaseInfo *> lst;
+    foreach (DeviceBaseInfo *device, devices) {
+        if (manager->findByModalias(DT_Mouse, device, manager->PhysID(mapInfo, "Modalias"))
+                || manager->findByVIDPID(DT_Mouse, device, manager->PhysID(mapInfo, "Vendor_ID"), manager->PhysID(mapInfo, "Product_ID"))
+                || manager->findByVendorName(DT_Mouse, device, manager->PhysID(mapInfo, "Vendor"), manager->PhysID(mapInfo, "Name")))
+            lst.append(device);
+    }
+    return lst;
+}
+
+static QList<DeviceBaseInfo *> indexMatch(const TomlMatchIndex &index, const QMap<QString, QString> &mapInfo)
+{
+    DeviceManager *manager = DeviceManager::instance();
+    return index.match(manager->PhysID(mapInfo, "Modalias"), manager->PhysID(mapInfo, "Vendor_ID"),
+                       manager->PhysID(mapInfo, "Product_ID"), manager->PhysID(mapInfo, "Vendor"),
+                       manager->PhysID(mapInfo, "Name"));
+}
+
+class UT_TomlMatchIndex : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Devices = buildDevices();
+        m_Toml = buildToml();
+    }
+    void TearDown()
+    {
+        qDeleteAll(m_Devices);
+        m_Devices.clear();
+    }
+
+    QList<DeviceBaseInfo *> m_Devices;
+    QList<QMap<QString, QString> > m_Toml;
+};
+
+TEST_F(UT_TomlMatchIndex, UT_TomlMatchIndex_match)
+{
+    TomlMatchIndex index(DT_Mouse);
+    foreach (DeviceBaseInfo *device, m_Devices)
+        index.insert(device);
+
+    // 与逐个比较的结果及顺序一致
+    foreach (const auto &mapInfo, m_Toml)
+        EXPECT_EQ(naiveMatch(m_Devices, mapInfo), indexMatch(index, mapInfo));
+
+    // 信息变化后重新索引
+    DeviceInput *device = dynamic_cast<DeviceInput *>(m_Devices[1]);
+    device->m_Name = "Renamed";
+    index.update(device);
+    EXPECT_TRUE(index.match("", "", "", "vendor 1", "mouse 1").isEmpty());
+    EXPECT_EQ(QList<DeviceBaseInfo *>() << device, index.match("", "", "", "vendor 1", "renamed"));
+
+    index.remove(device);
+    EXPECT_TRUE(index.match("", "", "", "vendor 1", "renamed").isEmpty());
+}
+
+TEST_F(UT_TomlMatchIndex, UT_TomlMatchIndex_computer)
+{
+    TomlMatchIndex index(DT_Computer);
+    index.insert(m_Devices[0]);
+    // 计算机信息只有一条，有名称即认为相同
+    EXPECT_EQ(1, index.match("", "", "", "", "uos").size());
+    EXPECT_TRUE(index.match("", "", "", "", "").isEmpty());
+}
+
+TEST_F(UT_TomlMatchIndex, UT_TomlMatchIndex_benchmark)
+{
+    // 300个设备，500条toml信息，对比逐个比较与索引的耗时
+    QElapsedTimer timer;
+    timer.start();
+    int naiveCount = 0;
+    foreach (const auto &mapInfo, m_Toml)
+        naiveCount += naiveMatch(m_Devices, mapInfo).size();
+    qint64 naiveTime = timer.nsecsElapsed();
+
+    timer.restart();
+    TomlMatchIndex index(DT_Mouse);
+    foreach (DeviceBaseInfo *device, m_Devices)
+        index.insert(device);
+    int indexCount = 0;
+    foreach (const auto &mapInfo, m_Toml)
+        indexCount += indexMatch(index, mapInfo).size();
+    qint64 indexTime = timer.nsecsElapsed();
+
+    EXPECT_EQ(naiveCount, indexCount);
+    qInfo() << "devices:" << BENCH_DEVICE_COUNT << "toml:" << BENCH_TOML_COUNT << "matched:" << indexCount
+            << "naive:" << naiveTime / 1000 << "us" << "index:" << indexTime / 1000 << "us";
+}
+
+TEST_F(UT_TomlMatchIndex, UT_TomlMatchIndex_tomlDeviceSet)
+{
+    DeviceManager *manager = DeviceManager::instance();
+    manager->clear();
+    foreach (DeviceBaseInfo *device, m_Devices)
+        manager->addMouseDevice(dynamic_cast<DeviceInput *>(device));
+    m_Devices.clear();
+
+    QMap<QString, QList<QMap<QString, QString> > > cmdInfo;
+    cmdInfo.insert("tomlMouse", m_Toml);
+    manager->addCmdInfo(cmdInfo);
+
+    QElapsedTimer timer;
+    timer.start();
+    manager->tomlDeviceSet(DT_Mouse);
+    qInfo() << "tomlDeviceSet:" << timer.nsecsElapsed() / 1000 << "us";
+
+    // 每5条中有1条没有相同的设备，作为新设备加入
+    EXPECT_EQ(BENCH_DEVICE_COUNT + BENCH_TOML_COUNT / 5, manager->m_ListDeviceMouse.size());
+    manager->clear();
+}
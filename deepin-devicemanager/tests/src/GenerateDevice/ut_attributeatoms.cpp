@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "AttributeAtoms.h"
+#include "CmdTool.h"
+#include "ut_Head.h"
+#include "ut_heap.h"
+
+#include <QElapsedTimer>
+#include <QMap>
+
+#include <gtest/gtest.h>
+
+#define BENCH_DEVICE_COUNT 300
+
+static const char *const DEVICE_KEYS[] = {
+    "Hardware Class", "SysFS BusID", "SysFS ID", "Unique ID", "Parent ID", "Model", "Vendor", "Device",
+    "SubVendor", "SubDevice", "Revision", "Driver", "Driver Modules", "Module Alias", "Config Status",
+    "Serial ID", "Hotplug", "Device File", "Speed", "IRQ", "Memory Range", "Attached to", "VID", "PID", "VID_PID",
+};
+
+// 与解析时一样，属性名由原文生成
+static QList<QMap<QString, QString> > buildDevices(bool interned)
+{
+    QList<QMap<QString, QString> > devices;
+    for (int i = 0; i < BENCH_DEVICE_COUNT; ++i) {
+        QMap<QString, QString> mapInfo;
+        for (size_t k = 0; k < sizeof(DEVICE_KEYS) / sizeof(DEVICE_KEYS[0]); ++k) {
+            QString line = QString("  %1: value %2").arg(DEVICE_KEYS[k]).arg(i);
+            QStringView key = QStringView(line).mid(2, line.indexOf(": ") - 2);
+            mapInfo.insert(interned ? AttributeAtoms::intern(key) : key.toString(), line.mid(line.indexOf(": ") + 2));
+        }
+        devices.append(mapInfo);
+    }
+    return devices;
+}
+
+class UT_AttributeAtoms : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+TEST_F(UT_AttributeAtoms, UT_AttributeAtoms_intern)
+{
+    QString first = AttributeAtoms::intern(u"Hardware Class");
+    QString second = AttributeAtoms::intern(QString("Hardware Class"));
+    EXPECT_EQ(first, QString("Hardware Class"));
+    // 共享同一份数据
+    EXPECT_EQ(first.constData(), second.constData());
+
+    EXPECT_GE(AttributeAtoms::indexOf(u"logical name"), 0);
+    EXPECT_EQ(AttributeAtoms::indexOf(u"not an attribute"), -1);
+    EXPECT_EQ(AttributeAtoms::intern(u"not an attribute"), QString("not an attribute"));
+    EXPECT_GT(AttributeAtoms::count(), 0);
+}
+
+TEST_F(UT_AttributeAtoms, UT_AttributeAtoms_parser)
+{
+    CmdTool tool;
+    QMap<QString, QString> first, second;
+    tool.getMapInfoFromHwinfo("Hardware Class: mouse\nVendor: usb 0x248a \"Maxxter\"\n", first);
+    tool.getMapInfoFromHwinfo("Hardware Class: keyboard\n", second);
+    EXPECT_EQ(first.find("Hardware Class").key().constData(), second.find("Hardware Class").key().constData());
+    EXPECT_EQ(first["Vendor"], QString("Maxxter"));
+}
+
+TEST_F(UT_AttributeAtoms, UT_AttributeAtoms_benchmark)
+{
+    // 300个设备，对比属性名驻留前后的内存与查找耗时，驻留表先初始化
+    AttributeAtoms::count();
+    size_t before = heapUsed();
+    QList<QMap<QString, QString> > plain = buildDevices(false);
+    size_t plainBytes = heapUsed() - before;
+
+    before = heapUsed();
+    QList<QMap<QString, QString> > interned = buildDevices(true);
+    size_t internedBytes = heapUsed() - before;
+
+    QElapsedTimer timer;
+    timer.start();
+    int found = 0;
+    foreach (const auto &mapInfo, plain)
+        found += mapInfo.contains("SysFS BusID") + mapInfo.contains("Driver") + mapInfo.contains("Unknown Key");
+    qint64 plainLookup = timer.nsecsElapsed();
+
+    timer.restart();
+    foreach (const auto &mapInfo, interned)
+        found -= mapInfo.contains("SysFS BusID") + mapInfo.contains("Driver") + mapInfo.contains("Unknown Key");
+    qint64 internedLookup = timer.nsecsElapsed();
+
+    EXPECT_EQ(found, 0);
+    EXPECT_LT(internedBytes, plainBytes);
+    qInfo() << "devices:" << BENCH_DEVICE_COUNT << "plain:" << plainBytes << "bytes" << plainLookup / 1000 << "us"
+            << "interned:" << internedBytes << "bytes" << internedLookup / 1000 << "us";
+}
@@ -172,6 +172,38 @@ TEST_F(UT_CmdTool, UT_CmdTool_loadLshwInfo)
     EXPECT_EQ(10, size);
 }
 
+bool ut_getDeviceInfo_loadLshwMemory(void *obj, QString &deviceInfo, const QString &file)
+{
+    deviceInfo = "uos-PC\n"
+                 "    description: Notebook\n"
+                 "  *-core\n"
+                 "     *-memory\n"
+                 "          description: System Memory\n"
+                 "          size: 16GiB\n"
+                 "     *-network\n"
+                 "          logical name: /dev/fb0\n"
+                 "          logical name: wlp2s0\n"
+                 "          configuration: broadcast=yes driver=iwlwifi latency=0 bad\n"
+                 "          resources: irq:16 memory:a1200000-a1203fff memory:a1300000-a1303fff\n";
+    return true;
+}
+TEST_F(UT_CmdTool, UT_CmdTool_loadLshwInfo_memory)
+{
+    Stub stub;
+    stub.set(ADDR(CmdTool, getDeviceInfo), ut_getDeviceInfo_loadLshwMemory);
+    m_cmdTool->loadLshwInfo("lshw.txt");
+    // 没有bank时使用memory
+    ASSERT_EQ(m_cmdTool->m_cmdInfo["lshw_memory"].size(), 1);
+    EXPECT_EQ(m_cmdTool->m_cmdInfo["lshw_memory"][0]["size"], QString("16GiB"));
+
+    ASSERT_EQ(m_cmdTool->m_cmdInfo["lshw_network"].size(), 1);
+    const QMap<QString, QString> &network = m_cmdTool->m_cmdInfo["lshw_network"][0];
+    EXPECT_EQ(network["logical name"], QString("wlp2s0"));
+    EXPECT_EQ(network["driver"], QString("iwlwifi"));
+    EXPECT_FALSE(network.contains("bad"));
+    EXPECT_EQ(network["memory"], QString("a1200000-a1203fff  a1300000-a1303fff"));
+}
+
 bool ut_getDeviceInfo_loadLsblkInfo(void *obj, QString &deviceInfo, const QString &file)
 {
     deviceInfo = "NAME ROTA\n"
@@ -235,6 +267,38 @@ TEST_F(UT_CmdTool, UT_CmdTool_loadSmartCtlInfo)
     EXPECT_TRUE(m_cmdTool->m_cmdInfo.find("smart") != m_cmdTool->m_cmdInfo.end());
 }
 
+bool ut_getDeviceInfo_loadDiskRecord(void *obj, QString &deviceInfo, const QString &file)
+{
+    deviceInfo = "[disk-identify]\n"
+                 "capacity: 250059350016\n"
+                 "capacity_text: 250 GB\n"
+                 "firmware: 2B2QEXM7\n"
+                 "interface: nvme\n"
+                 "model: Samsung SSD 970 EVO Plus 250GB\n"
+                 "power_on_hours: -1\n"
+                 "rotation_rate: 1\n"
+                 "sata_version: \n"
+                 "sector_size: 512\n"
+                 "serial: S4EWNX0N123456\n";
+    return true;
+}
+
+TEST_F(UT_CmdTool, UT_CmdTool_loadSmartCtlInfo_diskRecord)
+{
+    Stub stub;
+    stub.set(ADDR(CmdTool, getDeviceInfo), ut_getDeviceInfo_loadDiskRecord);
+    m_cmdTool->m_cmdInfo.remove("smart");
+    m_cmdTool->loadSmartCtlInfo("nvme0n1", "smartctl_nvme0n1.txt");
+    ASSERT_EQ(m_cmdTool->m_cmdInfo["smart"].size(), 1);
+
+    const QMap<QString, QString> &mapInfo = m_cmdTool->m_cmdInfo["smart"][0];
+    EXPECT_EQ(mapInfo.size(), 11);
+    EXPECT_EQ(mapInfo.value("ln"), QString("nvme0n1"));
+    EXPECT_EQ(mapInfo.value("model"), QString("Samsung SSD 970 EVO Plus 250GB"));
+    EXPECT_EQ(mapInfo.value("serial"), QString("S4EWNX0N123456"));
+    EXPECT_EQ(mapInfo.value("sata_version"), QString(""));
+}
+
 bool ui_getDeviceInfo_loadDmesgInfo(void *obj, QString &deviceInfo, const QString &file)
 {
     deviceInfo = "nouveau 0000:01:00.0: VRAM: 2048MiB\n"
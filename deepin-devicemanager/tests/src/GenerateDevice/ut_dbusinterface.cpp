@@ -56,3 +56,10 @@ TEST_F(UT_DBusInterface, UT_DBusInterface_getInfo_002)
     DBusInterface::getInstance()->getInfo("lshw", info);
     // EXPECT_FALSE(DBusInterface::getInstance()->getInfo("lshw",info));
 }
+
+TEST_F(UT_DBusInterface, UT_DBusInterface_refreshGeneration)
+{
+    // 没有刷新时等待任意一次采集
+    DBusInterface::getInstance()->m_RefreshReply = QDBusPendingReply<qulonglong>();
+    EXPECT_EQ(DBusInterface::getInstance()->refreshGeneration(), 0u);
+}
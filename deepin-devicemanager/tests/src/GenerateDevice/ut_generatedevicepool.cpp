@@ -7,12 +7,18 @@
 #include "DeviceFactory.h"
 #include "X86Generator.h"
 #include "GenerateDevicePool.h"
+#include "GetInfoPool.h"
+#include "DeviceManager.h"
 #include "ut_Head.h"
 #include "stub.h"
 
 #include <QCoreApplication>
 #include <QPaintEvent>
 #include <QPainter>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QMutex>
+#include <QSignalSpy>
 
 #include <gtest/gtest.h>
 
@@ -45,6 +51,23 @@ public:
     GenerateDevicePool *m_generateDevicePool;
 };
 
+DeviceGenerator *ut_getNullGenerator()
+{
+    return nullptr;
+}
+
+TEST_F(UT_GenerateTask, UT_GenerateTask_run_noGenerator)
+{
+    Stub stub;
+    stub.set(ADDR(DeviceFactory, getDeviceGenerator), ut_getNullGenerator);
+
+    // 获取生成器失败也要通知结束
+    QSignalSpy spy(m_generateTask, &GenerateTask::finished);
+    m_generateTask->run();
+    ASSERT_EQ(1, spy.count());
+    EXPECT_EQ(type, spy.at(0).at(0).value<DeviceType>());
+}
+
 // void initType();
 TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_initType){
     m_generateDevicePool->m_TypeList.clear();
@@ -52,7 +75,138 @@ TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_initType){
     EXPECT_EQ(16, m_generateDevicePool->m_TypeList.size());
 }
 
-TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_generateDevice){
+
+TEST_F(UT_GenerateDevicePool, UT_GenerateDevicePool_inputKeys)
+{
+    // 声明的输入必须都是加载的命令，否则该类设备只能等到最后生成
+    GetInfoPool pool;
+    QStringList cmds;
+    foreach (const QStringList &cmd, pool.m_CmdList)
+        cmds.append(cmd[0]);
+
+    foreach (DeviceType type, m_generateDevicePool->m_TypeList) {
+        EXPECT_FALSE(GenerateDevicePool::inputKeys(type).isEmpty());
+        foreach (const QString &key, GenerateDevicePool::inputKeys(type))
+            EXPECT_TRUE(cmds.contains(key)) << type << key.toStdString();
+    }
+    EXPECT_TRUE(GenerateDevicePool::inputKeys(DT_Null).isEmpty());
+}
+
+static QList<DeviceType> startedTypes;
+void ut_startTask(void *obj, DeviceType deviceType)
+{
+    Q_UNUSED(obj)
+    startedTypes.append(deviceType);
+}
+
+TEST_F(UT_GenerateDevicePool, UT_GenerateDevicePool_slotCmdLoaded)
+{
+    Stub stub;
+    stub.set(ADDR(GenerateDevicePool, startTask), ut_startTask);
+    startedTypes.clear();
+
+    m_generateDevicePool->prepare();
+    EXPECT_TRUE(DeviceManager::instance()->isTypeGenerating(DT_Cpu));
+    EXPECT_TRUE(DeviceManager::instance()->isTypeGenerating(DT_Others));
+
+    m_generateDevicePool->slotCmdLoaded("lscpu");
+    m_generateDevicePool->slotCmdLoaded("lshw");
+    m_generateDevicePool->slotCmdLoaded("dmidecode4");
+    EXPECT_TRUE(startedTypes.isEmpty());
+
+    // 输入齐全后立即开始，且只开始一次
+    m_generateDevicePool->slotCmdLoaded("dmidecode1");
+    ASSERT_EQ(startedTypes.size(), 1);
+    EXPECT_EQ(startedTypes[0], DT_Cpu);
+    m_generateDevicePool->slotCmdLoaded("dmidecode4");
+    EXPECT_EQ(startedTypes.size(), 1);
+
+    m_generateDevicePool->slotCmdLoaded("printer");
+    EXPECT_TRUE(startedTypes.contains(DT_Print));
+    EXPECT_FALSE(m_generateDevicePool->m_WaitingTypes.contains(DT_Print));
+    EXPECT_EQ(startedTypes.size() + m_generateDevicePool->m_WaitingTypes.size(), m_generateDevicePool->m_TypeList.size());
+
+    // 生成完成后该类设备可以显示
+    m_generateDevicePool->slotFinished(DT_Cpu, QStringList());
+    EXPECT_FALSE(DeviceManager::instance()->isTypeGenerating(DT_Cpu));
+    EXPECT_EQ(m_generateDevicePool->m_FinishedGenerator.load(), 1);
+
+    DeviceManager::instance()->m_GeneratingTypes = 0;
+    DeviceManager::instance()->clear();
+}
+
+void ut_generateTaskRun(GenerateTask *task)
+{
+    QThread::msleep(50);
+    emit task->finished(task->m_Type, QStringList());
+}
+
+void ut_generatorOthersDevice()
+{
+}
+
+TEST_F(UT_GenerateDevicePool, UT_GenerateDevicePool_barrier)
+{
+    Stub stub;
+    stub.set(ADDR(GenerateTask, run), ut_generateTaskRun);
+    stub.set(ADDR(DeviceGenerator, generatorOthersDevice), ut_generatorOthersDevice);
+
+    // 任务提交到自身的线程池，阻塞等待全部结束，不空转也不依赖事件循环
+    m_generateDevicePool->prepare();
+    QElapsedTimer timer;
+    timer.start();
+    m_generateDevicePool->generateDevice();
+    EXPECT_LT(timer.elapsed(), 4000);
+    EXPECT_EQ(m_generateDevicePool->m_FinishedGenerator.load(), m_generateDevicePool->m_TypeList.size());
+    EXPECT_TRUE(m_generateDevicePool->m_RunningTypes.isEmpty());
+    EXPECT_TRUE(m_generateDevicePool->waitForDone(1000));
+    EXPECT_FALSE(DeviceManager::instance()->isTypeGenerating(DT_Others));
+
+    DeviceManager::instance()->m_GeneratingTypes = 0;
+    DeviceManager::instance()->clear();
+}
+
+static QMutex generatedMutex;
+static QList<DeviceType> generatedTypes;
+static bool othersAfterAll = false;
+static GenerateDevicePool *generatingPool = nullptr;
+void ut_generateTaskRecord(GenerateTask *task)
+{
+    {
+        QMutexLocker locker(&generatedMutex);
+        generatedTypes.append(task->m_Type);
+    }
+    emit task->finished(task->m_Type, QStringList());
+}
+
+void ut_generatorOthersDeviceAfterAll()
+{
+    // 其它设备生成时所有设备类型都已提交
+    QMutexLocker locker(&generatingPool->m_ScheduleMutex);
+    othersAfterAll = generatingPool->m_RunningTypes.isEmpty();
+}
+
+TEST_F(UT_GenerateDevicePool, UT_GenerateDevicePool_generateDevice)
+{
+    Stub stub;
+    stub.set(ADDR(GenerateTask, run), ut_generateTaskRecord);
+    stub.set(ADDR(DeviceGenerator, generatorOthersDevice), ut_generatorOthersDeviceAfterAll);
+    generatedTypes.clear();
+    othersAfterAll = false;
+    generatingPool = m_generateDevicePool;
+
+    // 未调用 prepare 时也要生成所有设备
     m_generateDevicePool->generateDevice();
-    EXPECT_EQ(m_generateDevicePool->m_FinishedGenerator,0);
+    EXPECT_TRUE(m_generateDevicePool->waitForDone(1000));
+    EXPECT_EQ(m_generateDevicePool->m_FinishedGenerator.load(), m_generateDevicePool->m_TypeList.size());
+    EXPECT_EQ(generatedTypes.size(), m_generateDevicePool->m_TypeList.size());
+    foreach (DeviceType type, m_generateDevicePool->m_TypeList) {
+        EXPECT_TRUE(generatedTypes.contains(type)) << type;
+        EXPECT_FALSE(DeviceManager::instance()->isTypeGenerating(type)) << type;
+    }
+    EXPECT_TRUE(othersAfterAll);
+    EXPECT_FALSE(m_generateDevicePool->m_Prepared);
+
+    DeviceManager::instance()->m_GeneratingTypes = 0;
+    DeviceManager::instance()->clear();
 }
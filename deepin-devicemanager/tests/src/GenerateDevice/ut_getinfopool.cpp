@@ -75,3 +75,37 @@ TEST_F(UT_GetInfoPool, UT_GetInfoPool_setFramework)
     EXPECT_STREQ("x86", m_readFilePool->m_Arch.toStdString().c_str());
 }
 
+
+TEST_F(UT_GetInfoPool, UT_GetInfoPool_finishedCmd)
+{
+    DeviceManager::instance()->clear();
+    m_readFilePool->m_CmdList = QList<QStringList>() << QStringList({"a", "a.txt", ""}) << QStringList({"b", "b.txt", ""});
+
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("name", "first");
+    QMap<QString, QList<QMap<QString, QString> > > first;
+    first["audio"].append(mapInfo);
+    QStringList loaded;
+    QObject::connect(m_readFilePool, &GetInfoPool::cmdLoaded, [&loaded](const QString &key) {
+        loaded.append(key);
+    });
+    m_readFilePool->finishedCmd("a", "", std::move(first));
+    // 每个任务完成后立即移交
+    EXPECT_TRUE(first.isEmpty());
+    EXPECT_EQ(DeviceManager::instance()->m_cmdInfo["audio"].size(), 1);
+    EXPECT_EQ(loaded, QStringList({"a"}));
+
+    mapInfo.insert("name", "second");
+    QMap<QString, QList<QMap<QString, QString> > > second;
+    second["audio"].append(mapInfo);
+    second["cpu"].append(mapInfo);
+    m_readFilePool->finishedCmd("b", "", std::move(second));
+
+    ASSERT_EQ(DeviceManager::instance()->m_cmdInfo["audio"].size(), 2);
+    EXPECT_EQ(DeviceManager::instance()->m_cmdInfo["audio"][0]["name"], QString("first"));
+    EXPECT_EQ(DeviceManager::instance()->m_cmdInfo["cpu"].size(), 1);
+    EXPECT_EQ(loaded, QStringList({"a", "b"}));
+    EXPECT_EQ(m_readFilePool->m_FinishedNum, 0);
+    EXPECT_GE(DeviceManager::instance()->addCmdWaitTime(), 0);
+    DeviceManager::instance()->clear();
+}
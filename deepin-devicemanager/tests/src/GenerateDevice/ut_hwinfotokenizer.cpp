@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "CmdTool.h"
+#include "HwinfoTokenizer.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+
+#include <gtest/gtest.h>
+
+// 采集自实际机器的 hwinfo 输出片段，覆盖 PS/2、驱动模块、Config Status、SubDevice 等分支
+static const char *HWINFO_DUMP =
+    "13: PCI 1f.3: 0403 Audio device\n"
+    "  [Created at pci.386]\n"
+    "  Unique ID: nS1_.2kTLVjATLd3\n"
+    "  Parent ID: vSkL.ucdhKwLeeAA\n"
+    "  SysFS ID: /devices/pci0000:00/0000:00:1f.3\n"
+    "  SysFS BusID: 0000:00:1f.3\n"
+    "  Hardware Class: sound\n"
+    "  Model: \"Intel Cannon Lake PCH cAVS\"\n"
+    "  Vendor: pci 0x8086 \"Intel Corporation\"\n"
+    "  Device: pci 0xa348 \"Cannon Lake PCH cAVS\"\n"
+    "  SubVendor: pci 0x17aa \"Lenovo\"\n"
+    "  SubDevice: pci 0x3136 \n"
+    "  Revision: 0x10\n"
+    "  Driver: \"snd_hda_intel\"\n"
+    "  Driver Modules: \"snd_hda_intel\", \"snd_sof_pci\"\n"
+    "  Memory Range: 0xa1218000-0xa121bfff (rw,non-prefetchable)\n"
+    "  IRQ: 145 (1038 events)\n"
+    "  Module Alias: \"pci:v00008086d0000A348sv000017AAsd00003136bc04sc03i80\"\n"
+    "  Driver Info #0:\n"
+    "    Driver Status: snd_hda_intel is active\n"
+    "    Driver Activation Cmd: \"modprobe snd_hda_intel\"\n"
+    "  Config Status: cfg=new, avail=yes, need=no, active=unknown\n"
+    "  Attached to: #9 (ISA bridge)\n"
+    "\n"
+    "24: USB 00.0: 10503 USB Mouse\n"
+    "  [Created at usb.122]\n"
+    "  Unique ID: 2XnU.PRx1Jmr8qJ1\n"
+    "  SysFS ID: /devices/pci0000:00/0000:00:14.0/usb1/1-3/1-3:1.0\n"
+    "  SysFS BusID: 1-3:1.0\n"
+    "  Hardware Class: mouse\n"
+    "  Model: \"Maxxter Wireless Receiver\"\n"
+    "  Hotplug: USB\n"
+    "  Vendor: usb 0x248a \"Maxxter\"\n"
+    "  Device: usb 0x8367 \"Wireless Receiver\"\n"
+    "  Revision: \"1.00\"\n"
+    "  Compatible to: int 0x0210 0x0003\n"
+    "  Driver: \"usbhid\"\n"
+    "  Driver Modules: \"usbhid\"\n"
+    "  Device File: /dev/input/mice (/dev/input/mouse0)\n"
+    "  Device Files: /dev/input/mice, /dev/input/mouse0, /dev/input/event4\n"
+    "  Device Number: char 13:63 (char 13:32)\n"
+    "  Speed: 12 Mbps\n"
+    "  Module Alias: \"usb:v248Ap8367d0100dc00dsc00dp00ic03isc01ip02in00\"\n"
+    "  Config Status: cfg=new, avail=yes, need=no, active=unknown\n"
+    "\n"
+    "33: PS/2 00.0: 10500 PS/2 Mouse\n"
+    "  [Created at input.249]\n"
+    "  Unique ID: AH6Q.mYF0pYoTCW7\n"
+    "  Hardware Class: mouse\n"
+    "  Model: \"SynPS/2 Synaptics TouchPad\"\n"
+    "  Vendor: 0x0002\n"
+    "  Device: 0x0007 \"SynPS/2 Synaptics TouchPad\"\n"
+    "  Compatible to: int 0x0210 0x0002\n"
+    "  Device File: /dev/input/mice (/dev/input/mouse1)\n"
+    "  Device Number: char 13:63 (char 13:33)\n"
+    "  Driver Info #0:\n"
+    "    Buttons: 2\n"
+    "    Wheels: 0\n"
+    "  Config Status: cfg=new, avail=yes, need=no, active=unknown\n"
+    "\n"
+    "41: None 00.0: 10002 LCD Monitor\n"
+    "  [Created at monitor.125]\n"
+    "  Unique ID: rdCR.n_7QNeEnh23\n"
+    "  Hardware Class: monitor\n"
+    "  Model: \"AUO LCD Monitor\"\n"
+    "  Vendor: AUO \n"
+    "  Device: eisa 0x213d \n"
+    "  Resolution: 1920x1080@60Hz\n"
+    "  Size: 344x194 mm\n"
+    "  Year of Manufacture: 2018\n"
+    "  Detailed Timings #0:\n"
+    "     Resolution: 1920x1080\n"
+    "  Serial ID: \"unknown\"\n"
+    "  Driver Info #0:\n"
+    "    Max. Resolution: 1920x1080\n"
+    "  Config Status: cfg=new, avail=y, need=no, active=unknown\n";
+
+// 原有的解析实现，用于对比结果和耗时
+static void legacyGetMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch = QString(": "))
+{
+    QString tmpkey;
+    QString tmpvalue;
+    QString tmpvid;
+    tmpvid.clear();
+    QStringList infoList = info.split("\n");
+    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
+        QStringList words = (*it).split(ch);
+        if ((*it).contains("PS/2 Mouse")) {
+            words.clear();
+            words << "Hotplug" << "PS/2";
+        }
+        if ((*it).contains("SubDevice:")) {
+            tmpkey = "PsubID";
+        }
+        if (words.size() != 2)
+            continue;
+
+        if (mapInfo.find(words[0].trimmed()) != mapInfo.end())
+            mapInfo[words[0].trimmed()] += QString(" ");
+
+        /*pick PID VID*/
+        if (
+            ("SubDevice" ==  words[0].trimmed() || "SubVendor" == words[0].trimmed() ||
+             "Vendor" ==  words[0].trimmed() || "Device" == words[0].trimmed())
+            && !(words[1].trimmed().isEmpty() ||  words[1].trimmed().contains("unknown"))
+            && words[1].trimmed().contains("0x")
+        ) {
+            if ("SubDevice" ==  words[0].trimmed()) {
+                tmpkey = "PsubID";
+                tmpvalue = words[1].trimmed(); //re.cap(0);
+            } else if ("SubVendor" ==  words[0].trimmed()) {
+                tmpkey = "VsubID";
+                tmpvalue = words[1].trimmed();
+            } else if ("Vendor" ==  words[0].trimmed()) {
+                tmpkey = "VID";
+                tmpvalue = words[1].trimmed();
+            } else if ("Device" ==  words[0].trimmed()) {
+                tmpkey = "PID";
+                tmpvalue = words[1].trimmed();
+            }
+
+            QStringList tmpword = tmpvalue.split(" ");
+            if (tmpword.size() > 1) {
+                mapInfo[tmpkey] += tmpword[1].trimmed();
+
+                if (tmpkey == "VID") {
+                    tmpvid = tmpword[1].trimmed();
+                } else if (tmpkey == "PID") {
+                    if (!tmpvid.isEmpty()) {
+                        tmpkey = "VID_PID";
+                        tmpvalue.clear();
+                        tmpvalue = tmpvid + tmpword[1].remove("0x", Qt::CaseSensitive).trimmed();
+                        tmpvid.clear();
+                        mapInfo[tmpkey] += tmpvalue;
+                    }
+                }
+            }
+        }
+
+        QRegularExpression re(".*\"(.*)\".*");
+        if (re.match(words[1].trimmed()).hasMatch()) {
+            QString key = words[0].trimmed();
+            QString value = re.match(words[1].trimmed()).captured(1);
+
+            //这里是为了防止  "usb-storage", "sr"  -》 usb-storage", "sr
+            // bug112311 驱动模块显示异常
+            if ("Driver" ==  key || "Driver Modules" ==  key)
+                value.replace("\"", "");
+
+            // 如果信息中有unknown 则过滤
+            if (!value.contains("unknown"))
+                mapInfo[key] += value;
+
+        } else {
+            // 此处如果subDevice,subVendor,Device没有值，则过滤
+//            if ("SubDevice" ==  words[0].trimmed() ||
+//                    "SubVendor" == words[0].trimmed() ||
+//                    "Device" == words[0].trimmed()) {
+//                continue;
+//            }
+            if ("Resolution" == words[0].trimmed()) {
+                mapInfo[words[0].trimmed()] += words[1].trimmed();
+            } else {
+                // 如果信息中有unknown 则过滤
+                if (!words[1].trimmed().contains("unknown"))
+                    mapInfo[words[0].trimmed()] = words[1].trimmed();
+            }
+        }
+        if ((*it).contains("Config Status")) {
+            //qCInfo(appLog) << "  Config Status"<< words[0]<<words[1];
+            if(words[1].contains("avail=yes"))
+                mapInfo["cfg_avail"] = "yes";
+        }
+    }
+
+    if (mapInfo.contains("VID_PID") && !mapInfo["VID_PID"].isEmpty() && (mapInfo.contains("SysFS ID") || mapInfo.contains("SysFS Device Link"))) {
+        QCryptographicHash Hash(QCryptographicHash::Md5);
+        QByteArray buf;
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+        buf.append(mapInfo[tmpkey]);
+#else
+        buf.append(mapInfo[tmpkey].toUtf8());
+#endif
+        if (mapInfo.contains("SysFS Device Link") && !mapInfo["SysFS Device Link"].isEmpty()) {
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+            buf.append(mapInfo["SysFS Device Link"]);
+#else
+            buf.append(mapInfo["SysFS Device Link"].toUtf8());
+#endif
+        } else {
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+            buf.append(mapInfo["SysFS ID"]);
+#else
+            buf.append(mapInfo["SysFS ID"].toUtf8());
+#endif
+        }
+        Hash.addData(buf);
+        mapInfo["Unique ID"] = QString::fromStdString(Hash.result().toBase64().toStdString());
+    }
+
+    if (mapInfo.find("Module Alias") != mapInfo.end())
+        mapInfo["Module Alias"].replace(QRegularExpression("[0-9a-zA-Z]{10}$"), "");
+
+}
+
+
+static QStringList hwinfoItems(int repeat)
+{
+    QString dump;
+    for (int i = 0; i < repeat; ++i)
+        dump += QString(HWINFO_DUMP) + "\n";
+    return dump.split("\n\n");
+}
+
+class UT_HwinfoTokenizer : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_cmdTool = new CmdTool;
+    }
+    void TearDown()
+    {
+        delete m_cmdTool;
+    }
+    CmdTool *m_cmdTool = nullptr;
+};
+
+TEST_F(UT_HwinfoTokenizer, UT_HwinfoTokenizer_next)
+{
+    HwinfoTokenizer tokenizer(u"Hardware Class: disk\n  Driver Modules: \"usb-storage\", \"sr\"\nno separator\n");
+    HwinfoToken token;
+    ASSERT_TRUE(tokenizer.next(token));
+    EXPECT_TRUE(token.valid);
+    EXPECT_EQ(token.key.toString(), QString("Hardware Class"));
+    EXPECT_EQ(token.value.toString(), QString("disk"));
+    EXPECT_FALSE(token.hasQuoted);
+
+    ASSERT_TRUE(tokenizer.next(token));
+    EXPECT_EQ(token.key.toString(), QString("Driver Modules"));
+    EXPECT_TRUE(token.hasQuoted);
+    EXPECT_EQ(token.quoted.toString(), QString("sr"));
+
+    ASSERT_TRUE(tokenizer.next(token));
+    EXPECT_FALSE(token.valid);
+    // 与 split("\n") 相同，以换行结尾时最后有一个空行
+    ASSERT_TRUE(tokenizer.next(token));
+    EXPECT_TRUE(token.line.isEmpty());
+    EXPECT_FALSE(tokenizer.next(token));
+}
+
+TEST_F(UT_HwinfoTokenizer, UT_HwinfoTokenizer_compare)
+{
+    foreach (const QString &item, hwinfoItems(1)) {
+        QMap<QString, QString> expected;
+        QMap<QString, QString> actual;
+        legacyGetMapInfoFromHwinfo(item, expected);
+        m_cmdTool->getMapInfoFromHwinfo(item, actual);
+        EXPECT_EQ(expected, actual);
+    }
+
+    // 非默认分隔符
+    QMap<QString, QString> expected;
+    QMap<QString, QString> actual;
+    legacyGetMapInfoFromHwinfo("Vendor=usb 0x248a \"Maxxter\"\nDevice=usb 0x8367", expected, "=");
+    m_cmdTool->getMapInfoFromHwinfo("Vendor=usb 0x248a \"Maxxter\"\nDevice=usb 0x8367", actual, "=");
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(UT_HwinfoTokenizer, UT_HwinfoTokenizer_benchmark)
+{
+    // 约300KB，与实际的 hwinfo.txt 大小相当
+    QStringList items = hwinfoItems(100);
+    QElapsedTimer timer;
+    timer.start();
+    foreach (const QString &item, items) {
+        QMap<QString, QString> mapInfo;
+        legacyGetMapInfoFromHwinfo(item, mapInfo);
+    }
+    qint64 legacy = timer.nsecsElapsed();
+
+    timer.restart();
+    foreach (const QString &item, items) {
+        QMap<QString, QString> mapInfo;
+        m_cmdTool->getMapInfoFromHwinfo(item, mapInfo);
+    }
+    qint64 tokenizer = timer.nsecsElapsed();
+    qInfo() << "hwinfo items:" << items.size() << "legacy:" << legacy / 1000 << "us tokenizer:" << tokenizer / 1000 << "us";
+    EXPECT_GT(legacy, 0);
+}
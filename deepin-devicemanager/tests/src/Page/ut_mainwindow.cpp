@@ -10,6 +10,8 @@
 #include "DeviceWidget.h"
 #include "PageListView.h"
 #include "DeviceListView.h"
+#include "DeviceManager.h"
+#include "DevicePrint.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -123,3 +125,19 @@ TEST_F(MainWindow_UT, MainWindow_UT_loadingFinishSlot)
     m_mainWindow->slotLoadingFinish("finish");
     EXPECT_TRUE(m_mainWindow->mp_DeviceWidget->mp_ListView->mp_ListView->mp_ItemModel->rowCount() > 0);
 }
+
+TEST_F(MainWindow_UT, MainWindow_UT_slotDeviceReady)
+{
+    // 正在生成的类型不显示，生成完成后出现在列表中
+    DeviceManager::instance()->clear();
+    DeviceManager::instance()->addPrintDevice(new DevicePrint);
+    DeviceManager::instance()->setTypeGenerating(DT_Print, true);
+    m_mainWindow->slotDeviceReady(DT_Cpu);
+    int rows = m_mainWindow->mp_DeviceWidget->mp_ListView->mp_ListView->mp_ItemModel->rowCount();
+    EXPECT_TRUE(m_mainWindow->m_HasReadyDevice);
+
+    DeviceManager::instance()->setTypeGenerating(DT_Print, false);
+    m_mainWindow->slotDeviceReady(DT_Print);
+    EXPECT_EQ(m_mainWindow->mp_DeviceWidget->mp_ListView->mp_ListView->mp_ItemModel->rowCount(), rows + 1);
+    DeviceManager::instance()->clear();
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "HeadlessExport.h"
+#include "DeviceManager.h"
+#include "DeviceMonitor.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <gtest/gtest.h>
+
+static QString ut_exportFormat;
+
+static bool ut_exportToTxt(void *, const QString &)
+{
+    ut_exportFormat = "txt";
+    return true;
+}
+
+static bool ut_exportToDoc(void *, const QString &)
+{
+    ut_exportFormat = "docx";
+    return true;
+}
+
+static bool ut_exportToXlsx(void *, const QString &)
+{
+    ut_exportFormat = "xlsx";
+    return false;
+}
+
+class UT_HeadlessExport : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        ut_exportFormat.clear();
+    }
+    Stub m_Stub;
+};
+
+TEST_F(UT_HeadlessExport, UT_HeadlessExport_isRequested)
+{
+    char app[] = "deepin-devicemanager";
+    char exportTxt[] = "--export=txt";
+    char exportArg[] = "--export";
+    char output[] = "--output=/tmp/devices.txt";
+    char exporter[] = "--exporter";
+    char page[] = "driver";
+
+    char *argv1[] = {app, exportTxt, output};
+    EXPECT_TRUE(HeadlessExport::isRequested(3, argv1));
+
+    char *argv2[] = {app, output, exportArg, exportTxt};
+    EXPECT_TRUE(HeadlessExport::isRequested(4, argv2));
+
+    char *argv3[] = {app, page};
+    EXPECT_FALSE(HeadlessExport::isRequested(2, argv3));
+
+    char *argv4[] = {app, exporter};
+    EXPECT_FALSE(HeadlessExport::isRequested(2, argv4));
+
+    // argv[0] 不作为参数
+    char *argv5[] = {exportTxt};
+    EXPECT_FALSE(HeadlessExport::isRequested(1, argv5));
+}
+
+TEST_F(UT_HeadlessExport, UT_HeadlessExport_normalizeFormat)
+{
+    EXPECT_EQ(HeadlessExport::normalizeFormat("txt"), "txt");
+    EXPECT_EQ(HeadlessExport::normalizeFormat(" HTML "), "html");
+    EXPECT_EQ(HeadlessExport::normalizeFormat("doc"), "docx");
+    EXPECT_EQ(HeadlessExport::normalizeFormat(".docx"), "docx");
+    EXPECT_EQ(HeadlessExport::normalizeFormat("xls"), "xlsx");
+    EXPECT_EQ(HeadlessExport::normalizeFormat("XLSX"), "xlsx");
+    EXPECT_TRUE(HeadlessExport::normalizeFormat("pdf").isEmpty());
+    EXPECT_TRUE(HeadlessExport::normalizeFormat("").isEmpty());
+}
+
+TEST_F(UT_HeadlessExport, UT_HeadlessExport_exportTo)
+{
+    m_Stub.set(ADDR(DeviceManager, exportToTxt), ut_exportToTxt);
+    m_Stub.set(ADDR(DeviceManager, exportToDoc), ut_exportToDoc);
+    m_Stub.set(ADDR(DeviceManager, exportToXlsx), ut_exportToXlsx);
+
+    EXPECT_TRUE(HeadlessExport::exportTo("txt", "/tmp/devices.txt"));
+    EXPECT_EQ(ut_exportFormat, "txt");
+
+    EXPECT_TRUE(HeadlessExport::exportTo("docx", "/tmp/devices.docx"));
+    EXPECT_EQ(ut_exportFormat, "docx");
+
+    EXPECT_FALSE(HeadlessExport::exportTo("xlsx", "/tmp/devices.xlsx"));
+    EXPECT_EQ(ut_exportFormat, "xlsx");
+
+    ut_exportFormat.clear();
+    EXPECT_FALSE(HeadlessExport::exportTo("pdf", "/tmp/devices.pdf"));
+    EXPECT_TRUE(ut_exportFormat.isEmpty());
+}
+
+TEST_F(UT_HeadlessExport, UT_HeadlessExport_peakRss)
+{
+    EXPECT_GT(HeadlessExport::peakRss(), 0);
+}
+
+TEST_F(UT_HeadlessExport, UT_HeadlessExport_monitor)
+{
+    // 无界面导出时不是DApplication，根据会话类型判断平台，显示器信息与界面导出一致
+    QByteArray sessionType = qgetenv("XDG_SESSION_TYPE");
+    QByteArray waylandDisplay = qgetenv("WAYLAND_DISPLAY");
+    qunsetenv("WAYLAND_DISPLAY");
+    QString main = "HDMI-1 connected primary 1920x1080+0+0 (normal left inverted right x axis y axis) 527mm x 296mm";
+
+    qputenv("XDG_SESSION_TYPE", "x11");
+    EXPECT_TRUE(DeviceMonitor::isXcbPlatform());
+    DeviceMonitor x11Monitor;
+    EXPECT_TRUE(x11Monitor.setMainInfoFromXrandr(main, "60.00Hz"));
+    EXPECT_EQ(x11Monitor.m_MainScreen, "Yes");
+    EXPECT_EQ(x11Monitor.m_CurrentResolution, "1920x1080@60.00Hz");
+
+    // 主显示器信息只在xcb平台读取
+    qputenv("XDG_SESSION_TYPE", "wayland");
+    EXPECT_FALSE(DeviceMonitor::isXcbPlatform());
+    DeviceMonitor waylandMonitor;
+    waylandMonitor.m_MainScreen.clear();
+    EXPECT_TRUE(waylandMonitor.setMainInfoFromXrandr(main, "60.00Hz"));
+    EXPECT_TRUE(waylandMonitor.m_MainScreen.isEmpty());
+
+    qputenv("XDG_SESSION_TYPE", sessionType);
+    if (!waylandDisplay.isEmpty())
+        qputenv("WAYLAND_DISPLAY", waylandDisplay);
+}
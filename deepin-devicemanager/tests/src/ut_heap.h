@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef UT_HEAP_H
+#define UT_HEAP_H
+
+#include <malloc.h>
+#include <stddef.h>
+
+/**
+ * @brief heapUsed : 当前已分配的堆内存，用于对比内存占用
+ * @return 字节数
+ */
+inline size_t heapUsed()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return static_cast<size_t>(mallinfo().uordblks);
+#endif
+}
+
+#endif // UT_HEAP_H